@@ -21,12 +21,16 @@
 #import "IGListAdapterMoveDelegate.h"
 #import "IGListAdapterPerformanceDelegate.h"
 #import "IGListAdapterUpdateListener.h"
+#import "IGListPrefetchScheduler.h"
+#import "IGListPreparedUpdate.h"
 #else
 #import <IGListKit/IGListAdapterDataSource.h>
 #import <IGListKit/IGListAdapterDelegate.h>
 #import <IGListKit/IGListAdapterMoveDelegate.h>
 #import <IGListKit/IGListAdapterPerformanceDelegate.h>
 #import <IGListKit/IGListAdapterUpdateListener.h>
+#import <IGListKit/IGListPrefetchScheduler.h>
+#import <IGListKit/IGListPreparedUpdate.h>
 #endif
 
 @protocol IGListUpdatingDelegate;
@@ -119,6 +123,53 @@ NS_SWIFT_NAME(ListAdapter)
  */
 @property (nonatomic, assign) BOOL autoDeselectEnabled;
 
+/**
+ When true, item sizes returned by section controllers are cached by the `diffIdentifier` of their object, the item
+ index, the container size and the trait collection. Reloads of unchanged objects and returning to a previously seen
+ container size then skip `-[IGListSectionController sizeForItemAtIndex:]`.
+
+ Sizes of an object are dropped when the object is updated (same `diffIdentifier`, but not equal), reloaded, or when its
+ section controller inserts, deletes, moves, reloads or invalidates the layout of items.
+ Default is false.
+
+ @note Only enable this when item sizes depend solely on the object, the container and the trait collection.
+ */
+@property (nonatomic, assign) BOOL itemSizeCacheEnabled;
+
+/**
+ When true, the working range leans toward the scroll direction by an amount scaled with the scroll velocity, keeping
+ `workingRangeSize * 2` sections in it beyond the viewport. During a fast fling every one of them is ahead of the
+ viewport, and the range becomes symmetric again once scrolling stops.
+ Default is false.
+ */
+@property (nonatomic, assign) BOOL directionalWorkingRangeEnabled;
+
+/**
+ The number of sections before and after the viewport in each additional working range tier, e.g. `@[@2, @8]` for a
+ near tier to decode images and a far tier to start network requests. Section controllers entering and exiting a tier
+ are reported to the optional tier methods of `IGListWorkingRangeDelegate`, with their distance from the viewport.
+ All tiers and the range of `workingRangeSize` are updated in the same pass.
+ Default is empty.
+ */
+@property (nonatomic, copy) NSArray<NSNumber *> *workingRangeTierSizes;
+
+/**
+ Runs prefetch tasks of section controllers on a bounded number of background workers, closest to the visible sections
+ first. Tasks of a section controller are cancelled when it exits the working range.
+ */
+@property (nonatomic, strong, readonly) IGListPrefetchScheduler *prefetchScheduler;
+
+/**
+ The maximum number of section controllers of each class kept for reuse. Section controllers removed by an update are
+ kept once the update completes and they are no longer displayed, and are returned by
+ `-dequeueReusableSectionControllerOfClass:` instead of allocating new ones.
+ Default is 0, which disables reuse.
+
+ @note Only enable this for section controllers that reset the state of their previous object in
+ `-[IGListSectionController prepareForReuse]`.
+ */
+@property (nonatomic, assign) NSInteger maxReusableSectionControllersPerClass;
+
 /**
  Initializes a new `IGListAdapter` object.
 
@@ -159,6 +210,33 @@ NS_SWIFT_NAME(ListAdapter)
  */
 - (void)performUpdatesAnimated:(BOOL)animated completion:(nullable IGListUpdaterCompletion)completion NS_SWIFT_DISABLE_ASYNC;
 
+/**
+ Prepares an update to a snapshot of objects: removes duplicate identifiers, diffs the objects against the objects of
+ the adapter, and records the old indexes of existing objects. Can be called from any thread, so that this work stays
+ off the main thread.
+
+ @param objects An immutable snapshot of the objects to update to.
+
+ @return An update to pass to `-commitPreparedUpdate:animated:completion:`.
+ */
+- (IGListPreparedUpdate *)prepareUpdateWithObjects:(NSArray<id<IGListDiffable>> *)objects;
+
+/**
+ Applies a prepared update: asks the data source for the section controllers of new objects only, and performs the batch
+ update with the diff of the prepared update. If the adapter was updated since the update was prepared, its objects are
+ diffed again.
+
+ @param preparedUpdate An update returned by `-prepareUpdateWithObjects:`.
+ @param animated A flag indicating if the transition should be animated.
+ @param completion The block to execute when the updates complete.
+
+ @note `-[IGListAdapterDataSource objectsForListAdapter:]` is not called, but later updates call it, so it should return
+ the objects of the prepared update once it is committed.
+ */
+- (void)commitPreparedUpdate:(IGListPreparedUpdate *)preparedUpdate
+                    animated:(BOOL)animated
+                  completion:(nullable IGListUpdaterCompletion)completion NS_SWIFT_DISABLE_ASYNC;
+
 /**
  Perform an immediate reload of the data in the data source, discarding the old objects.
 
@@ -205,6 +283,18 @@ NS_SWIFT_NAME(ListAdapter)
  */
 - (__kindof IGListSectionController * _Nullable)sectionControllerForObject:(id)object;
 
+/**
+ Returns a section controller of a class for a new object, reusing one that was removed from the list if any was kept.
+ Call this from `-[IGListAdapterDataSource listAdapter:sectionControllerForObject:]`.
+
+ @param sectionControllerClass A subclass of `IGListSectionController` that can be initialized with `-init`.
+
+ @return A reused section controller after calling its `-prepareForReuse`, or a new one.
+
+ @see `maxReusableSectionControllersPerClass`
+ */
+- (__kindof IGListSectionController *)dequeueReusableSectionControllerOfClass:(Class)sectionControllerClass;
+
 /**
  Returns the object corresponding to the specified section controller in the list. Constant time lookup.
 
@@ -254,12 +344,23 @@ NS_SWIFT_NAME(ListAdapter)
 - (NSArray *)visibleObjects;
 
 /**
- Less performant that `visibleObjects` but gives you an ordering to the list of visible objects in `self.objects`.
+ The indexes of the visible objects in `self.objects`, in order.
 
  @return An index set for objects in `self.objects`.   Result's `.count` will be `0` if no visible objects.
  */
 - (NSIndexSet *)indexesOfVisibleObjects;
 
+/**
+ The range from the first to the last section with a visible cell. Sections in between without a visible cell, like
+ empty sections, are included.
+
+ @return A range of sections, with a location of `NSNotFound` and a length of `0` if no cell is visible.
+
+ @note Derived from the display events of the cells, so it does not allocate or look at the collection view. Cheap
+ enough to call on every scroll event.
+ */
+- (NSRange)visibleSectionRange;
+
 /**
  An unordered array of the currently visible cells for a given object.
 
@@ -331,6 +432,30 @@ NS_SWIFT_NAME(ListAdapter)
 - (CGSize)sizeForSupplementaryViewOfKind:(NSString *)elementKind
                              atIndexPath:(NSIndexPath *)indexPath;
 
+/**
+ Seeds item sizes from a snapshot written by `-writeItemSizeSnapshotToFile:` during a previous launch, and starts
+ recording measured sizes for the next snapshot. Call this before the first layout pass.
+
+ Only sections whose object conforms to `IGListSizeSnapshotContent` are seeded or recorded. A seeded size is verified
+ against `-[IGListSectionController sizeForItemAtIndex:]` when its cell is displayed, and the layout of the item is
+ invalidated if they differ.
+
+ @param path The path of the snapshot.
+
+ @return `YES` if a valid snapshot was loaded. Sizes are recorded even if this returns `NO`.
+ */
+- (BOOL)loadItemSizeSnapshotFromFile:(NSString *)path;
+
+/**
+ Writes the sizes measured since `-loadItemSizeSnapshotFromFile:` was called, for the objects still in the list. Seeded
+ sizes that were used but not verified yet are carried over.
+
+ @param path The path of the snapshot.
+
+ @return `YES` if the snapshot was written.
+ */
+- (BOOL)writeItemSizeSnapshotToFile:(NSString *)path;
+
 /**
  Adds a listener to the list adapter.
 
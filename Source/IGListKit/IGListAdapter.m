@@ -9,18 +9,25 @@
 
 #if !__has_include(<IGListDiffKit/IGListDiffKit.h>)
 #import "IGListAssert.h"
+#import "IGListDiff.h"
 #else
 #import <IGListDiffKit/IGListAssert.h>
+#import <IGListDiffKit/IGListDiff.h>
 #endif
 #import "IGListAdapterUpdater.h"
 
 #import "IGListAdapterDelegateAnnouncer.h"
 #import "IGListArrayUtilsInternal.h"
+#import "IGListBatchSizing.h"
 #import "IGListDebugger.h"
 #import "IGListDefaultExperiments.h"
+#import "IGListItemSizeCache.h"
+#import "IGListPrefetchSchedulerInternal.h"
+#import "IGListPreparedUpdateInternal.h"
 #import "IGListSectionControllerInternal.h"
+#import "IGListSizeSnapshotStore.h"
 #import "IGListSupplementaryViewSource.h"
-#import "IGListTransitionData.h"
+#import "IGListTransitionDataInternal.h"
 #import "IGListUpdatingDelegate.h"
 #import "UICollectionViewLayout+InteractiveReordering.h"
 #import "UIScrollView+IGListKit.h"
@@ -31,11 +38,35 @@ typedef struct OffsetRange {
     CGFloat max;
 } OffsetRange;
 
+// weight of the latest frame in the scroll velocity while decelerating
+static const CGFloat kIGListScrollVelocitySmoothing = 0.3;
+
+// use the axis that moved the most, so this doesn't depend on the layout's scroll direction
+static CGFloat IGListScrollComponent(CGPoint point) {
+    return fabs(point.y) >= fabs(point.x) ? point.y : point.x;
+}
+
 @implementation IGListAdapter {
     NSMapTable<UICollectionReusableView *, IGListSectionController *> *_viewSectionControllerMap;
     // An array of blocks to execute once batch updates are finished
     NSMutableArray<void (^)(void)> *_queuedCompletionBlocks;
     NSHashTable<id<IGListAdapterUpdateListener>> *_updateListeners;
+    // Only created while itemSizeCacheEnabled is YES
+    IGListItemSizeCache *_itemSizeCache;
+    // Only created once a snapshot was requested with -loadItemSizeSnapshotFromFile:
+    IGListSizeSnapshotStore *_sizeSnapshotStore;
+    // Only tracked while directionalWorkingRangeEnabled is YES, 0 when the collection view isn't scrolling
+    CFTimeInterval _lastScrollTimestamp;
+    CGPoint _lastScrollContentOffset;
+    CGFloat _scrollVelocity;
+    // Only created while maxReusableSectionControllersPerClass is positive
+    NSMapTable<Class, NSMutableArray<IGListSectionController *> *> *_reusableSectionControllers;
+    // Section controllers removed by updates that have not completed yet
+    NSMutableArray<IGListSectionController *> *_removedSectionControllers;
+    // The objects and section controllers before the update being applied, previousSectionMap is only built from them
+    // once a lookup needs it
+    NSArray<id<IGListDiffable>> *_previousObjects;
+    NSArray<IGListSectionController *> *_previousSectionControllers;
 }
 
 - (void)dealloc {
@@ -57,10 +88,13 @@ typedef struct OffsetRange {
         NSPointerFunctions *valueFunctions = [NSPointerFunctions pointerFunctionsWithOptions:NSPointerFunctionsStrongMemory];
         NSMapTable *table = [[NSMapTable alloc] initWithKeyPointerFunctions:keyFunctions valuePointerFunctions:valueFunctions capacity:0];
         _sectionMap = [[IGListSectionMap alloc] initWithMapTable:table];
+        _committedData = [[IGListTransitionData alloc] initFromObjects:@[] toObjects:@[] toSectionControllers:@[]];
 
         _globalDelegateAnnouncer = [IGListAdapterDelegateAnnouncer sharedInstance];
         _displayHandler = [IGListDisplayHandler new];
         _workingRangeHandler = [[IGListWorkingRangeHandler alloc] initWithWorkingRangeSize:workingRangeSize];
+        _workingRangeTierSizes = @[];
+        _prefetchScheduler = [[IGListPrefetchScheduler alloc] initWithListAdapter:self];
         _updateListeners = [NSHashTable weakObjectsHashTable];
 
         _viewSectionControllerMap = [NSMapTable mapTableWithKeyOptions:NSMapTableObjectPointerPersonality | NSMapTableStrongMemory
@@ -223,6 +257,72 @@ typedef struct OffsetRange {
     [self _updateObjects:uniqueObjects dataSource:dataSource];
 }
 
+- (void)setItemSizeCacheEnabled:(BOOL)itemSizeCacheEnabled {
+    IGAssertMainThread();
+
+    if (_itemSizeCacheEnabled != itemSizeCacheEnabled) {
+        _itemSizeCacheEnabled = itemSizeCacheEnabled;
+        _itemSizeCache = itemSizeCacheEnabled ? [IGListItemSizeCache new] : nil;
+    }
+}
+
+- (void)setDirectionalWorkingRangeEnabled:(BOOL)directionalWorkingRangeEnabled {
+    IGAssertMainThread();
+
+    if (_directionalWorkingRangeEnabled != directionalWorkingRangeEnabled) {
+        _directionalWorkingRangeEnabled = directionalWorkingRangeEnabled;
+        [self _resetScrollVelocity];
+    }
+}
+
+- (void)setWorkingRangeTierSizes:(NSArray<NSNumber *> *)workingRangeTierSizes {
+    IGAssertMainThread();
+    IGParameterAssert(workingRangeTierSizes != nil);
+
+    if (![_workingRangeTierSizes isEqualToArray:workingRangeTierSizes]) {
+        _workingRangeTierSizes = [workingRangeTierSizes copy];
+        [self.workingRangeHandler updateTierSizes:_workingRangeTierSizes forListAdapter:self];
+    }
+}
+
+- (void)setMaxReusableSectionControllersPerClass:(NSInteger)maxReusableSectionControllersPerClass {
+    IGAssertMainThread();
+    IGParameterAssert(maxReusableSectionControllersPerClass >= 0);
+
+    _maxReusableSectionControllersPerClass = maxReusableSectionControllersPerClass;
+    if (maxReusableSectionControllersPerClass <= 0) {
+        _reusableSectionControllers = nil;
+        _removedSectionControllers = nil;
+        return;
+    }
+    if (_reusableSectionControllers == nil) {
+        _reusableSectionControllers = [NSMapTable strongToStrongObjectsMapTable];
+        _removedSectionControllers = [NSMutableArray new];
+    }
+    const NSUInteger maxCount = (NSUInteger)maxReusableSectionControllersPerClass;
+    for (NSMutableArray<IGListSectionController *> *reusableSectionControllers in [_reusableSectionControllers objectEnumerator]) {
+        const NSUInteger count = reusableSectionControllers.count;
+        if (count > maxCount) {
+            [reusableSectionControllers removeObjectsInRange:NSMakeRange(maxCount, count - maxCount)];
+        }
+    }
+}
+
+- (BOOL)loadItemSizeSnapshotFromFile:(NSString *)path {
+    IGAssertMainThread();
+    IGParameterAssert(path != nil);
+
+    _sizeSnapshotStore = [[IGListSizeSnapshotStore alloc] initWithContentsOfFile:path];
+    return _sizeSnapshotStore.loaded;
+}
+
+- (BOOL)writeItemSizeSnapshotToFile:(NSString *)path {
+    IGAssertMainThread();
+    IGParameterAssert(path != nil);
+
+    return [_sizeSnapshotStore writeToFile:path];
+}
+
 - (void)_createProxyAndUpdateCollectionViewDelegate {
     // there is a known bug with accessibility and using an NSProxy as the delegate that will cause EXC_BAD_ACCESS
     // when voiceover is enabled. it will hold an unsafe ref to the delegate
@@ -431,7 +531,45 @@ typedef struct OffsetRange {
 
 - (void)performUpdatesAnimated:(BOOL)animated completion:(IGListUpdaterCompletion)completion {
     IGAssertMainThread();
+    [self _performUpdatesWithPreparedUpdate:nil animated:animated completion:completion];
+}
 
+- (IGListPreparedUpdate *)prepareUpdateWithObjects:(NSArray<id<IGListDiffable>> *)objects {
+    IGParameterAssert(objects != nil);
+
+    IGListTransitionData *committedData = self.committedData;
+    NSArray *fromObjects = committedData.toObjects;
+    NSArray *toObjects = objectsWithDuplicateIdentifiersRemoved(objects);
+    IGListIndexSetResult *diffResult = IGListDiff(fromObjects, toObjects, IGListDiffEquality);
+
+    // the diff matches objects by diffIdentifier, which is how the section map of IGListAdapterUpdater looks up existing
+    // section controllers. other updaters look them up on commit. only indexes are recorded, so that section
+    // controllers aren't retained off the main thread.
+    NSMutableArray<NSNumber *> *oldIndexes = nil;
+    if ([self.updater isKindOfClass:[IGListAdapterUpdater class]]) {
+        oldIndexes = [[NSMutableArray alloc] initWithCapacity:toObjects.count];
+        for (id<IGListDiffable> object in toObjects) {
+            [oldIndexes addObject:@([diffResult oldIndexForIdentifier:[object diffIdentifier]])];
+        }
+    }
+
+    return [[IGListPreparedUpdate alloc] initWithFromData:committedData
+                                                  objects:toObjects
+                                               oldIndexes:oldIndexes
+                                               diffResult:diffResult];
+}
+
+- (void)commitPreparedUpdate:(IGListPreparedUpdate *)preparedUpdate
+                    animated:(BOOL)animated
+                  completion:(IGListUpdaterCompletion)completion {
+    IGAssertMainThread();
+    IGParameterAssert(preparedUpdate != nil);
+    [self _performUpdatesWithPreparedUpdate:preparedUpdate animated:animated completion:completion];
+}
+
+- (void)_performUpdatesWithPreparedUpdate:(IGListPreparedUpdate *)preparedUpdate
+                                 animated:(BOOL)animated
+                               completion:(IGListUpdaterCompletion)completion {
     id<IGListAdapterDataSource> dataSource = self.dataSource;
     id<IGListUpdatingDelegate> updater = self.updater;
     UICollectionView *collectionView = self.collectionView;
@@ -447,7 +585,9 @@ typedef struct OffsetRange {
     IGListTransitionDataBlock sectionDataBlock = ^IGListTransitionData *{
         __typeof__(self) strongSelf = weakSelf;
         IGListTransitionData *transitionData = nil;
-        if (strongSelf) {
+        if (strongSelf && preparedUpdate != nil) {
+            transitionData = [strongSelf _generateTransitionDataWithPreparedUpdate:preparedUpdate dataSource:dataSource];
+        } else if (strongSelf) {
             NSArray *toObjects = objectsWithDuplicateIdentifiersRemoved([dataSource objectsForListAdapter:strongSelf]);
             transitionData = [strongSelf _generateTransitionDataWithObjects:toObjects dataSource:dataSource];
         }
@@ -457,9 +597,11 @@ typedef struct OffsetRange {
     IGListTransitionDataApplyBlock applySectionDataBlock = ^void(IGListTransitionData *data) {
         __typeof__(self) strongSelf = weakSelf;
         if (strongSelf) {
-            // temporarily capture the item map that we are transitioning from in case
-            // there are any item deletes at the same
-            strongSelf.previousSectionMap = [strongSelf.sectionMap copy];
+            // temporarily capture the items that we are transitioning from in case
+            // there are any item deletes at the same. copying the map instead would make the update copy its storage
+            strongSelf.previousSectionMap = nil;
+            strongSelf->_previousObjects = strongSelf.sectionMap.objects;
+            strongSelf->_previousSectionControllers = strongSelf.sectionMap.sectionControllers;
             [strongSelf _updateWithData:data];
         }
     };
@@ -473,6 +615,9 @@ typedef struct OffsetRange {
 
         // release the previous items
         strongSelf.previousSectionMap = nil;
+        strongSelf->_previousObjects = nil;
+        strongSelf->_previousSectionControllers = nil;
+        [strongSelf _enqueueRemovedSectionControllers];
         [strongSelf _notifyDidUpdate:IGListAdapterUpdateTypePerformUpdates animated:animated];
         IGLK_BLOCK_CALL_SAFE(completion,finished);
         [strongSelf _exitBatchUpdates];
@@ -503,10 +648,14 @@ typedef struct OffsetRange {
     __weak __typeof__(self) weakSelf = self;
     [self.updater reloadDataWithCollectionViewBlock:[self _collectionViewBlock]
                                   reloadUpdateBlock:^{
+                                      __typeof__(self) strongSelf = weakSelf;
+                                      NSArray<IGListSectionController *> *removableSectionControllers = [strongSelf _removableSectionControllersWithData:nil];
                                       // purge all section controllers from the item map so that they are regenerated
-                                      [weakSelf.sectionMap reset];
-                                      [weakSelf _updateObjects:uniqueObjects dataSource:dataSource];
+                                      [strongSelf.sectionMap reset];
+                                      [strongSelf _updateObjects:uniqueObjects dataSource:dataSource];
+                                      [strongSelf _keepRemovedSectionControllers:removableSectionControllers];
                                   } completion:^(BOOL finished) {
+                                      [weakSelf _enqueueRemovedSectionControllers];
                                       [weakSelf _notifyDidUpdate:IGListAdapterUpdateTypeReloadData animated:NO];
                                       if (completion) {
                                           completion(finished);
@@ -531,6 +680,7 @@ typedef struct OffsetRange {
             return;
         }
         [sections addIndex:section];
+        [self _invalidateItemSizesForObject:object];
 
         // reverse lookup the item using the section. if the pointer has changed the trigger update events and swap items
         if (object != [map objectForSection:section]) {
@@ -587,6 +737,22 @@ typedef struct OffsetRange {
     return [self.sectionMap sectionControllerForObject:object];
 }
 
+- (IGListSectionController *)dequeueReusableSectionControllerOfClass:(Class)sectionControllerClass {
+    IGAssertMainThread();
+    IGParameterAssert([sectionControllerClass isSubclassOfClass:[IGListSectionController class]]);
+
+    NSMutableArray<IGListSectionController *> *reusableSectionControllers = [_reusableSectionControllers objectForKey:sectionControllerClass];
+    IGListSectionController *sectionController = [reusableSectionControllers lastObject];
+    if (sectionController == nil) {
+        return [sectionControllerClass new];
+    }
+    [reusableSectionControllers removeLastObject];
+    sectionController.collectionContext = self;
+    sectionController.viewController = self.viewController;
+    [sectionController prepareForReuse];
+    return sectionController;
+}
+
 - (id)objectForSectionController:(IGListSectionController *)sectionController {
     IGAssertMainThread();
     IGParameterAssert(sectionController != nil);
@@ -624,76 +790,92 @@ typedef struct OffsetRange {
     return [[self.displayHandler visibleListSections] allObjects];
 }
 
-- (NSSet *)_visibleObjectsSet __attribute__((objc_direct)) {
+// calls the block with the section of every section controller with a visible cell, in no particular order
+- (void)_enumerateSectionsWithVisibleCellsUsingBlock:(void (^)(NSInteger section))block __attribute__((objc_direct)) {
     IGAssertMainThread();
 
-    NSArray<UICollectionViewCell *> *visibleCells = [self.collectionView visibleCells];
-    NSMutableSet *visibleObjects = [NSMutableSet new];
-    for (UICollectionViewCell *cell in visibleCells) {
-        IGListSectionController *sectionController = [self _sectionControllerForCell:cell];
-        IGAssert(sectionController != nil, @"Section controller nil for cell %@", cell);
-        if (sectionController != nil) {
-            const NSInteger section = [self sectionForSectionController:sectionController];
-            if (section != NSNotFound) {
-                id object = [self objectAtSection:section];
-                IGAssert(object != nil, @"Object not found for section controller %@ at section %li", sectionController, (long)section);
-                if (object != nil) {
-                    [visibleObjects addObject:object];
-                }
-            }
+    for (IGListSectionController *sectionController in self.displayHandler.visibleCellsBySectionController) {
+        const NSInteger section = [self sectionForSectionController:sectionController];
+        if (section != NSNotFound) {
+            block(section);
         }
     }
-    return visibleObjects;
 }
 
 - (NSArray *)visibleObjects {
-    return [[self _visibleObjectsSet] allObjects];
+    NSMutableArray *visibleObjects = [[NSMutableArray alloc] initWithCapacity:self.displayHandler.visibleCellsBySectionController.count];
+    [self _enumerateSectionsWithVisibleCellsUsingBlock:^(NSInteger section) {
+        id object = [self objectAtSection:section];
+        IGAssert(object != nil, @"Object not found at visible section %li", (long)section);
+        if (object != nil) {
+            [visibleObjects addObject:object];
+        }
+    }];
+    return visibleObjects;
 }
 
 - (NSIndexSet *)indexesOfVisibleObjects {
-    /*
-        This is a naive implementation, going through all objects and checking if they are visible.
-        It is not optimized for performance, but it is correct.
-
-        In the future, this could potentially be optimized by getting the index paths of visible cells,
-        and converting those index paths into a range of object indexes within `self.objects`.
-    */
-
-    NSSet *visibleObjects = [self _visibleObjectsSet];
     NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSet];
-    NSUInteger idx = 0;
-    for (id object in self.objects) {
-        if ([visibleObjects containsObject:object]) {
-            [indexSet addIndex:idx];
-        }
-        idx++;
-    }
+    [self _enumerateSectionsWithVisibleCellsUsingBlock:^(NSInteger section) {
+        [indexSet addIndex:section];
+    }];
     return [indexSet copy];
 }
 
+- (NSRange)visibleSectionRange {
+    __block NSInteger firstSection = NSIntegerMax;
+    __block NSInteger lastSection = -1;
+    [self _enumerateSectionsWithVisibleCellsUsingBlock:^(NSInteger section) {
+        firstSection = MIN(firstSection, section);
+        lastSection = MAX(lastSection, section);
+    }];
+    return lastSection >= 0 ? NSMakeRange(firstSection, lastSection - firstSection + 1) : NSMakeRange(NSNotFound, 0);
+}
+
 - (NSArray<UICollectionViewCell *> *)visibleCellsForObject:(id)object {
     IGAssertMainThread();
     IGParameterAssert(object != nil);
 
-    const NSInteger section = [self.sectionMap sectionForObject:object];
-    if (section == NSNotFound) {
+    IGListSectionController *sectionController = [self.sectionMap sectionControllerForObject:object];
+    if (sectionController == nil) {
         return [NSArray new];
     }
-
-    NSArray<UICollectionViewCell *> *visibleCells = [self.collectionView visibleCells];
-    UICollectionView *collectionView = self.collectionView;
-    NSPredicate *controllerPredicate = [NSPredicate predicateWithBlock:^BOOL(UICollectionViewCell* cell, NSDictionary* bindings) {
-        NSIndexPath *indexPath = [collectionView indexPathForCell:cell];
-        return indexPath.section == section;
-    }];
-
-    return [visibleCells filteredArrayUsingPredicate:controllerPredicate];
+    return [self.displayHandler visibleCellsForSectionController:sectionController];
 }
 
 #pragma mark - Layout
 
 - (CGSize)sizeForItemAtIndexPath:(NSIndexPath *)indexPath {
     IGAssertMainThread();
+
+    IGListItemSizeCache *itemSizeCache = _itemSizeCache;
+    IGListSizeSnapshotStore *sizeSnapshotStore = _sizeSnapshotStore;
+    id object = (itemSizeCache != nil || sizeSnapshotStore != nil) ? [self objectAtSection:indexPath.section] : nil;
+    UICollectionView *collectionView = self.collectionView;
+    if (object != nil && itemSizeCache != nil) {
+        CGSize cachedSize;
+        if ([itemSizeCache getSize:&cachedSize
+                         forObject:object
+                           atIndex:indexPath.item
+                     containerSize:collectionView.bounds.size
+                    containerInset:collectionView.ig_contentInset
+                   traitCollection:collectionView.traitCollection]) {
+            return cachedSize;
+        }
+    }
+
+    if (object != nil && sizeSnapshotStore != nil) {
+        CGSize snapshotSize;
+        if ([sizeSnapshotStore getSize:&snapshotSize
+                             forObject:object
+                               atIndex:indexPath.item
+                        containerWidth:collectionView.bounds.size.width]) {
+            // the store carries it over to the next snapshot, it is verified in -verifySnapshotSizeForItemAtIndexPath:
+            // once displayed
+            return snapshotSize;
+        }
+    }
+
     id<IGListAdapterPerformanceDelegate> performanceDelegate = self.performanceDelegate;
     [performanceDelegate listAdapterWillCallSize:self];
 
@@ -702,9 +884,121 @@ typedef struct OffsetRange {
     const CGSize positiveSize = CGSizeMake(MAX(size.width, 0.0), MAX(size.height, 0.0));
 
     [performanceDelegate listAdapter:self didCallSizeOnSectionController:sectionController atIndex:indexPath.item];
+
+    if (object != nil) {
+        [itemSizeCache setSize:positiveSize
+                     forObject:object
+                       atIndex:indexPath.item
+                 containerSize:collectionView.bounds.size
+                containerInset:collectionView.ig_contentInset
+               traitCollection:collectionView.traitCollection];
+        [sizeSnapshotStore recordSize:positiveSize
+                            forObject:object
+                              atIndex:indexPath.item
+                       containerWidth:collectionView.bounds.size.width];
+    }
     return positiveSize;
 }
 
+- (BOOL)getSizes:(CGSize *)sizes forItemsInRange:(NSRange)range inSection:(NSInteger)section {
+    IGAssertMainThread();
+    IGParameterAssert(sizes != NULL);
+
+    IGListSectionController *sectionController = [self sectionControllerForSection:section];
+    if (![sectionController conformsToProtocol:@protocol(IGListBatchSizing)]) {
+        return NO;
+    }
+
+    IGListItemSizeCache *itemSizeCache = _itemSizeCache;
+    IGListSizeSnapshotStore *sizeSnapshotStore = _sizeSnapshotStore;
+    id object = (itemSizeCache != nil || sizeSnapshotStore != nil) ? [self objectAtSection:section] : nil;
+    UICollectionView *collectionView = self.collectionView;
+    const CGFloat containerWidth = collectionView.bounds.size.width;
+    id<IGListAdapterPerformanceDelegate> performanceDelegate = self.performanceDelegate;
+
+    // items served by the cache or the snapshot are skipped, the rest are measured in contiguous runs. snapshot sizes
+    // are marked as pending by the store, and verified in -verifySnapshotSizeForItemAtIndexPath: once displayed.
+    NSUInteger runStart = 0;
+    for (NSUInteger i = 0; i <= range.length; i++) {
+        BOOL served = i == range.length;
+        if (!served && object != nil) {
+            served = [itemSizeCache getSize:&sizes[i]
+                                  forObject:object
+                                    atIndex:range.location + i
+                              containerSize:collectionView.bounds.size
+                             containerInset:collectionView.ig_contentInset
+                            traitCollection:collectionView.traitCollection]
+            || [sizeSnapshotStore getSize:&sizes[i] forObject:object atIndex:range.location + i containerWidth:containerWidth];
+        }
+        if (!served) {
+            continue;
+        }
+        if (runStart < i) {
+            const NSRange run = NSMakeRange(range.location + runStart, i - runStart);
+            [performanceDelegate listAdapterWillCallSize:self];
+            [(id<IGListBatchSizing>)sectionController getSizes:&sizes[runStart] forItemsInRange:run];
+            // a single callback for the whole run, reported at its first index
+            [performanceDelegate listAdapter:self didCallSizeOnSectionController:sectionController atIndex:run.location];
+
+            for (NSUInteger j = runStart; j < i; j++) {
+                sizes[j] = CGSizeMake(MAX(sizes[j].width, 0.0), MAX(sizes[j].height, 0.0));
+                if (object != nil) {
+                    [itemSizeCache setSize:sizes[j]
+                                 forObject:object
+                                   atIndex:range.location + j
+                             containerSize:collectionView.bounds.size
+                            containerInset:collectionView.ig_contentInset
+                           traitCollection:collectionView.traitCollection];
+                    [sizeSnapshotStore recordSize:sizes[j]
+                                        forObject:object
+                                          atIndex:range.location + j
+                                   containerWidth:containerWidth];
+                }
+            }
+        }
+        runStart = i + 1;
+    }
+    return YES;
+}
+
+- (void)verifySnapshotSizeForItemAtIndexPath:(NSIndexPath *)indexPath {
+    IGListSizeSnapshotStore *sizeSnapshotStore = _sizeSnapshotStore;
+    if (sizeSnapshotStore == nil) {
+        return;
+    }
+    id object = [self objectAtSection:indexPath.section];
+    CGSize snapshotSize;
+    if (object == nil || ![sizeSnapshotStore consumePendingVerificationForObject:object atIndex:indexPath.item snapshotSize:&snapshotSize]) {
+        return;
+    }
+
+    UICollectionView *collectionView = self.collectionView;
+    id<IGListAdapterPerformanceDelegate> performanceDelegate = self.performanceDelegate;
+    [performanceDelegate listAdapterWillCallSize:self];
+
+    IGListSectionController *sectionController = [self sectionControllerForSection:indexPath.section];
+    const CGSize size = [sectionController sizeForItemAtIndex:indexPath.item];
+    const CGSize positiveSize = CGSizeMake(MAX(size.width, 0.0), MAX(size.height, 0.0));
+
+    [performanceDelegate listAdapter:self didCallSizeOnSectionController:sectionController atIndex:indexPath.item];
+
+    const CGFloat containerWidth = collectionView.bounds.size.width;
+
+    // sizes are persisted as floats
+    if ((float)snapshotSize.width == (float)positiveSize.width && (float)snapshotSize.height == (float)positiveSize.height) {
+        [sizeSnapshotStore recordSize:positiveSize forObject:object atIndex:indexPath.item containerWidth:containerWidth];
+        return;
+    }
+
+    // the object changed in a way its content hash does not capture, stop trusting the rest of its persisted sizes
+    [self _invalidateItemSizesForObject:object];
+    [sizeSnapshotStore recordSize:positiveSize forObject:object atIndex:indexPath.item containerWidth:containerWidth];
+
+    UICollectionViewLayoutInvalidationContext *context = [[[collectionView.collectionViewLayout.class invalidationContextClass] alloc] init];
+    [context invalidateItemsAtIndexPaths:@[indexPath]];
+    [collectionView.collectionViewLayout invalidateLayoutWithContext:context];
+}
+
 - (CGSize)sizeForSupplementaryViewOfKind:(NSString *)elementKind atIndexPath:(NSIndexPath *)indexPath {
     IGAssertMainThread();
     id <IGListSupplementaryViewSource> supplementaryViewSource = [self _supplementaryViewSourceAtIndexPath:indexPath];
@@ -724,6 +1018,40 @@ typedef struct OffsetRange {
 }
 
 - (IGListTransitionData *)_generateTransitionDataWithObjects:(NSArray *)objects dataSource:(id<IGListAdapterDataSource>)dataSource {
+    return [self _generateTransitionDataWithObjects:objects oldIndexes:nil fromSectionControllers:nil dataSource:dataSource];
+}
+
+- (IGListTransitionData *)_generateTransitionDataWithPreparedUpdate:(IGListPreparedUpdate *)preparedUpdate
+                                                         dataSource:(id<IGListAdapterDataSource>)dataSource {
+    // the objects are compared too, since -reloadObjects: replaces objects of the map without applying an update
+    NSArray *objects = self.sectionMap.objects;
+    IGListTransitionData *fromData = preparedUpdate.fromData;
+    NSArray *fromObjects = preparedUpdate.fromObjects;
+    BOOL isPreparedFromObjects = fromData != nil && fromData == self.committedData && objects.count == fromObjects.count;
+    for (NSUInteger section = 0; isPreparedFromObjects && section < objects.count; section++) {
+        isPreparedFromObjects = objects[section] == fromObjects[section];
+    }
+    if (!isPreparedFromObjects) {
+        // the adapter changed since the update was prepared, so neither its diff nor its old indexes apply
+        return [self _generateTransitionDataWithObjects:preparedUpdate.objects dataSource:dataSource];
+    }
+
+    IGListTransitionData *data = [self _generateTransitionDataWithObjects:preparedUpdate.objects
+                                                               oldIndexes:preparedUpdate.oldIndexes
+                                                   fromSectionControllers:fromData.toSectionControllers
+                                                               dataSource:dataSource];
+    // the diff only matches the section controllers when they were assigned by diffIdentifier, for IGListAdapterUpdater.
+    // objects without a section controller from the data source are dropped, which invalidates the diff too.
+    if (preparedUpdate.oldIndexes != nil && data.toObjects.count == preparedUpdate.objects.count) {
+        data.diffResult = preparedUpdate.diffResult;
+    }
+    return data;
+}
+
+- (IGListTransitionData *)_generateTransitionDataWithObjects:(NSArray *)objects
+                                                  oldIndexes:(NSArray<NSNumber *> *)oldIndexes
+                                      fromSectionControllers:(NSArray<IGListSectionController *> *)fromSectionControllers
+                                                  dataSource:(id<IGListAdapterDataSource>)dataSource {
     IGListSectionMap *map = self.sectionMap;
 
     if (!dataSource) {
@@ -746,8 +1074,14 @@ typedef struct OffsetRange {
     IGListSectionControllerPushThread(self.viewController, self);
 
     [objects enumerateObjectsUsingBlock:^(id object, NSUInteger idx, BOOL *stop) {
-        // infra checks to see if a controller exists
-        IGListSectionController *sectionController = [map sectionControllerForObject:object];
+        // infra checks to see if a controller exists, unless a prepared update already found it
+        IGListSectionController *sectionController = nil;
+        if (oldIndexes != nil) {
+            const NSInteger oldIndex = [oldIndexes[idx] integerValue];
+            sectionController = oldIndex != NSNotFound ? fromSectionControllers[oldIndex] : nil;
+        } else {
+            sectionController = [map sectionControllerForObject:object];
+        }
 
         // if not, query the data source for a new one
         if (sectionController == nil) {
@@ -790,6 +1124,69 @@ typedef struct OffsetRange {
                                     toSectionControllers:sectionControllers];
 }
 
+// the section controllers that an update can remove from the map: those of the deleted sections when the update applies
+// a diff of the current objects, all of them otherwise
+- (NSArray<IGListSectionController *> *)_removableSectionControllersWithData:(IGListTransitionData *)data {
+    if (_removedSectionControllers == nil) {
+        return nil;
+    }
+    IGListSectionMap *map = self.sectionMap;
+    NSIndexSet *deletes = data.diffResult.deletes;
+    if (deletes == nil || data.fromObjects != map.objects) {
+        NSMutableArray<IGListSectionController *> *sectionControllers = [[NSMutableArray alloc] initWithCapacity:map.sectionCount];
+        [map enumerateUsingBlock:^(id object, IGListSectionController *sectionController, NSInteger section, BOOL *stop) {
+            [sectionControllers addObject:sectionController];
+        }];
+        return sectionControllers;
+    }
+    NSMutableArray<IGListSectionController *> *sectionControllers = [[NSMutableArray alloc] initWithCapacity:deletes.count];
+    for (NSUInteger section = deletes.firstIndex; section != NSNotFound; section = [deletes indexGreaterThanIndex:section]) {
+        IGListSectionController *sectionController = [map sectionControllerForSection:section];
+        if (sectionController != nil) {
+            [sectionControllers addObject:sectionController];
+        }
+    }
+    return sectionControllers;
+}
+
+- (void)_keepRemovedSectionControllers:(NSArray<IGListSectionController *> *)removableSectionControllers {
+    for (IGListSectionController *sectionController in removableSectionControllers) {
+        // section controllers that stay in the list were given their new section by the map
+        if (sectionController.section == NSNotFound) {
+            [_removedSectionControllers addObject:sectionController];
+        }
+    }
+}
+
+// called once an update completed, when the previous section map and the update animations no longer use the removed
+// section controllers
+- (void)_enqueueRemovedSectionControllers {
+    if (_removedSectionControllers.count == 0) {
+        return;
+    }
+    // a reused section controller must not be left in a working range it never exited
+    [self.workingRangeHandler exitRemovedSectionControllersForListAdapter:self];
+    NSCountedSet<IGListSectionController *> *visibleListSections = self.displayHandler.visibleListSections;
+    const NSUInteger maxCount = (NSUInteger)_maxReusableSectionControllersPerClass;
+    for (IGListSectionController *sectionController in _removedSectionControllers) {
+        // skip section controllers that are still displayed, or were returned again by the data source
+        if (sectionController.section != NSNotFound || [visibleListSections countForObject:sectionController] > 0) {
+            continue;
+        }
+        Class sectionControllerClass = [sectionController class];
+        NSMutableArray<IGListSectionController *> *reusableSectionControllers = [_reusableSectionControllers objectForKey:sectionControllerClass];
+        if (reusableSectionControllers == nil) {
+            reusableSectionControllers = [NSMutableArray new];
+            [_reusableSectionControllers setObject:reusableSectionControllers forKey:sectionControllerClass];
+        }
+        if (reusableSectionControllers.count < maxCount) {
+            [self.prefetchScheduler cancelTasksForSectionController:sectionController];
+            [reusableSectionControllers addObject:sectionController];
+        }
+    }
+    [_removedSectionControllers removeAllObjects];
+}
+
 - (void)_updateObjects:(NSArray *)objects dataSource:(id<IGListAdapterDataSource>)dataSource {
     [self _updateWithData:[self _generateTransitionDataWithObjects:objects dataSource:dataSource]];
 }
@@ -807,15 +1204,42 @@ typedef struct OffsetRange {
     // Note: We use an array, instead of a set, because the updater should have dealt with duplicates already.
     NSMutableArray *updatedObjects = [NSMutableArray new];
 
-    for (id object in data.toObjects) {
-        // check if the item has changed instances or is new
-        const NSInteger oldSection = [map sectionForObject:object];
+    NSArray<IGListSectionController *> *toSectionControllers = data.toSectionControllers;
+    [data.toObjects enumerateObjectsUsingBlock:^(id object, NSUInteger idx, BOOL *stop) {
+        // check if the item has changed instances or is new. objects keep their section controller, which is looked up
+        // by pointer instead of hashing the object
+        const NSInteger oldSection = [map sectionForSectionController:toSectionControllers[idx]];
         if (oldSection == NSNotFound || [map objectForSection:oldSection] != object) {
             [updatedObjects addObject:object];
         }
+    }];
+
+    // drops the cached sizes of objects that were updated or removed before the section controllers are asked again,
+    // and the recorded snapshot sizes of removed objects. without a diff, e.g. when reloading, every object is compared.
+    IGListIndexSetResult *diffResult = data.diffResult;
+    IGListSizeSnapshotStore *sizeSnapshotStore = _sizeSnapshotStore;
+    if (diffResult != nil) {
+        [_itemSizeCache updateWithFromObjects:data.fromObjects diffResult:diffResult];
+        if (sizeSnapshotStore != nil) {
+            NSArray *fromObjects = data.fromObjects;
+            [diffResult.deletes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+                [sizeSnapshotStore removeObject:fromObjects[idx]];
+            }];
+        }
+    } else {
+        [_itemSizeCache updateWithObjects:data.toObjects];
+        [sizeSnapshotStore pruneToObjects:data.toObjects];
     }
 
-    [map updateWithObjects:data.toObjects sectionControllers:data.toSectionControllers];
+    NSArray<IGListSectionController *> *removableSectionControllers = [self _removableSectionControllersWithData:data];
+    if (diffResult != nil) {
+        [map updateWithObjects:data.toObjects sectionControllers:toSectionControllers fromObjects:data.fromObjects diffResult:diffResult];
+    } else {
+        [map updateWithObjects:data.toObjects sectionControllers:toSectionControllers];
+    }
+    [self _keepRemovedSectionControllers:removableSectionControllers];
+    [self.workingRangeHandler didUpdateSections];
+    self.committedData = data;
 
     // now that the maps have been created and contexts are assigned, we consider the section controller "fully loaded"
     for (id object in updatedObjects) {
@@ -858,12 +1282,35 @@ typedef struct OffsetRange {
 
 - (IGListSectionMap *)_sectionMapUsingPreviousIfInUpdateBlock:(BOOL)usePreviousMapIfInUpdateBlock {
     // if we are inside an update block, we may have to use the /previous/ item map for some operations
-    IGListSectionMap *previousSectionMap = self.previousSectionMap;
-    if (usePreviousMapIfInUpdateBlock && [self isInDataUpdateBlock] && previousSectionMap != nil) {
-        return previousSectionMap;
-    } else {
+    if (!usePreviousMapIfInUpdateBlock || ![self isInDataUpdateBlock]) {
         return self.sectionMap;
     }
+    if (self.previousSectionMap == nil && _previousObjects != nil) {
+        self.previousSectionMap = [[IGListSectionMap alloc] initWithObjects:_previousObjects
+                                                         sectionControllers:_previousSectionControllers
+                                                                lookupOfMap:self.sectionMap];
+        _previousObjects = nil;
+        _previousSectionControllers = nil;
+    }
+    return self.previousSectionMap ?: self.sectionMap;
+}
+
+- (void)_invalidateItemSizesForObject:(id)object {
+    if (object != nil) {
+        [_itemSizeCache invalidateSizesForObject:object];
+        [_sizeSnapshotStore invalidateObject:object];
+    }
+}
+
+- (void)_invalidateItemSizesForSectionController:(IGListSectionController *)sectionController {
+    if (_itemSizeCache == nil && _sizeSnapshotStore == nil) {
+        return;
+    }
+    IGListSectionMap *map = self.sectionMap;
+    const NSInteger section = [map sectionForSectionController:sectionController];
+    if (section != NSNotFound) {
+        [self _invalidateItemSizesForObject:[map objectForSection:section]];
+    }
 }
 
 - (NSArray<NSIndexPath *> *)indexPathsFromSectionController:(IGListSectionController *)sectionController
@@ -968,19 +1415,56 @@ typedef struct OffsetRange {
     return self.updater.isInDataUpdateBlock;
 }
 
+#pragma mark - Scroll velocity
+
+- (void)_updateScrollVelocityWithScrollView:(UIScrollView *)scrollView {
+    const CFTimeInterval timestamp = CACurrentMediaTime();
+    const CGPoint contentOffset = scrollView.contentOffset;
+    if (scrollView.isDragging) {
+        // the gesture already smooths the finger velocity, and the content moves the other way
+        _scrollVelocity = -IGListScrollComponent([scrollView.panGestureRecognizer velocityInView:scrollView]);
+    } else {
+        const CFTimeInterval elapsed = timestamp - _lastScrollTimestamp;
+        if (_lastScrollTimestamp > 0 && elapsed > 0) {
+            // frames of a fling don't arrive at a steady rate, so a single one doesn't set the velocity
+            const CGPoint distance = CGPointMake(contentOffset.x - _lastScrollContentOffset.x, contentOffset.y - _lastScrollContentOffset.y);
+            _scrollVelocity += kIGListScrollVelocitySmoothing * (IGListScrollComponent(distance) / elapsed - _scrollVelocity);
+        }
+    }
+    _lastScrollTimestamp = timestamp;
+    _lastScrollContentOffset = contentOffset;
+    [self.workingRangeHandler updateScrollVelocity:_scrollVelocity forListAdapter:self];
+}
+
+- (void)_resetScrollVelocity {
+    _lastScrollTimestamp = 0;
+    _scrollVelocity = 0;
+    [self.workingRangeHandler updateScrollVelocity:0 forListAdapter:self];
+}
+
 #pragma mark - UIScrollViewDelegate
 
 - (void)scrollViewDidScroll:(UIScrollView *)scrollView {
     id<IGListAdapterPerformanceDelegate> performanceDelegate = self.performanceDelegate;
     [performanceDelegate listAdapterWillCallScroll:self];
 
+    if (_directionalWorkingRangeEnabled) {
+        // programmatic scrolls jump to their destination, so only drags and flings lean the working range
+        if (scrollView.isDragging || scrollView.isDecelerating) {
+            [self _updateScrollVelocityWithScrollView:scrollView];
+        } else if (_lastScrollTimestamp > 0) {
+            [self _resetScrollVelocity];
+        }
+    }
+
     // forward this method to the delegate b/c this implementation will steal the message from the proxy
     id<UIScrollViewDelegate> scrollViewDelegate = self.scrollViewDelegate;
     if ([scrollViewDelegate respondsToSelector:@selector(scrollViewDidScroll:)]) {
         [scrollViewDelegate scrollViewDidScroll:scrollView];
     }
-    NSArray<IGListSectionController *> *visibleSectionControllers = [self visibleSectionControllers];
-    for (IGListSectionController *sectionController in visibleSectionControllers) {
+    NSArray<IGListSectionController *> *scrollSubscribers = self.displayHandler.scrollSubscribers;
+    for (NSUInteger i = 0; i < scrollSubscribers.count; i++) {
+        IGListSectionController *sectionController = scrollSubscribers[i];
         [[sectionController scrollDelegate] listAdapter:self didScrollSectionController:sectionController];
     }
 
@@ -993,8 +1477,9 @@ typedef struct OffsetRange {
     if ([scrollViewDelegate respondsToSelector:@selector(scrollViewWillBeginDragging:)]) {
         [scrollViewDelegate scrollViewWillBeginDragging:scrollView];
     }
-    NSArray<IGListSectionController *> *visibleSectionControllers = [self visibleSectionControllers];
-    for (IGListSectionController *sectionController in visibleSectionControllers) {
+    NSArray<IGListSectionController *> *scrollSubscribers = self.displayHandler.scrollSubscribers;
+    for (NSUInteger i = 0; i < scrollSubscribers.count; i++) {
+        IGListSectionController *sectionController = scrollSubscribers[i];
         [[sectionController scrollDelegate] listAdapter:self willBeginDraggingSectionController:sectionController];
     }
 }
@@ -1005,10 +1490,15 @@ typedef struct OffsetRange {
     if ([scrollViewDelegate respondsToSelector:@selector(scrollViewDidEndDragging:willDecelerate:)]) {
         [scrollViewDelegate scrollViewDidEndDragging:scrollView willDecelerate:decelerate];
     }
-    NSArray<IGListSectionController *> *visibleSectionControllers = [self visibleSectionControllers];
-    for (IGListSectionController *sectionController in visibleSectionControllers) {
+    NSArray<IGListSectionController *> *scrollSubscribers = self.displayHandler.scrollSubscribers;
+    for (NSUInteger i = 0; i < scrollSubscribers.count; i++) {
+        IGListSectionController *sectionController = scrollSubscribers[i];
         [[sectionController scrollDelegate] listAdapter:self didEndDraggingSectionController:sectionController willDecelerate:decelerate];
     }
+
+    if (_directionalWorkingRangeEnabled && !decelerate) {
+        [self _resetScrollVelocity];
+    }
 }
 
 - (void)scrollViewDidEndDecelerating:(UIScrollView *)scrollView {
@@ -1017,13 +1507,18 @@ typedef struct OffsetRange {
     if ([scrollViewDelegate respondsToSelector:@selector(scrollViewDidEndDecelerating:)]) {
         [scrollViewDelegate scrollViewDidEndDecelerating:scrollView];
     }
-    NSArray<IGListSectionController *> *visibleSectionControllers = [self visibleSectionControllers];
-    for (IGListSectionController *sectionController in visibleSectionControllers) {
+    NSArray<IGListSectionController *> *scrollSubscribers = self.displayHandler.scrollSubscribers;
+    for (NSUInteger i = 0; i < scrollSubscribers.count; i++) {
+        IGListSectionController *sectionController = scrollSubscribers[i];
         id<IGListScrollDelegate> scrollDelegate = [sectionController scrollDelegate];
         if ([scrollDelegate respondsToSelector:@selector(listAdapter:didEndDeceleratingSectionController:)]) {
             [scrollDelegate listAdapter:self didEndDeceleratingSectionController:sectionController];
         }
     }
+
+    if (_directionalWorkingRangeEnabled) {
+        [self _resetScrollVelocity];
+    }
 }
 
 #pragma mark - IGListCollectionContext
@@ -1143,14 +1638,11 @@ typedef struct OffsetRange {
 
     NSMutableArray *cells = [NSMutableArray new];
     UICollectionView *collectionView = self.collectionView;
-    NSArray *visibleCells = [collectionView visibleCells];
-
-    for (UICollectionViewCell *cell in visibleCells) {
-        if ([collectionView indexPathForCell:cell].section == section) {
-            const CGRect cellRect = [cell convertRect:cell.bounds toView:collectionView];
-            if (CGRectContainsRect(UIEdgeInsetsInsetRect(collectionView.bounds, collectionView.contentInset), cellRect)) {
-                [cells addObject:cell];
-            }
+    const CGRect visibleRect = UIEdgeInsetsInsetRect(collectionView.bounds, collectionView.contentInset);
+    for (UICollectionViewCell *cell in [self.displayHandler.visibleCellsBySectionController objectForKey:sectionController]) {
+        const CGRect cellRect = [cell convertRect:cell.bounds toView:collectionView];
+        if (CGRectContainsRect(visibleRect, cellRect)) {
+            [cells addObject:cell];
         }
     }
     return cells;
@@ -1163,16 +1655,7 @@ typedef struct OffsetRange {
         return @[];
     }
 
-    NSMutableArray *cells = [NSMutableArray new];
-    UICollectionView *collectionView = self.collectionView;
-    NSArray *visibleCells = [collectionView visibleCells];
-
-    for (UICollectionViewCell *cell in visibleCells) {
-        if ([collectionView indexPathForCell:cell].section == section) {
-            [cells addObject:cell];
-        }
-    }
-    return cells;
+    return [self.displayHandler visibleCellsForSectionController:sectionController];
 }
 
 - (NSArray<NSIndexPath *> *)visibleIndexPathsForSectionController:(IGListSectionController *) sectionController {
@@ -1182,12 +1665,12 @@ typedef struct OffsetRange {
         return @[];
     }
 
+    // items can move within the section without being displayed again, so the collection view has their index paths
     NSMutableArray *paths = [NSMutableArray new];
     UICollectionView *collectionView = self.collectionView;
-    NSArray *visiblePaths = [collectionView indexPathsForVisibleItems];
-
-    for (NSIndexPath *path in visiblePaths) {
-        if (path.section == section) {
+    for (UICollectionViewCell *cell in [self.displayHandler.visibleCellsBySectionController objectForKey:sectionController]) {
+        NSIndexPath *path = [collectionView indexPathForCell:cell];
+        if (path != nil) {
             [paths addObject:path];
         }
     }
@@ -1401,6 +1884,8 @@ typedef struct OffsetRange {
         return;
     }
 
+    [self _invalidateItemSizesForSectionController:sectionController];
+
     const NSInteger items = [_collectionView numberOfItemsInSection:section];
 
     NSMutableArray<NSIndexPath *> *indexPaths = [NSMutableArray new];
@@ -1430,6 +1915,8 @@ typedef struct OffsetRange {
         return;
     }
 
+    [self _invalidateItemSizesForSectionController:sectionController];
+
     /**
      UICollectionView is not designed to support -reloadSections: or -reloadItemsAtIndexPaths: during batch updates.
      Internally it appears to convert these operations to a delete+insert. However the transformation is too simple
@@ -1468,6 +1955,8 @@ typedef struct OffsetRange {
         return;
     }
 
+    [self _invalidateItemSizesForSectionController:sectionController];
+
     NSArray *indexPaths = [self indexPathsFromSectionController:sectionController indexes:indexes usePreviousIfInUpdateBlock:NO];
     [self.updater insertItemsIntoCollectionView:collectionView indexPaths:indexPaths];
 
@@ -1487,6 +1976,8 @@ typedef struct OffsetRange {
         return;
     }
 
+    [self _invalidateItemSizesForSectionController:sectionController];
+
     NSArray *indexPaths = [self indexPathsFromSectionController:sectionController indexes:indexes usePreviousIfInUpdateBlock:YES];
     [self.updater deleteItemsFromCollectionView:collectionView indexPaths:indexPaths];
 
@@ -1506,6 +1997,8 @@ typedef struct OffsetRange {
         return;
     }
 
+    [self _invalidateItemSizesForSectionController:sectionController];
+
     NSArray *indexPaths = [self indexPathsFromSectionController:sectionController indexes:indexes usePreviousIfInUpdateBlock:NO];
     UICollectionViewLayout *layout = collectionView.collectionViewLayout;
     UICollectionViewLayoutInvalidationContext *context = [[[layout.class invalidationContextClass] alloc] init];
@@ -1529,6 +2022,7 @@ typedef struct OffsetRange {
         return;
     }
 
+    [self _invalidateItemSizesForSectionController:sectionController];
     [self.updater moveItemInCollectionView:collectionView fromIndexPath:fromIndexPath toIndexPath:toIndexPath];
 }
 
@@ -1544,6 +2038,8 @@ typedef struct OffsetRange {
         return;
     }
 
+    [self _invalidateItemSizesForObject:[map objectForSection:section]];
+
     NSIndexSet *sections = [NSIndexSet indexSetWithIndex:section];
     [self.updater reloadCollectionView:collectionView sections:sections];
 
@@ -1605,6 +2101,7 @@ typedef struct OffsetRange {
     IGParameterAssert(fromIndex >= 0);
     IGParameterAssert(toIndex >= 0);
 
+    [self _invalidateItemSizesForSectionController:sectionController];
     [sectionController moveObjectFromIndex:fromIndex toIndex:toIndex];
 }
 
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Conform your `IGListSectionController` subclass to `IGListBatchSizing` to provide the sizes of many items in a single
+ call. `IGListCollectionViewLayout` then sizes a whole section with one call instead of one
+ `-sizeForItemAtIndex:` per item.
+
+ @note `-sizeForItemAtIndex:` is still used when a single item is sized, so both must return the same sizes.
+ */
+NS_SWIFT_NAME(ListBatchSizing)
+@protocol IGListBatchSizing <NSObject>
+
+/**
+ Fills `sizes` with the sizes of the items in `range`.
+
+ @param sizes A buffer of `range.length` sizes. `sizes[0]` is the size of the item at `range.location`.
+ @param range The range of item indexes to size.
+ */
+- (void)getSizes:(CGSize *)sizes forItemsInRange:(NSRange)range;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -97,8 +97,14 @@
 #pragma mark - Modified index path
 
 - (void)_didModifyIndexPaths:(NSArray<NSIndexPath *> *)indexPaths {
+    UICollectionViewLayout<IGListCollectionViewLayoutCompatible> *layout = self._listLayout;
+    const BOOL tracksItems = [layout respondsToSelector:@selector(didModifyItemAtIndexPath:)];
     for (NSIndexPath *indexPath in indexPaths) {
-        [self _didModifySection:indexPath.section];
+        if (tracksItems) {
+            [layout didModifyItemAtIndexPath:indexPath];
+        } else {
+            [self _didModifySection:indexPath.section];
+        }
     }
 }
 
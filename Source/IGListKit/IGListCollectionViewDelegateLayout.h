@@ -32,4 +32,33 @@
  */
 - (UICollectionViewLayoutAttributes *)collectionView:(UICollectionView *)collectionView layout:(UICollectionViewLayout*)collectionViewLayout customizedFinalLayoutAttributes:(UICollectionViewLayoutAttributes *)attributes atIndexPath:(NSIndexPath *)indexPath;
 
+@optional
+
+/**
+ Asks the delegate for the sizes of a range of items in a single call. The layout falls back to
+ `-collectionView:layout:sizeForItemAtIndexPath:` for every item when this returns `NO`.
+
+ @param collectionView The collection view being laid out.
+ @param collectionViewLayout The layout requesting the sizes.
+ @param sizes A buffer of `range.length` sizes. `sizes[0]` is the size of the item at `range.location`.
+ @param range The range of items to size.
+ @param section The section of the items.
+
+ @return `YES` if `sizes` was filled.
+ */
+- (BOOL)collectionView:(UICollectionView *)collectionView layout:(UICollectionViewLayout *)collectionViewLayout getSizes:(CGSize *)sizes forItemsInRange:(NSRange)range inSection:(NSInteger)section;
+
+/**
+ Asks the delegate for the number of columns to pack the items of a section in. `IGListCollectionViewLayout` places
+ each item in the shortest column and stretches it to the width of the column (height when scrolling horizontally). The
+ items of a section with no columns wrap in rows.
+
+ @param collectionView The collection view being laid out.
+ @param collectionViewLayout The layout requesting the number of columns.
+ @param section The section.
+
+ @return The number of columns of the section, or 0 to wrap its items in rows.
+ */
+- (NSInteger)collectionView:(UICollectionView *)collectionView layout:(UICollectionViewLayout *)collectionViewLayout numberOfColumnsInSection:(NSInteger)section;
+
 @end
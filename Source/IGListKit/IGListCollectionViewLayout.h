@@ -76,6 +76,20 @@ NS_ASSUME_NONNULL_BEGIN
  In a horizontally scrolling layout, sections and items are flowed vertically until they need to be "newlined" to the
  next column. Headers, if used, are stretched to the height of the collection view, minus the section insets.
 
+ A section can instead pack its items in columns, when the delegate implements
+ `-collectionView:layout:numberOfColumnsInSection:` of `IGListCollectionViewDelegateLayout`, e.g. through
+ `IGListSectionController.numberOfColumns`. The section always starts on a new row, each item goes to the shortest
+ column and is stretched to the width of the column. Interitem spacing separates the columns and line spacing separates
+ the items of a column.
+
+ Ex. of a section (1) with 3 columns and items of different heights.
+ ```
+ |[ 1,0 ][ 1,1 ][ 1,2 ]|
+ |[     ][ 1,3 ][     ]|
+ |[     ][     ][ 1,4 ]|
+ |[ 1,5 ]       [     ]|
+ ```
+
  Please see the unit tests for more configuration examples and expected output.
  */
 NS_SWIFT_NAME(ListCollectionViewLayout)
@@ -106,6 +120,33 @@ NS_SWIFT_NAME(ListCollectionViewLayout)
 */
 @property (nonatomic, assign) BOOL preserveLayoutCacheOnInvalidateLayout;
 
+/**
+ Set this to `YES` to store item frames as 32-bit floats, halving the memory of the layout cache for very large lists.
+ Frames farther than ~1M points from the origin lose sub-pixel precision in this mode. Default is `NO`.
+
+ @note Changing the value on this property will invalidate the layout.
+ */
+@property (nonatomic, assign) BOOL usesCompactFrameStorage;
+
+/**
+ Set this to `YES` to lay out sections that start on a new row (e.g. sections with a header, or after a full width
+ item) concurrently on background threads when the layout is rebuilt, e.g. after a rotation. Item sizes are still
+ requested from the delegate on the main thread, before any section is laid out. Default is `NO`.
+
+ @note Frames are the same as when this is disabled, but a section with many items is always laid out again from its
+ first item, instead of from the row of its first modified item.
+ */
+@property (nonatomic, assign) BOOL usesConcurrentSectionLayout;
+
+/**
+ Set this to `YES` to keep the measured sizes of every section and carry them over batch updates applied by
+ `IGListAdapterUpdater`. Sections that are only moved or shifted by the update are laid out again from their previous
+ sizes without asking the delegate, and only inserted, reloaded or item-modified sections are measured. Default is `NO`.
+
+ @note Only enable this if the sizes of a section do not depend on its index, e.g. on `isFirstSection`.
+ */
+@property (nonatomic, assign) BOOL usesBatchUpdateRemapping;
+
 /**
  Create and return a new collection view layout.
 
@@ -8,37 +8,26 @@
 #import "IGListCollectionViewLayout.h"
 #import "IGListCollectionViewLayoutInternal.h"
 
+#import <algorithm>
+#import <functional>
 #import <vector>
 
 #if !__has_include(<IGListDiffKit/IGListDiffKit.h>)
 #import "IGListAssert.h"
+#import "IGListBatchUpdateData.h"
 #else
 #import <IGListDiffKit/IGListAssert.h>
+#import <IGListDiffKit/IGListBatchUpdateData.h>
 #endif
 #import "IGListCollectionViewDelegateLayout.h"
 #import "IGListCollectionViewLayoutInvalidationContext.h"
+#import "IGListLayoutFrameStorage.h"
+#import "IGListLayoutSpanIndex.h"
+#import "IGListSectionLayout.h"
 
 #import "UIScrollView+IGListKit.h"
 #import "IGListAdapter.h"
 
-static CGFloat UIEdgeInsetsLeadingInsetInDirection(UIEdgeInsets insets, UICollectionViewScrollDirection direction) {
-    switch (direction) {
-        case UICollectionViewScrollDirectionVertical: return insets.top;
-        case UICollectionViewScrollDirectionHorizontal: return insets.left;
-        default: /* unexpected */
-            IGLK_UNEXPECTED_SWITCH_CASE_ABORT(UICollectionViewScrollDirection, direction);
-    }
-}
-
-static CGFloat UIEdgeInsetsTrailingInsetInDirection(UIEdgeInsets insets, UICollectionViewScrollDirection direction) {
-    switch (direction) {
-        case UICollectionViewScrollDirectionVertical: return insets.bottom;
-        case UICollectionViewScrollDirectionHorizontal: return insets.right;
-        default: /* unexpected */
-            IGLK_UNEXPECTED_SWITCH_CASE_ABORT(UICollectionViewScrollDirection, direction);
-    }
-}
-
 static CGFloat CGPointGetCoordinateInDirection(CGPoint point, UICollectionViewScrollDirection direction) {
     switch (direction) {
         case UICollectionViewScrollDirectionVertical: return point.y;
@@ -57,19 +46,19 @@ static CGFloat CGRectGetLengthInDirection(CGRect rect, UICollectionViewScrollDir
     }
 }
 
-static CGFloat CGRectGetMaxInDirection(CGRect rect, UICollectionViewScrollDirection direction) {
+static CGFloat CGRectGetMinInDirection(CGRect rect, UICollectionViewScrollDirection direction) {
     switch (direction) {
-        case UICollectionViewScrollDirectionVertical: return CGRectGetMaxY(rect);
-        case UICollectionViewScrollDirectionHorizontal: return CGRectGetMaxX(rect);
+        case UICollectionViewScrollDirectionVertical: return CGRectGetMinY(rect);
+        case UICollectionViewScrollDirectionHorizontal: return CGRectGetMinX(rect);
         default: /* unexpected */
             IGLK_UNEXPECTED_SWITCH_CASE_ABORT(UICollectionViewScrollDirection, direction);
     }
 }
 
-static CGFloat CGRectGetMinInDirection(CGRect rect, UICollectionViewScrollDirection direction) {
+static CGFloat CGRectGetMaxInDirection(CGRect rect, UICollectionViewScrollDirection direction) {
     switch (direction) {
-        case UICollectionViewScrollDirectionVertical: return CGRectGetMinY(rect);
-        case UICollectionViewScrollDirectionHorizontal: return CGRectGetMinX(rect);
+        case UICollectionViewScrollDirectionVertical: return CGRectGetMaxY(rect);
+        case UICollectionViewScrollDirectionHorizontal: return CGRectGetMaxX(rect);
         default: /* unexpected */
             IGLK_UNEXPECTED_SWITCH_CASE_ABORT(UICollectionViewScrollDirection, direction);
     }
@@ -84,24 +73,24 @@ static CGFloat CGSizeGetLengthInDirection(CGSize size, UICollectionViewScrollDir
     }
 }
 
-static NSIndexPath *indexPathForSection(NSInteger section) {
-    return [NSIndexPath indexPathForItem:0 inSection:section];
+static IGListLayoutRect IGListLayoutRectFromCGRect(CGRect rect) {
+    return {rect.origin.x, rect.origin.y, rect.size.width, rect.size.height};
 }
 
-static NSInteger IGListMergeMinimumInvalidatedSection(NSInteger section, NSInteger otherSection) {
-    if (section == NSNotFound && otherSection == NSNotFound) {
-        return NSNotFound;
-    }
-    if (section == NSNotFound) {
-        return otherSection;
-    }
-    if (otherSection == NSNotFound) {
-        return section;
-    }
+static CGRect CGRectFromIGListLayoutRect(IGListLayoutRect rect) {
+    return CGRectMake(rect.x, rect.y, rect.width, rect.height);
+}
 
-    return MIN(section, otherSection);
+// below this many items dispatching to other threads costs more than laying out on the main thread
+static const NSInteger kIGListConcurrentSectionLayoutMinimumItemCount = 2000;
+
+static NSIndexPath *indexPathForSection(NSInteger section) {
+    return [NSIndexPath indexPathForItem:0 inSection:section];
 }
 
+// below this many items laying out a section again is cheaper than keeping the state of each of its rows
+static const NSInteger kIGListRowCursorMinimumItemCount = 64;
+
 struct IGListSectionEntry {
     /**
      Represents the minimum-bounding box of every element in the section. This includes all item frames as well as the
@@ -119,9 +108,6 @@ struct IGListSectionEntry {
     // The RESTING frame of the footer view
     CGRect footerBounds;
 
-    // An array of frames for each cell in the section.
-    std::vector<CGRect> itemBounds;
-
     // last item distance in scroll direction, used for partial invalidation
     CGFloat lastItemCoordInScrollDirection;
 
@@ -131,12 +117,36 @@ struct IGListSectionEntry {
     // last next row distance in scroll direction, used for partial invalidation
     CGFloat lastNextRowCoordInScrollDirection;
 
+    // The sizes, spacings and columns the section was laid out with. Its rows can only be reused when they did not change.
+    CGSize headerSize;
+    CGSize footerSize;
+    CGFloat lineSpacing;
+    CGFloat interitemSpacing;
+    NSInteger columnCount;
+
     // Returns YES when the section has visible content (header and/or items).
-    BOOL isValid() {
+    BOOL isValid() const {
         return !CGSizeEqualToSize(bounds.size, CGSizeZero);
     }
 };
 
+/**
+ A layout attributes object that outlives invalidations. The object is valid only while its generation matches the
+ generation of the layout, and a stale object is updated in place the next time it is requested instead of being
+ reallocated.
+ */
+struct IGListAttributesSlot {
+    UICollectionViewLayoutAttributes *attributes;
+    NSUInteger generation;
+};
+
+// Recycled attributes of a section, indexed by item.
+struct IGListSectionAttributes {
+    std::vector<IGListAttributesSlot> items;
+    IGListAttributesSlot header;
+    IGListAttributesSlot footer;
+};
+
 // Each section has a base zIndex of section * maxZIndexPerSection;
 // section header adds (maxZIndexPerSection - 1) to the base zIndex;
 // other cells adds (item) to the base zIndex.
@@ -162,22 +172,54 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
 
 @implementation IGListCollectionViewLayout {
     std::vector<IGListSectionEntry> _sectionData;
-    NSMutableDictionary<NSIndexPath *, UICollectionViewLayoutAttributes *> *_attributesCache;
 
-    // invalidate starting at this section
+    // Frames of every cell, for all sections, in one contiguous buffer.
+    IGListLayoutFrameStorage _itemFrames;
+
+    // Spans of every section and every cell in the scroll direction, to answer rect queries without walking all of them.
+    // The hints keep the range of the last query, so the overlapping queries of a scroll only move its edges.
+    IGListLayoutSpanIndex _sectionSpans;
+    IGListLayoutSpanIndex _itemSpans;
+    IGListLayoutSpanIndexHint _sectionSpansHint;
+    IGListLayoutSpanIndexHint _itemSpansHint;
+
+    // first section starting before the previous one, or NSNotFound while every section starts in order
+    NSInteger _firstUnorderedSection;
+
+    // Cell and supplementary attributes of every section. Bumping a generation invalidates all attributes of that kind.
+    std::vector<IGListSectionAttributes> _sectionAttributes;
+    NSUInteger _itemAttributesGeneration;
+
+    // invalidate starting at this item of this section
     NSInteger _minimumInvalidatedSection;
+    NSInteger _minimumInvalidatedItem;
+
+    // The state of the layout at the start of every row of the sections with many items, so a section can be laid out
+    // again from the row of its first modified item. The rows of a section are [offsets[section], offsets[section + 1]).
+    std::vector<IGListSectionRowCursor> _rowCursors;
+    std::vector<size_t> _rowCursorOffsets;
+
+    // scratch buffer for sizes returned by -collectionView:layout:getSizes:forItemsInRange:inSection:
+    std::vector<CGSize> _batchItemSizes;
+
+    // Measured input of every section, only kept when usesBatchUpdateRemapping is enabled.
+    std::vector<IGListSectionLayoutInput> _sectionInputs;
+
+    // Sections whose entry in _sectionInputs survived the last batch update untouched and can be laid out again without
+    // asking the delegate. Set in -willApplyBatchUpdateData: and consumed by the next layout pass.
+    std::vector<bool> _reusableSectionInputs;
 
     /**
      The workflow for getting sticky headers working:
      1. Use a custom invalidation context to mark supplementary attributes invalid.
      2. Return YES from -shouldInvalidateLayoutForBoundsChange:
      3. In -invalidationContextForBoundsChange: mark supplementary attributes invalid on the custom context.
-     4. Purge supplementary caches in -invalidateLayoutWithContext: if context says they are invalid
-     5. Use cached attributes in -layoutAttributesForSupplementaryViewOfKind:atIndexPath: if they exist, else rebuild
+     4. Bump the supplementary generation in -invalidateLayoutWithContext: if context says they are invalid
+     5. Use cached attributes in -layoutAttributesForSupplementaryViewOfKind:atIndexPath: if they are current, else rebuild
      6. Make sure -layoutAttributesForElementsInRect: always uses the attributes returned from
      -layoutAttributesForSupplementaryViewOfKind:atIndexPath:.
      */
-    NSMutableDictionary<NSString *, NSMutableDictionary <NSIndexPath *, UICollectionViewLayoutAttributes *> *> *_supplementaryAttributesCache;
+    NSUInteger _supplementaryAttributesGeneration;
 }
 
 - (instancetype)initWithStickyHeaders:(BOOL)stickyHeaders
@@ -198,12 +240,12 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
         _stickyHeaders = stickyHeaders;
         _topContentInset = topContentInset;
         _stretchToEdge = stretchToEdge;
-        _attributesCache = [NSMutableDictionary new];
-        _supplementaryAttributesCache = [NSMutableDictionary dictionaryWithDictionary:@{
-                                                                                        UICollectionElementKindSectionHeader: [NSMutableDictionary new],
-                                                                                        UICollectionElementKindSectionFooter: [NSMutableDictionary new],
-                                                                                        }];
+        // slots start at generation 0, so nothing is considered cached until it is built once
+        _itemAttributesGeneration = 1;
+        _supplementaryAttributesGeneration = 1;
         _minimumInvalidatedSection = NSNotFound;
+        _firstUnorderedSection = NSNotFound;
+        _rowCursorOffsets.push_back(0);
         _preserveLayoutCacheOnInvalidateLayout = NO;
     }
     return self;
@@ -238,38 +280,47 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
 - (NSArray<UICollectionViewLayoutAttributes *> *)layoutAttributesForElementsInRect:(CGRect)rect {
     IGAssertMainThread();
 
-    NSMutableArray *result = [NSMutableArray new];
-
     const NSRange range = [self _rangeOfSectionsInRect:rect];
     if (range.location == NSNotFound) {
         return nil;
     }
 
-    for (NSInteger section = range.location; section < (NSInteger)NSMaxRange(range); section++) {
-        const NSInteger itemCount = _sectionData[section].itemBounds.size();
+    NSMutableArray *result = [NSMutableArray new];
+    const UICollectionViewScrollDirection scrollDirection = self.scrollDirection;
+    // a C array, so that the queries of a scroll do not allocate an array per section
+    NSString *const elementKinds[] = {UICollectionElementKindSectionHeader, UICollectionElementKindSectionFooter};
 
+    for (NSInteger section = range.location; section < (NSInteger)NSMaxRange(range); section++) {
         // do not add headers if there are no items
-        if (itemCount > 0 || self.showHeaderWhenEmpty) {
-            for (NSString *elementKind in _supplementaryAttributesCache.allKeys) {
-                NSIndexPath *indexPath = indexPathForSection(section);
+        if (_itemFrames.itemCount(section) > 0 || self.showHeaderWhenEmpty) {
+            NSIndexPath *indexPath = indexPathForSection(section);
+            for (NSString *elementKind : elementKinds) {
                 UICollectionViewLayoutAttributes *attributes = [self layoutAttributesForSupplementaryViewOfKind:elementKind
                                                                                                     atIndexPath:indexPath];
                 // do not add zero height headers/footers or headers/footers that are outside the rect
                 const CGRect frame = attributes.frame;
                 const CGRect intersection = CGRectIntersection(frame, rect);
-                if (attributes && !CGRectIsEmpty(intersection) && CGRectGetLengthInDirection(frame, self.scrollDirection) > 0.0) {
+                if (attributes && !CGRectIsEmpty(intersection) && CGRectGetLengthInDirection(frame, scrollDirection) > 0.0) {
                     [result addObject:attributes];
                 }
             }
         }
+    }
 
-        // add all cells within the rect, return early if it starts iterating outside
-        for (NSInteger item = 0; item < itemCount; item++) {
-            NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
-            UICollectionViewLayoutAttributes *attributes = [self layoutAttributesForItemAtIndexPath:indexPath];
-            if (attributes && CGRectIntersectsRect(attributes.frame, rect)) {
-                [result addObject:attributes];
-            }
+    // add all cells within the rect, checking the stored frame first so cells outside it don't build attributes
+    _itemSpans.find(CGRectGetMinInDirection(rect, scrollDirection), CGRectGetMaxInDirection(rect, scrollDirection), _itemSpansHint);
+    NSInteger section = _itemSpansHint.first < _itemSpansHint.last ? _itemFrames.sectionOfItemIndex(_itemSpansHint.first) : 0;
+    for (size_t index = _itemSpansHint.first; index < _itemSpansHint.last; index++) {
+        if (!CGRectIntersectsRect(CGRectFromIGListLayoutRect(_itemFrames.frameAtIndex(index)), rect)) {
+            continue;
+        }
+        while (index >= _itemFrames.firstItemIndex(section + 1)) {
+            section++;
+        }
+        NSIndexPath *indexPath = [NSIndexPath indexPathForItem:index - _itemFrames.firstItemIndex(section) inSection:section];
+        UICollectionViewLayoutAttributes *attributes = [self layoutAttributesForItemAtIndexPath:indexPath];
+        if (attributes && CGRectIntersectsRect(attributes.frame, rect)) {
+            [result addObject:attributes];
         }
     }
 
@@ -280,11 +331,6 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
     IGAssertMainThread();
     IGParameterAssert(indexPath != nil);
 
-    UICollectionViewLayoutAttributes *attributes = _attributesCache[indexPath];
-    if (attributes != nil) {
-        return attributes;
-    }
-
     if (indexPath == nil) {
         return nil;
     }
@@ -292,21 +338,33 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
     // avoid OOB errors
     const NSInteger section = indexPath.section;
     const NSInteger item = indexPath.item;
-    if (section >= (ssize_t)_sectionData.size()
-        || item >= (ssize_t)_sectionData[section].itemBounds.size()) {
+    if (section >= (ssize_t)_itemFrames.sectionCount()
+        || item >= (ssize_t)_itemFrames.itemCount(section)
+        || section >= (ssize_t)_sectionAttributes.size()
+        || item >= (ssize_t)_sectionAttributes[section].items.size()) {
         return nil;
     }
 
-    attributes = [[[self class] layoutAttributesClass] layoutAttributesForCellWithIndexPath:indexPath];
-    CGRect frame = _sectionData[indexPath.section].itemBounds[indexPath.item];
+    IGListAttributesSlot &slot = _sectionAttributes[section].items[item];
+    if (slot.attributes != nil && slot.generation == _itemAttributesGeneration) {
+        return slot.attributes;
+    }
+
+    CGRect frame = CGRectFromIGListLayoutRect(_itemFrames.frame(section, item));
     // Avoid setting frames with nan values
     if (isnan(frame.origin.x) || isnan(frame.origin.y) || isnan(frame.size.width) || isnan(frame.size.height)) {
         IGFailAssert(@"IGListCollectionViewLayout encountered nan frame values for indexPath %@. Original frame: %@", indexPath, NSStringFromCGRect(frame));
         return nil;
     }
+
+    // recycle the attributes built for this index path before the last invalidation
+    if (slot.attributes == nil) {
+        slot.attributes = [[[self class] layoutAttributesClass] layoutAttributesForCellWithIndexPath:indexPath];
+    }
+    UICollectionViewLayoutAttributes *attributes = slot.attributes;
     attributes.frame = frame;
     adjustZIndexForAttributes(attributes);
-    _attributesCache[indexPath] = attributes;
+    slot.generation = _itemAttributesGeneration;
     return attributes;
 }
 
@@ -314,19 +372,25 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
     IGAssertMainThread();
     IGParameterAssert(indexPath != nil);
 
-    UICollectionViewLayoutAttributes *attributes = _supplementaryAttributesCache[elementKind][indexPath];
-    if (attributes != nil) {
-        return attributes;
-    }
-
     // avoid OOB errors
     const NSInteger section = indexPath.section;
-    if (section >= (ssize_t)_sectionData.size()) {
+    if (section >= (ssize_t)_sectionData.size()
+        || section >= (ssize_t)_sectionAttributes.size()) {
         return nil;
     }
 
+    IGListAttributesSlot *slot = nullptr;
+    if ([elementKind isEqualToString:UICollectionElementKindSectionHeader]) {
+        slot = &_sectionAttributes[section].header;
+    } else if ([elementKind isEqualToString:UICollectionElementKindSectionFooter]) {
+        slot = &_sectionAttributes[section].footer;
+    }
+    if (slot != nullptr && slot->attributes != nil && slot->generation == _supplementaryAttributesGeneration) {
+        return slot->attributes;
+    }
+
     UICollectionView *collectionView = self.collectionView;
-    const IGListSectionEntry entry = _sectionData[section];
+    const IGListSectionEntry &entry = _sectionData[section];
     const CGFloat minOffset = CGRectGetMinInDirection(entry.bounds, self.scrollDirection);
 
     CGRect frame = CGRectZero;
@@ -335,7 +399,7 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
         frame = entry.headerBounds;
 
         if (self.stickyHeaders) {
-            CGFloat offset = CGPointGetCoordinateInDirection(collectionView.contentOffset, self.scrollDirection) + self.topContentInset + self.stickyHeaderYOffset;
+            CGFloat offset = [self _stickyHeaderOffsetForBounds:collectionView.bounds];
 
             if (section + 1 == (ssize_t)_sectionData.size()) {
                 offset = MAX(minOffset, offset);
@@ -364,10 +428,15 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
         // which could then crash if the UICollectionViewDelegate is not expecting to actually return a supplimentary view.
         return nil;
     } else {
-        attributes = [UICollectionViewLayoutAttributes layoutAttributesForSupplementaryViewOfKind:elementKind withIndexPath:indexPath];
+        // only headers and footers get a non-empty frame, so there is always a slot here
+        // recycle the attributes built for this section before the last invalidation
+        if (slot->attributes == nil) {
+            slot->attributes = [UICollectionViewLayoutAttributes layoutAttributesForSupplementaryViewOfKind:elementKind withIndexPath:indexPath];
+        }
+        UICollectionViewLayoutAttributes *attributes = slot->attributes;
         attributes.frame = frame;
         adjustZIndexForAttributes(attributes);
-        _supplementaryAttributesCache[elementKind][indexPath] = attributes;
+        slot->generation = _supplementaryAttributesGeneration;
         return attributes;
     }
 }
@@ -381,7 +450,7 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
         return CGSizeZero;
     }
 
-    const IGListSectionEntry section = _sectionData[sectionCount - 1];
+    const IGListSectionEntry &section = _sectionData[sectionCount - 1];
     UICollectionView *collectionView = self.collectionView;
     const UIEdgeInsets contentInset = collectionView.ig_contentInset;
     switch (self.scrollDirection) {
@@ -399,26 +468,46 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
 - (void)invalidateLayout {
     if (!_preserveLayoutCacheOnInvalidateLayout) {
         _minimumInvalidatedSection = 0;
+        _minimumInvalidatedItem = 0;
+        _reusableSectionInputs.clear();
     }
     [super invalidateLayout];
 }
 
 - (void)invalidateLayoutWithContext:(IGListCollectionViewLayoutInvalidationContext *)context {
-    BOOL hasInvalidatedItemIndexPaths = NO;
-    if ([context respondsToSelector:@selector(invalidatedItemIndexPaths)]) {
-        hasInvalidatedItemIndexPaths = [context invalidatedItemIndexPaths].count > 0;
+    // if count changed and we don't have information on the minimum invalidated section
+    const BOOL countsChangedAnywhere = [context invalidateDataSourceCounts] && _minimumInvalidatedSection == NSNotFound;
+
+    // invalidated items only changed size or moved interactively, the rows before the first of them are kept
+    if ([context respondsToSelector:@selector(invalidatedItemIndexPaths)] && [context invalidatedItemIndexPaths].count > 0) {
+        for (NSArray<NSIndexPath *> *indexPaths in @[[context invalidatedItemIndexPaths],
+                                                     context.previousIndexPathsForInteractivelyMovingItems ?: @[],
+                                                     context.targetIndexPathsForInteractivelyMovingItems ?: @[]]) {
+            for (NSIndexPath *indexPath in indexPaths) {
+                [self _invalidateFromItem:indexPath.item inSection:indexPath.section];
+            }
+        }
+        _reusableSectionInputs.clear();
     }
 
-    if (hasInvalidatedItemIndexPaths
-        || [context invalidateEverything]
-        || ([context invalidateDataSourceCounts] && _minimumInvalidatedSection == NSNotFound) // if count changed and we don't have information on the minimum invalidated section
+    if ([context invalidateEverything]
+        || countsChangedAnywhere
         || context.invalidateAllListAttributes) {
         // invalidates all
         _minimumInvalidatedSection = 0;
+        _minimumInvalidatedItem = 0;
+        _reusableSectionInputs.clear();
     }
 
     if (context.invalidateSupplementaryListAttributes) {
         [self _resetSupplementaryAttributesCache];
+    } else {
+        // sticky headers moved by scrolling, every other supplementary view keeps its attributes
+        for (NSIndexPath *indexPath in context.invalidatedSupplementaryIndexPaths[UICollectionElementKindSectionHeader]) {
+            if (indexPath.section < (NSInteger)_sectionAttributes.size()) {
+                _sectionAttributes[indexPath.section].header.generation = 0;
+            }
+        }
     }
 
     [super invalidateLayoutWithContext:context];
@@ -433,9 +522,24 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
 
     IGListCollectionViewLayoutInvalidationContext *context =
     (IGListCollectionViewLayoutInvalidationContext *)[super invalidationContextForBoundsChange:newBounds];
-    context.invalidateSupplementaryListAttributes = YES;
     if (!CGSizeEqualToSize(oldBounds.size, newBounds.size)) {
+        context.invalidateSupplementaryListAttributes = YES;
         context.invalidateAllListAttributes = YES;
+    } else if (self.stickyHeaders && _minimumInvalidatedSection == NSNotFound) {
+        if (_sectionData.empty()) {
+            return context;
+        }
+        // only the headers that can be pinned somewhere between the old and the new offset move
+        const CGFloat oldOffset = [self _stickyHeaderOffsetForBounds:oldBounds];
+        const CGFloat newOffset = [self _stickyHeaderOffsetForBounds:newBounds];
+        const NSRange sections = [self _stickyHeaderSectionsBetweenOffset:MIN(oldOffset, newOffset) andOffset:MAX(oldOffset, newOffset)];
+        NSMutableArray<NSIndexPath *> *indexPaths = [NSMutableArray arrayWithCapacity:sections.length];
+        for (NSInteger section = sections.location; section < (NSInteger)NSMaxRange(sections); section++) {
+            [indexPaths addObject:indexPathForSection(section)];
+        }
+        [context invalidateSupplementaryElementsOfKind:UICollectionElementKindSectionHeader atIndexPaths:indexPaths];
+    } else {
+        context.invalidateSupplementaryListAttributes = YES;
     }
     return context;
 }
@@ -474,6 +578,35 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
     }
 }
 
+- (void)setUsesCompactFrameStorage:(BOOL)usesCompactFrameStorage {
+    IGAssertMainThread();
+
+    if (_usesCompactFrameStorage != usesCompactFrameStorage) {
+        _usesCompactFrameStorage = usesCompactFrameStorage;
+
+        // switching modes drops the cached frames, so every section has to be rebuilt
+        _itemFrames.setCompact(usesCompactFrameStorage);
+        _minimumInvalidatedSection = 0;
+        _minimumInvalidatedItem = 0;
+        [self invalidateLayout];
+    }
+}
+
+- (void)setUsesBatchUpdateRemapping:(BOOL)usesBatchUpdateRemapping {
+    IGAssertMainThread();
+
+    if (_usesBatchUpdateRemapping != usesBatchUpdateRemapping) {
+        _usesBatchUpdateRemapping = usesBatchUpdateRemapping;
+
+        // the inputs are only recorded while enabled, so every section has to be measured once more
+        _sectionInputs.clear();
+        _reusableSectionInputs.clear();
+        _minimumInvalidatedSection = 0;
+        _minimumInvalidatedItem = 0;
+        [self invalidateLayout];
+    }
+}
+
 #pragma mark - Private API
 
 - (NSString *)_classNameForDelegate:(id<UICollectionViewDelegateFlowLayout>)delegate sectionIndex:(NSInteger)section {
@@ -493,204 +626,294 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
     return NSStringFromClass([sectionController class]);
 }
 
+/**
+ Gathers the input of `section` and adds its frames to the frame storage. When `firstItem` is not 0, the frames of the
+ section are the last ones in the storage and only the sizes of the items from `firstItem` on are gathered, unless the
+ section changed in a way that moves its first rows.
+
+ @return The first item whose size was gathered, 0 when the section has to be laid out from its first item.
+ */
+- (NSInteger)_gatherLayoutInput:(IGListSectionLayoutInput &)input
+                     forSection:(NSInteger)section
+                       fromItem:(NSInteger)firstItem
+     contentInsetAdjustedBounds:(CGRect)contentInsetAdjustedCollectionViewBounds {
+    UICollectionView *collectionView = self.collectionView;
+    id<UICollectionViewDelegateFlowLayout> delegate = (id<UICollectionViewDelegateFlowLayout>)collectionView.delegate;
+    IGListSectionEntry &entry = _sectionData[section];
+
+    const NSInteger itemCount = [collectionView numberOfItemsInSection:section];
+
+    // a section untouched by the last batch update already holds its input, unless the data source disagrees
+    if (section < (NSInteger)_reusableSectionInputs.size()
+        && _reusableSectionInputs[section]
+        && (NSInteger)input.itemSizes.size() == itemCount) {
+        _itemFrames.truncateToSection(section);
+        _itemFrames.appendSection(itemCount);
+        _sectionAttributes[section].items.resize(itemCount);
+        entry.insets = UIEdgeInsetsMake(input.insets.top, input.insets.left, input.insets.bottom, input.insets.right);
+        entry.headerSize = CGSizeMake(input.headerSize.width, input.headerSize.height);
+        entry.footerSize = CGSizeMake(input.footerSize.width, input.footerSize.height);
+        entry.lineSpacing = input.lineSpacing;
+        entry.interitemSpacing = input.interitemSpacing;
+        entry.columnCount = input.columnCount;
+        return 0;
+    }
+
+    const CGSize headerSize = [delegate collectionView:collectionView layout:self referenceSizeForHeaderInSection:section];
+    const CGSize footerSize = [delegate collectionView:collectionView layout:self referenceSizeForFooterInSection:section];
+    const UIEdgeInsets insets = [delegate collectionView:collectionView layout:self insetForSectionAtIndex:section];
+    input.headerSize = {headerSize.width, headerSize.height};
+    input.footerSize = {footerSize.width, footerSize.height};
+    input.insets = {insets.top, insets.left, insets.bottom, insets.right};
+    input.lineSpacing = [delegate collectionView:collectionView layout:self minimumLineSpacingForSectionAtIndex:section];
+    input.interitemSpacing = [delegate collectionView:collectionView layout:self minimumInteritemSpacingForSectionAtIndex:section];
+    const NSInteger columnCount = [delegate respondsToSelector:@selector(collectionView:layout:numberOfColumnsInSection:)]
+    ? [(id<IGListCollectionViewDelegateLayout>)delegate collectionView:collectionView layout:self numberOfColumnsInSection:section]
+    : 0;
+    IGAssert(columnCount >= 0, @"Number of columns of section %li must not be negative. Delegate class: %@", (long)section, [self _classNameForDelegate:delegate sectionIndex:section]);
+    input.columnCount = (size_t)MAX(columnCount, 0);
+
+    // the kept rows were laid out with the previous header, insets and spacings of the section
+    if (firstItem > 0
+        && (!CGSizeEqualToSize(entry.headerSize, headerSize)
+            || !CGSizeEqualToSize(entry.footerSize, footerSize)
+            || !UIEdgeInsetsEqualToEdgeInsets(entry.insets, insets)
+            || entry.lineSpacing != input.lineSpacing
+            || entry.interitemSpacing != input.interitemSpacing
+            || entry.columnCount != (NSInteger)input.columnCount)) {
+        firstItem = 0;
+    }
+    entry.insets = insets;
+    entry.headerSize = headerSize;
+    entry.footerSize = footerSize;
+    entry.lineSpacing = input.lineSpacing;
+    entry.interitemSpacing = input.interitemSpacing;
+    entry.columnCount = input.columnCount;
+
+    if (firstItem > 0) {
+        _itemFrames.resizeLastSection(itemCount);
+    } else {
+        _itemFrames.truncateToSection(section);
+        _itemFrames.appendSection(itemCount);
+    }
+    // keeps the existing attributes objects around so they can be recycled
+    _sectionAttributes[section].items.resize(itemCount);
+
+    const CGSize paddedCollectionViewSize = UIEdgeInsetsInsetRect(contentInsetAdjustedCollectionViewBounds, insets).size;
+    const UICollectionViewScrollDirection fixedDirection = self.scrollDirection == UICollectionViewScrollDirectionHorizontal ? UICollectionViewScrollDirectionVertical : UICollectionViewScrollDirectionHorizontal;
+    const CGFloat paddedLengthInFixedDirection = CGSizeGetLengthInDirection(paddedCollectionViewSize, fixedDirection);
+
+    // prefer sizing the whole section in one call, e.g. a section controller conforming to IGListBatchSizing
+    _batchItemSizes.resize(itemCount - firstItem);
+    const BOOL hasBatchSizes = itemCount > firstItem
+    && [delegate respondsToSelector:@selector(collectionView:layout:getSizes:forItemsInRange:inSection:)]
+    && [(id<IGListCollectionViewDelegateLayout>)delegate collectionView:collectionView
+                                                                 layout:self
+                                                               getSizes:_batchItemSizes.data()
+                                                        forItemsInRange:NSMakeRange(firstItem, itemCount - firstItem)
+                                                              inSection:section];
+
+    input.itemSizes.resize(itemCount);
+    for (NSInteger item = firstItem; item < itemCount; item++) {
+        // Following method subsequentally calls -layoutAttributesForItemAtIndexPath: and caches attributes that are not ready yet (we only calculate them at the end of -_calculateLayoutIfNeeded)
+        // This results in the attributes for indexPath being cached with an incorrect value. If we end up calling prepareLayout in response to frame change we
+        const CGSize size = hasBatchSizes
+        ? _batchItemSizes[item - firstItem]
+        : [delegate collectionView:collectionView layout:self sizeForItemAtIndexPath:[NSIndexPath indexPathForItem:item inSection:section]];
+
+        IGAssert(CGSizeGetLengthInDirection(size, fixedDirection) <= paddedLengthInFixedDirection
+                 || fabs(CGSizeGetLengthInDirection(size, fixedDirection) - paddedLengthInFixedDirection) < FLT_EPSILON,
+                 @"%@ of item %li in section %li (%.0f pt) must be less than or equal to container (%.0f pt) accounting for section insets %@. Delegate class: %@",
+                 self.scrollDirection == UICollectionViewScrollDirectionVertical ? @"Width" : @"Height",
+                 (long)item,
+                 (long)section,
+                 CGSizeGetLengthInDirection(size, fixedDirection),
+                 CGRectGetLengthInDirection(contentInsetAdjustedCollectionViewBounds, fixedDirection),
+                 NSStringFromUIEdgeInsets(insets),
+                 [self _classNameForDelegate:delegate sectionIndex:section]);
+
+        input.itemSizes[item] = {size.width, size.height};
+    }
+    return firstItem;
+}
+
+- (void)_applyLayoutResult:(const IGListSectionLayoutResult &)result toSection:(NSInteger)section {
+    IGListSectionEntry &entry = _sectionData[section];
+    entry.bounds = CGRectFromIGListLayoutRect(result.bounds);
+    entry.headerBounds = CGRectFromIGListLayoutRect(result.headerBounds);
+    entry.footerBounds = CGRectFromIGListLayoutRect(result.footerBounds);
+    entry.lastItemCoordInScrollDirection = result.lastItemCoordInScrollDirection;
+    entry.lastItemCoordInFixedDirection = result.lastItemCoordInFixedDirection;
+    entry.lastNextRowCoordInScrollDirection = result.lastNextRowCoordInScrollDirection;
+}
+
 - (void)_calculateLayoutIfNeeded {
     if (_minimumInvalidatedSection == NSNotFound) {
         return;
     }
 
     UICollectionView *collectionView = self.collectionView;
-    id<UICollectionViewDelegateFlowLayout> delegate = (id<UICollectionViewDelegateFlowLayout>)collectionView.delegate;
 
     const NSInteger sectionCount = [collectionView numberOfSections];
     const UIEdgeInsets contentInset = collectionView.ig_contentInset;
     const CGRect contentInsetAdjustedCollectionViewBounds = UIEdgeInsetsInsetRect(collectionView.bounds, contentInset);
 
     _sectionData.resize(sectionCount);
+    _sectionAttributes.resize(sectionCount);
 
-    CGFloat itemCoordInScrollDirection = 0.0;
-    CGFloat itemCoordInFixedDirection = 0.0;
-    CGFloat nextRowCoordInScrollDirection = 0.0;
+    const BOOL remapsInputs = self.usesBatchUpdateRemapping;
+    if (remapsInputs) {
+        _sectionInputs.resize(sectionCount);
+    }
+    if ((NSInteger)_reusableSectionInputs.size() != sectionCount) {
+        // the collection view did not end up with the sections the batch update described
+        _reusableSectionInputs.clear();
+    }
 
-    // union item frames and optionally the header to find a bounding box of the entire section
-    CGRect rollingSectionBounds = CGRectZero;
+    // frames of the sections before this one are still valid, everything after it is rebuilt in place
+    const NSInteger firstInvalidSection = MIN(MIN(_minimumInvalidatedSection, (NSInteger)_itemFrames.sectionCount()), sectionCount);
+
+    // a section invalidated from one of its items keeps its frames up to the row of that item
+    const BOOL concurrent = self.usesConcurrentSectionLayout;
+    IGListSectionRowCursor resumeCursor = IGListSectionRowCursor();
+    size_t keptRowCursorCount = 0;
+    if (!concurrent
+        && firstInvalidSection == _minimumInvalidatedSection
+        && _minimumInvalidatedItem > 0
+        && firstInvalidSection + 1 < (NSInteger)_rowCursorOffsets.size()) {
+        const NSInteger itemCount = [collectionView numberOfItemsInSection:firstInvalidSection];
+        const auto rowsBegin = _rowCursors.begin() + _rowCursorOffsets[firstInvalidSection];
+        const auto rowsEnd = _rowCursors.begin() + _rowCursorOffsets[firstInvalidSection + 1];
+        if (itemCount >= kIGListRowCursorMinimumItemCount && rowsBegin != rowsEnd) {
+            const size_t firstChangedItem = MIN(_minimumInvalidatedItem, itemCount - 1);
+            const auto row = std::upper_bound(rowsBegin, rowsEnd, firstChangedItem, [](size_t item, const IGListSectionRowCursor &cursor) {
+                return item < cursor.firstItem;
+            }) - 1;
+            resumeCursor = *row;
+            keptRowCursorCount = row - rowsBegin;
+        }
+    }
+    const BOOL resumes = resumeCursor.firstItem > 0;
+    _itemFrames.truncateToSection(resumes ? firstInvalidSection + 1 : firstInvalidSection);
+    _rowCursorOffsets.resize(firstInvalidSection + 1);
+    _rowCursors.resize(_rowCursorOffsets.back() + keptRowCursorCount);
+
+    IGListLayoutEnvironment environment;
+    environment.vertical = self.scrollDirection == UICollectionViewScrollDirectionVertical;
+    environment.containerWidth = contentInsetAdjustedCollectionViewBounds.size.width;
+    environment.containerHeight = contentInsetAdjustedCollectionViewBounds.size.height;
+    environment.scale = [[UIScreen mainScreen] scale];
+    environment.stretchToEdge = self.stretchToEdge;
+    environment.showHeaderWhenEmpty = self.showHeaderWhenEmpty;
 
     // populate last valid section information
-    const NSInteger lastValidSection = _minimumInvalidatedSection - 1;
+    IGListSectionLayoutResult previous = IGListSectionLayoutResult();
+    const NSInteger lastValidSection = firstInvalidSection - 1;
     if (lastValidSection >= 0 && lastValidSection < sectionCount) {
-        itemCoordInScrollDirection = _sectionData[lastValidSection].lastItemCoordInScrollDirection;
-        itemCoordInFixedDirection = _sectionData[lastValidSection].lastItemCoordInFixedDirection;
-        nextRowCoordInScrollDirection = _sectionData[lastValidSection].lastNextRowCoordInScrollDirection;
-        rollingSectionBounds = _sectionData[lastValidSection].bounds;
-    }
-
-    for (NSInteger section = _minimumInvalidatedSection; section < sectionCount; section++) {
-        const NSInteger itemCount = [collectionView numberOfItemsInSection:section];
-        const BOOL itemsEmpty = itemCount == 0;
-        const BOOL hideHeaderWhenItemsEmpty = itemsEmpty && !self.showHeaderWhenEmpty;
-        _sectionData[section].itemBounds = std::vector<CGRect>(itemCount);
-
-        const CGSize headerSize = [delegate collectionView:collectionView layout:self referenceSizeForHeaderInSection:section];
-        const CGSize footerSize = [delegate collectionView:collectionView layout:self referenceSizeForFooterInSection:section];
-        const UIEdgeInsets insets = [delegate collectionView:collectionView layout:self insetForSectionAtIndex:section];
-        const CGFloat lineSpacing = [delegate collectionView:collectionView layout:self minimumLineSpacingForSectionAtIndex:section];
-        const CGFloat interitemSpacing = [delegate collectionView:collectionView layout:self minimumInteritemSpacingForSectionAtIndex:section];
-
-        const CGSize paddedCollectionViewSize = UIEdgeInsetsInsetRect(contentInsetAdjustedCollectionViewBounds, insets).size;
-        const UICollectionViewScrollDirection fixedDirection = self.scrollDirection == UICollectionViewScrollDirectionHorizontal ? UICollectionViewScrollDirectionVertical : UICollectionViewScrollDirectionHorizontal;
-        const CGFloat paddedLengthInFixedDirection = CGSizeGetLengthInDirection(paddedCollectionViewSize, fixedDirection);
-        const CGFloat headerLengthInScrollDirection = hideHeaderWhenItemsEmpty ? 0 : CGSizeGetLengthInDirection(headerSize, self.scrollDirection);
-        const CGFloat footerLengthInScrollDirection = hideHeaderWhenItemsEmpty ? 0 : CGSizeGetLengthInDirection(footerSize, self.scrollDirection);
-        const BOOL headerExists = headerLengthInScrollDirection > 0;
-        const BOOL footerExists = footerLengthInScrollDirection > 0;
-
-        // start the section accounting for the header size
-        // header length in scroll direction is subtracted from the sectionBounds when calculating the header bounds after items are done
-        // this bumps the first row of items over enough to make room for the header
-        itemCoordInScrollDirection += headerLengthInScrollDirection;
-        nextRowCoordInScrollDirection += headerLengthInScrollDirection;
-
-        // add the leading inset in fixed direction in case the section falls on the same row as the previous
-        // if the section is newlined then the coord in fixed direction is reset
-        itemCoordInFixedDirection += UIEdgeInsetsLeadingInsetInDirection(insets, fixedDirection);
-
-        // the farthest in the fixed direction the frame of an item in this section can go
-        const CGFloat maxCoordinateInFixedDirection = CGRectGetLengthInDirection(contentInsetAdjustedCollectionViewBounds, fixedDirection) - UIEdgeInsetsTrailingInsetInDirection(insets, fixedDirection);
-
-        for (NSInteger item = 0; item < itemCount; item++) {
-            NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
-            // Following method subsequentally calls -layoutAttributesForItemAtIndexPath: and caches attributes that are not ready yet (we only calculate them at the end of this for loop)
-            // This results in _attributesCache[indexPath] being set to incorrect value. If we end up calling prepareLayout in response to frame change we
-            const CGSize size = [delegate collectionView:collectionView layout:self sizeForItemAtIndexPath:indexPath];
-
-            IGAssert(CGSizeGetLengthInDirection(size, fixedDirection) <= paddedLengthInFixedDirection
-                     || fabs(CGSizeGetLengthInDirection(size, fixedDirection) - paddedLengthInFixedDirection) < FLT_EPSILON,
-                     @"%@ of item %li in section %li (%.0f pt) must be less than or equal to container (%.0f pt) accounting for section insets %@. Delegate class: %@",
-                     self.scrollDirection == UICollectionViewScrollDirectionVertical ? @"Width" : @"Height",
-                     (long)item,
-                     (long)section,
-                     CGSizeGetLengthInDirection(size, fixedDirection),
-                     CGRectGetLengthInDirection(contentInsetAdjustedCollectionViewBounds, fixedDirection),
-                     NSStringFromUIEdgeInsets(insets),
-                     [self _classNameForDelegate:delegate sectionIndex:section]);
-
-            CGFloat itemLengthInFixedDirection = MIN(CGSizeGetLengthInDirection(size, fixedDirection), paddedLengthInFixedDirection);
-
-            // if the origin and length in fixed direction of the item busts the size of the container
-            // or if this is the first item and the header has a non-zero size
-            // newline to the next row and reset
-            // define epsilon to avoid float overflow issue
-            const CGFloat epsilon = 1.0;
-            if (itemCoordInFixedDirection + itemLengthInFixedDirection > maxCoordinateInFixedDirection + epsilon
-                || (item == 0 && headerExists)) {
-                itemCoordInScrollDirection = nextRowCoordInScrollDirection;
-                itemCoordInFixedDirection = UIEdgeInsetsLeadingInsetInDirection(insets, fixedDirection);
-
-
-                // if newlining, always append line spacing unless its the very first item of the section
-                if (item > 0) {
-                    itemCoordInScrollDirection += lineSpacing;
-                }
-            }
+        const IGListSectionEntry &entry = _sectionData[lastValidSection];
+        previous.bounds = IGListLayoutRectFromCGRect(entry.bounds);
+        previous.lastItemCoordInScrollDirection = entry.lastItemCoordInScrollDirection;
+        previous.lastItemCoordInFixedDirection = entry.lastItemCoordInFixedDirection;
+        previous.lastNextRowCoordInScrollDirection = entry.lastNextRowCoordInScrollDirection;
+    }
 
-            const CGFloat distanceToEdge = paddedLengthInFixedDirection - (itemCoordInFixedDirection + itemLengthInFixedDirection);
-            if (self.stretchToEdge && distanceToEdge > 0 && distanceToEdge <= epsilon) {
-                itemLengthInFixedDirection = paddedLengthInFixedDirection - itemCoordInFixedDirection;
+    NSInteger firstRebuiltItem = 0;
+    if (concurrent) {
+        // sizes come from the delegate, so they are all gathered on the main thread before any section is laid out
+        std::vector<IGListSectionLayoutInput> inputs(sectionCount - firstInvalidSection);
+        NSInteger itemCount = 0;
+        for (NSInteger section = firstInvalidSection; section < sectionCount; section++) {
+            IGListSectionLayoutInput &input = inputs[section - firstInvalidSection];
+            if (remapsInputs) {
+                // borrowed for the pass and handed back below, swapping only moves the item size buffers
+                std::swap(input, _sectionInputs[section]);
             }
+            [self _gatherLayoutInput:input forSection:section fromItem:0 contentInsetAdjustedBounds:contentInsetAdjustedCollectionViewBounds];
+            itemCount += (NSInteger)input.itemSizes.size();
+        }
 
-            const CGRect rawFrame = (self.scrollDirection == UICollectionViewScrollDirectionVertical) ?
-            CGRectMake(itemCoordInFixedDirection,
-                       itemCoordInScrollDirection + insets.top,
-                       itemLengthInFixedDirection,
-                       size.height) :
-            CGRectMake(itemCoordInScrollDirection + insets.left,
-                       itemCoordInFixedDirection,
-                       size.width,
-                       itemLengthInFixedDirection);
-            const CGRect frame = IGListRectIntegralScaled(rawFrame);
-
-            _sectionData[section].itemBounds[item] = frame;
-
-            // track the max size of the row to find the coord of the next row, adjust for leading inset while iterating items
-            nextRowCoordInScrollDirection = MAX(CGRectGetMaxInDirection(frame, self.scrollDirection) - UIEdgeInsetsLeadingInsetInDirection(insets, self.scrollDirection), nextRowCoordInScrollDirection);
-
-            // increase the rolling coord in fixed direction appropriately and add item spacing for all items on the same row
-            itemCoordInFixedDirection += itemLengthInFixedDirection + interitemSpacing;
-
-            // union the rolling section bounds
-            if (item == 0) {
-                rollingSectionBounds = frame;
+        const BOOL dispatches = itemCount >= kIGListConcurrentSectionLayoutMinimumItemCount;
+        std::vector<IGListSectionLayoutResult> results;
+        IGListLayoutSectionsConcurrently(inputs, firstInvalidSection, environment, previous, _itemFrames, results, [dispatches](size_t count, const std::function<void(size_t)> &body) {
+            if (dispatches) {
+                dispatch_apply(count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t index) {
+                    body(index);
+                });
             } else {
-                rollingSectionBounds = CGRectUnion(rollingSectionBounds, frame);
+                for (size_t index = 0; index < count; index++) {
+                    body(index);
+                }
+            }
+        });
+
+        for (NSInteger section = firstInvalidSection; section < sectionCount; section++) {
+            [self _applyLayoutResult:results[section - firstInvalidSection] toSection:section];
+            // rows are only recorded by the serial pass
+            _rowCursorOffsets.push_back(_rowCursors.size());
+            if (remapsInputs) {
+                std::swap(inputs[section - firstInvalidSection], _sectionInputs[section]);
             }
         }
-
-        const CGRect headerBounds = self.scrollDirection == UICollectionViewScrollDirectionVertical ?
-        CGRectMake(insets.left,
-                   itemsEmpty ? CGRectGetMaxY(rollingSectionBounds) : CGRectGetMinY(rollingSectionBounds) - headerSize.height,
-                   paddedLengthInFixedDirection,
-                   hideHeaderWhenItemsEmpty ? 0 : headerSize.height) :
-        CGRectMake(itemsEmpty ? CGRectGetMaxX(rollingSectionBounds) : CGRectGetMinX(rollingSectionBounds) - headerSize.width,
-                   insets.top,
-                   hideHeaderWhenItemsEmpty ? 0 : headerSize.width,
-                   paddedLengthInFixedDirection);
-
-        _sectionData[section].headerBounds = headerBounds;
-
-        if (itemsEmpty) {
-            rollingSectionBounds = headerBounds;
+    } else {
+        IGListSectionLayoutInput scratchInput;
+        for (NSInteger section = firstInvalidSection; section < sectionCount; section++) {
+            IGListSectionLayoutInput &input = remapsInputs ? _sectionInputs[section] : scratchInput;
+            const NSInteger firstItem = [self _gatherLayoutInput:input
+                                                      forSection:section
+                                                        fromItem:section == firstInvalidSection ? resumeCursor.firstItem : 0
+                                      contentInsetAdjustedBounds:contentInsetAdjustedCollectionViewBounds];
+            if (firstItem == 0) {
+                _rowCursors.resize(_rowCursorOffsets.back());
+            } else {
+                firstRebuiltItem = firstItem;
+            }
+            std::vector<IGListSectionRowCursor> *rows = (NSInteger)input.itemSizes.size() >= kIGListRowCursorMinimumItemCount ? &_rowCursors : nullptr;
+            previous = IGListLayoutSection(input, section, environment, previous, _itemFrames, rows, firstItem > 0 ? &resumeCursor : nullptr);
+            _rowCursorOffsets.push_back(_rowCursors.size());
+            [self _applyLayoutResult:previous toSection:section];
         }
+    }
 
-        const CGRect footerBounds = (self.scrollDirection == UICollectionViewScrollDirectionVertical) ?
-        CGRectMake(insets.left,
-                   CGRectGetMaxY(rollingSectionBounds),
-                   paddedLengthInFixedDirection,
-                   hideHeaderWhenItemsEmpty ? 0 : footerSize.height) :
-        CGRectMake(CGRectGetMaxX(rollingSectionBounds) + insets.right,
-                   insets.top,
-                   hideHeaderWhenItemsEmpty ? 0 : footerSize.width,
-                   paddedLengthInFixedDirection);
-
-        _sectionData[section].footerBounds = footerBounds;
-
-        // union the header before setting the bounds of the section
-        // only do this when the header has a size, otherwise the union stretches to box empty space
-        if (headerExists) {
-            rollingSectionBounds = CGRectUnion(rollingSectionBounds, headerBounds);
+    // index the rebuilt sections and cells for -layoutAttributesForElementsInRect:
+    const UICollectionViewScrollDirection scrollDirection = self.scrollDirection;
+    _sectionSpans.truncate(firstInvalidSection);
+    _itemSpans.truncate(_itemFrames.firstItemIndex(firstInvalidSection) + firstRebuiltItem);
+    if (_firstUnorderedSection >= firstInvalidSection) {
+        _firstUnorderedSection = NSNotFound;
+    }
+    for (NSInteger section = firstInvalidSection; section < sectionCount; section++) {
+        const CGRect bounds = _sectionData[section].bounds;
+        if (_firstUnorderedSection == NSNotFound
+            && section > 0
+            && CGRectGetMinInDirection(bounds, scrollDirection) < CGRectGetMinInDirection(_sectionData[section - 1].bounds, scrollDirection)) {
+            _firstUnorderedSection = section;
         }
-        if (footerExists) {
-            rollingSectionBounds = CGRectUnion(rollingSectionBounds, footerBounds);
+        _sectionSpans.append(CGRectGetMinInDirection(bounds, scrollDirection), CGRectGetMaxInDirection(bounds, scrollDirection));
+        const NSInteger itemCount = _itemFrames.itemCount(section);
+        for (NSInteger item = section == firstInvalidSection ? firstRebuiltItem : 0; item < itemCount; item++) {
+            const CGRect frame = CGRectFromIGListLayoutRect(_itemFrames.frame(section, item));
+            _itemSpans.append(CGRectGetMinInDirection(frame, scrollDirection), CGRectGetMaxInDirection(frame, scrollDirection));
         }
-
-        _sectionData[section].bounds = rollingSectionBounds;
-        _sectionData[section].insets = insets;
-
-        // bump the coord for the next section with the right insets
-        itemCoordInFixedDirection += UIEdgeInsetsTrailingInsetInDirection(insets, fixedDirection);
-
-        // find the farthest point in the section and add the trailing inset to find the next row's coord
-        nextRowCoordInScrollDirection = MAX(nextRowCoordInScrollDirection, CGRectGetMaxInDirection(rollingSectionBounds, self.scrollDirection) + UIEdgeInsetsTrailingInsetInDirection(insets, self.scrollDirection));
-
-        // keep track of coordinates for partial invalidation
-        _sectionData[section].lastItemCoordInScrollDirection = itemCoordInScrollDirection;
-        _sectionData[section].lastItemCoordInFixedDirection = itemCoordInFixedDirection;
-        _sectionData[section].lastNextRowCoordInScrollDirection = nextRowCoordInScrollDirection;
     }
 
-    // Reason we are purging attributes at the end is because in some circumstances calling
+    // Reason we are invalidating attributes at the end is because in some circumstances calling
     // -[delegate collectionView: layout: sizeForItemAtIndexPath:] results in creating the cache with incorrect values
     // See the comment next to the call for more information
-    [_attributesCache removeAllObjects];
+    _itemAttributesGeneration++;
     [self _resetSupplementaryAttributesCache];
 
     _minimumInvalidatedSection = NSNotFound;
+    _minimumInvalidatedItem = 0;
+    _reusableSectionInputs.clear();
 }
 
 - (NSRange)_rangeOfSectionsInRect:(CGRect)rect {
     NSRange result = NSMakeRange(NSNotFound, 0);
 
-    const NSInteger sectionCount = _sectionData.size();
-    for (NSInteger section = 0; section < sectionCount; section++) {
-        IGListSectionEntry entry = _sectionData[section];
+    const UICollectionViewScrollDirection scrollDirection = self.scrollDirection;
+    _sectionSpans.find(CGRectGetMinInDirection(rect, scrollDirection), CGRectGetMaxInDirection(rect, scrollDirection), _sectionSpansHint);
+    for (NSInteger section = _sectionSpansHint.first; section < (NSInteger)_sectionSpansHint.last; section++) {
+        const IGListSectionEntry &entry = _sectionData[section];
         if (entry.isValid() && CGRectIntersectsRect(entry.bounds, rect)) {
             const NSRange sectionRange = NSMakeRange(section, 1);
             if (result.location == NSNotFound) {
@@ -704,16 +927,175 @@ static void adjustZIndexForAttributes(UICollectionViewLayoutAttributes *attribut
     return result;
 }
 
+- (CGFloat)_stickyHeaderOffsetForBounds:(CGRect)bounds {
+    return CGPointGetCoordinateInDirection(bounds.origin, self.scrollDirection) + self.topContentInset + self.stickyHeaderYOffset;
+}
+
+/**
+ Returns the sections whose sticky header can move while the offset goes from `minOffset` to `maxOffset`: every section
+ starting at or before `maxOffset` whose next section starts after `minOffset`.
+ */
+- (NSRange)_stickyHeaderSectionsBetweenOffset:(CGFloat)minOffset andOffset:(CGFloat)maxOffset {
+    IGAssert(!_sectionData.empty(), @"Expected at least one section");
+    const UICollectionViewScrollDirection direction = self.scrollDirection;
+
+    if (_firstUnorderedSection != NSNotFound) {
+        // insets can move a section before the previous one, so the binary search doesn't hold
+        const NSInteger sectionCount = _sectionData.size();
+        NSInteger firstSection = NSNotFound;
+        NSInteger lastSection = 0;
+        for (NSInteger section = 0; section < sectionCount; section++) {
+            const CGFloat sectionMin = CGRectGetMinInDirection(_sectionData[section].bounds, direction);
+            const CGFloat nextSectionMin = section + 1 < sectionCount ? CGRectGetMinInDirection(_sectionData[section + 1].bounds, direction) : CGFLOAT_MAX;
+            if (sectionMin <= maxOffset && nextSectionMin > minOffset) {
+                firstSection = MIN(firstSection, section);
+                lastSection = section;
+            }
+        }
+        return firstSection == NSNotFound ? NSMakeRange(0, 0) : NSMakeRange(firstSection, lastSection - firstSection + 1);
+    }
+
+    // sections start in order in the scroll direction, so the range runs from the last section starting at or before
+    // each offset
+    const auto lastSectionStartingBefore = [&](CGFloat offset) {
+        const auto next = std::upper_bound(_sectionData.begin(), _sectionData.end(), offset, [direction](CGFloat value, const IGListSectionEntry &entry) {
+            return value < CGRectGetMinInDirection(entry.bounds, direction);
+        });
+        // before the first section its header is at rest, but invalidating it is harmless
+        return std::max<NSInteger>(next - _sectionData.begin() - 1, 0);
+    };
+    const NSInteger firstSection = lastSectionStartingBefore(minOffset);
+    return NSMakeRange(firstSection, lastSectionStartingBefore(maxOffset) - firstSection + 1);
+}
+
 - (void)_resetSupplementaryAttributesCache {
-    [_supplementaryAttributesCache enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, NSMutableDictionary<NSIndexPath *,UICollectionViewLayoutAttributes *> * _Nonnull attributesCache, BOOL * _Nonnull stop) {
-        [attributesCache removeAllObjects];
-    }];
+    // the attributes objects are kept and updated in place the next time they are requested
+    _supplementaryAttributesGeneration++;
 }
 
 #pragma mark - Minimum Invalidated Section
 
 - (void)didModifySection:(NSInteger)modifiedSection {
-    _minimumInvalidatedSection = IGListMergeMinimumInvalidatedSection(_minimumInvalidatedSection, modifiedSection);
+    [self _invalidateFromItem:0 inSection:modifiedSection];
+}
+
+- (void)didModifyItemAtIndexPath:(NSIndexPath *)indexPath {
+    [self _invalidateFromItem:indexPath.item inSection:indexPath.section];
+}
+
+- (void)_invalidateFromItem:(NSInteger)item inSection:(NSInteger)section {
+    if (_minimumInvalidatedSection == NSNotFound || section < _minimumInvalidatedSection) {
+        _minimumInvalidatedSection = section;
+        _minimumInvalidatedItem = item;
+    } else if (section == _minimumInvalidatedSection) {
+        _minimumInvalidatedItem = MIN(_minimumInvalidatedItem, item);
+    }
+}
+
+- (void)willApplyBatchUpdateData:(IGListBatchUpdateData *)updateData {
+    IGAssertMainThread();
+
+    _reusableSectionInputs.clear();
+    if (!self.usesBatchUpdateRemapping || updateData == nil) {
+        return;
+    }
+
+    // sections at or after a pending invalidation were never measured against the current data
+    const NSInteger oldSectionCount = _sectionInputs.size();
+    const NSInteger validSectionCount = MIN(oldSectionCount, _minimumInvalidatedSection);
+    const NSInteger newSectionCount = oldSectionCount - (NSInteger)updateData.deleteSections.count + (NSInteger)updateData.insertSections.count;
+    if (newSectionCount < 0) {
+        return;
+    }
+
+    // Find the old section of every new section the way UICollectionView does: deleted and moved sections leave their
+    // slot, inserted and moved sections take theirs, and the remaining sections fill the free slots in order.
+    std::vector<NSInteger> oldSectionForNewSection(newSectionCount, NSNotFound);
+    std::vector<bool> isTakenNewSection(newSectionCount, false);
+    std::vector<bool> isRemovedOldSection(oldSectionCount, false);
+    for (NSUInteger section = updateData.insertSections.firstIndex; section != NSNotFound; section = [updateData.insertSections indexGreaterThanIndex:section]) {
+        if ((NSInteger)section >= newSectionCount) {
+            return;
+        }
+        isTakenNewSection[section] = true;
+    }
+    for (NSUInteger section = updateData.deleteSections.firstIndex; section != NSNotFound; section = [updateData.deleteSections indexGreaterThanIndex:section]) {
+        if ((NSInteger)section >= oldSectionCount) {
+            return;
+        }
+        isRemovedOldSection[section] = true;
+    }
+    for (IGListMoveIndex *move in updateData.moveSections) {
+        if (move.from >= oldSectionCount || move.to >= newSectionCount) {
+            return;
+        }
+        oldSectionForNewSection[move.to] = move.from;
+        isTakenNewSection[move.to] = true;
+        isRemovedOldSection[move.from] = true;
+    }
+    NSInteger nextNewSection = 0;
+    for (NSInteger oldSection = 0; oldSection < oldSectionCount; oldSection++) {
+        if (isRemovedOldSection[oldSection]) {
+            continue;
+        }
+        while (nextNewSection < newSectionCount && isTakenNewSection[nextNewSection]) {
+            nextNewSection++;
+        }
+        if (nextNewSection == newSectionCount) {
+            return;
+        }
+        oldSectionForNewSection[nextNewSection++] = oldSection;
+    }
+
+    // item updates are described in old sections, except inserts and move destinations
+    std::vector<bool> isModifiedOldSection(oldSectionCount, false);
+    std::vector<bool> isModifiedNewSection(newSectionCount, false);
+    const auto markOldSection = [&](NSIndexPath *indexPath) {
+        if (indexPath.section < oldSectionCount) {
+            isModifiedOldSection[indexPath.section] = true;
+        }
+    };
+    const auto markNewSection = [&](NSIndexPath *indexPath) {
+        if (indexPath.section < newSectionCount) {
+            isModifiedNewSection[indexPath.section] = true;
+        }
+    };
+    for (NSIndexPath *indexPath in updateData.deleteIndexPaths) {
+        markOldSection(indexPath);
+    }
+    for (NSIndexPath *indexPath in updateData.updateIndexPaths) {
+        markOldSection(indexPath);
+    }
+    for (NSIndexPath *indexPath in updateData.insertIndexPaths) {
+        markNewSection(indexPath);
+    }
+    for (IGListMoveIndexPath *move in updateData.moveIndexPaths) {
+        markOldSection(move.from);
+        markNewSection(move.to);
+    }
+
+    // carry the inputs of untouched sections over to their new index, every other section is measured again
+    std::vector<IGListSectionLayoutInput> sectionInputs(newSectionCount);
+    std::vector<bool> reusableSectionInputs(newSectionCount, false);
+    NSInteger firstChangedSection = newSectionCount;
+    for (NSInteger section = 0; section < newSectionCount; section++) {
+        const NSInteger oldSection = oldSectionForNewSection[section];
+        if (oldSection != NSNotFound
+            && oldSection < validSectionCount
+            && !isModifiedOldSection[oldSection]
+            && !isModifiedNewSection[section]) {
+            sectionInputs[section] = std::move(_sectionInputs[oldSection]);
+            reusableSectionInputs[section] = true;
+        }
+        if (oldSection != section || !reusableSectionInputs[section]) {
+            firstChangedSection = MIN(firstChangedSection, section);
+        }
+    }
+
+    _sectionInputs.swap(sectionInputs);
+    _reusableSectionInputs.swap(reusableSectionInputs);
+    // sections before the first changed one keep their frames, the rest are laid out again from their inputs
+    [self _invalidateFromItem:0 inSection:firstChangedSection];
 }
 
 @end
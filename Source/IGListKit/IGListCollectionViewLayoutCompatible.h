@@ -9,6 +9,8 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class IGListBatchUpdateData;
+
 /**
  A protocol for layouts that defines interaction with an IGListCollectionView, for recieving updated section indexes.
  */
@@ -28,6 +30,27 @@ NS_SWIFT_NAME(ListCollectionViewLayoutCompatible)
  */
 - (void)didModifySection:(NSInteger)modifiedSection;
 
+@optional
+
+/**
+ Called right before the updates of a batch are applied to the collection view, while it still reports the old number
+ of sections and items. Layouts can use this to carry cached measurements of moved or untouched sections over to their
+ new index instead of measuring every section after the first modified one again.
+
+ @param updateData The section and item updates about to be applied.
+
+ @note `-didModifySection:` is still called for every update applied afterwards.
+ */
+- (void)willApplyBatchUpdateData:(IGListBatchUpdateData *)updateData;
+
+/**
+ Called instead of `-didModifySection:` when a single item was inserted, deleted, reloaded or moved. The items before it
+ in its section are untouched, so layouts can keep their frames and only lay out the section again from that item.
+
+ @param indexPath The index path of the modified item.
+ */
+- (void)didModifyItemAtIndexPath:(NSIndexPath *)indexPath;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -34,6 +34,7 @@ FOUNDATION_EXPORT const unsigned char IGListKitVersionString[];
 #import "IGListAdapterUpdater.h"
 #import "IGListAdapterUpdaterDelegate.h"
 #import "IGListBatchContext.h"
+#import "IGListBatchSizing.h"
 #import "IGListBindable.h"
 #import "IGListBindingSectionController.h"
 #import "IGListBindingSectionControllerDataSource.h"
@@ -46,10 +47,13 @@ FOUNDATION_EXPORT const unsigned char IGListKitVersionString[];
 #import "IGListDisplayDelegate.h"
 #import "IGListGenericSectionController.h"
 #import "IGListCollectionViewDelegateLayout.h"
+#import "IGListPrefetchScheduler.h"
+#import "IGListPreparedUpdate.h"
 #import "IGListReloadDataUpdater.h"
 #import "IGListScrollDelegate.h"
 #import "IGListSectionController.h"
 #import "IGListSingleSectionController.h"
+#import "IGListSizeSnapshotContent.h"
 #import "IGListSupplementaryViewSource.h"
 #import "IGListTransitionData.h"
 #import "IGListTransitionDelegate.h"
@@ -65,6 +69,7 @@ FOUNDATION_EXPORT const unsigned char IGListKitVersionString[];
 #import <IGListKit/IGListAdapterUpdater.h>
 #import <IGListKit/IGListAdapterUpdaterDelegate.h>
 #import <IGListKit/IGListBatchContext.h>
+#import <IGListKit/IGListBatchSizing.h>
 #import <IGListKit/IGListBindable.h>
 #import <IGListKit/IGListBindingSectionController.h>
 #import <IGListKit/IGListBindingSectionControllerDataSource.h>
@@ -77,10 +82,13 @@ FOUNDATION_EXPORT const unsigned char IGListKitVersionString[];
 #import <IGListKit/IGListDisplayDelegate.h>
 #import <IGListKit/IGListGenericSectionController.h>
 #import <IGListKit/IGListCollectionViewDelegateLayout.h>
+#import <IGListKit/IGListPrefetchScheduler.h>
+#import <IGListKit/IGListPreparedUpdate.h>
 #import <IGListKit/IGListReloadDataUpdater.h>
 #import <IGListKit/IGListScrollDelegate.h>
 #import <IGListKit/IGListSectionController.h>
 #import <IGListKit/IGListSingleSectionController.h>
+#import <IGListKit/IGListSizeSnapshotContent.h>
 #import <IGListKit/IGListSupplementaryViewSource.h>
 #import <IGListKit/IGListTransitionData.h>
 #import <IGListKit/IGListTransitionDelegate.h>
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <UIKit/UIKit.h>
+
+#if !__has_include(<IGListDiffKit/IGListDiffKit.h>)
+#import "IGListMacros.h"
+#else
+#import <IGListDiffKit/IGListMacros.h>
+#endif
+
+@class IGListSectionController;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A block that returns `YES` once the prefetch task that received it was cancelled. Can be called from any thread.
+ */
+NS_SWIFT_NAME(ListPrefetchCancellationCheck)
+typedef BOOL (^IGListPrefetchCancellationCheck)(void);
+
+/**
+ Prefetch work submitted to an `IGListPrefetchScheduler`. Runs on a background queue, and should return early once
+ `isCancelled` returns `YES`.
+ */
+NS_SWIFT_NAME(ListPrefetchTask)
+typedef void (^IGListPrefetchTask)(IGListPrefetchCancellationCheck isCancelled);
+
+/**
+ Runs the prefetch tasks of section controllers on a bounded number of background workers, closest to the visible
+ sections first. Owned by an `IGListAdapter`, which cancels the tasks of a section controller when it exits the working
+ range.
+
+ Section controllers usually submit their tasks from
+ `-[IGListWorkingRangeDelegate listAdapter:sectionControllerWillEnterWorkingRange:]`.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+NS_SWIFT_NAME(ListPrefetchScheduler)
+@interface IGListPrefetchScheduler : NSObject
+
+/**
+ The maximum number of tasks running at the same time. Defaults to 2.
+ */
+@property (nonatomic, assign) NSInteger maxConcurrentTaskCount;
+
+/**
+ The number of submitted tasks waiting for a worker.
+ */
+@property (nonatomic, assign, readonly) NSInteger pendingTaskCount;
+
+/**
+ The number of tasks running on a worker.
+ */
+@property (nonatomic, assign, readonly) NSInteger runningTaskCount;
+
+/**
+ Submits a prefetch task for a section controller of the adapter. Whenever a worker is free, it runs the pending task
+ whose section controller is closest to the visible sections, in submission order for equal distances.
+
+ @param sectionController The section controller the task prefetches content for.
+ @param task The work to run on a background queue.
+ */
+- (void)submitTaskForSectionController:(IGListSectionController *)sectionController
+                                  task:(IGListPrefetchTask)task;
+
+/**
+ Drops the pending tasks of a section controller and marks its running tasks as cancelled.
+
+ @param sectionController The section controller whose tasks to cancel.
+
+ @note Called automatically when the section controller exits the working range.
+ */
+- (void)cancelTasksForSectionController:(IGListSectionController *)sectionController;
+
+/**
+ :nodoc:
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ :nodoc:
+ */
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
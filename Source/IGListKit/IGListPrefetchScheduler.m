@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "IGListPrefetchScheduler.h"
+#import "IGListPrefetchSchedulerInternal.h"
+
+#if !__has_include(<IGListDiffKit/IGListDiffKit.h>)
+#import "IGListAssert.h"
+#else
+#import <IGListDiffKit/IGListAssert.h>
+#endif
+
+#import "IGListAdapterInternal.h"
+
+@interface _IGListPrefetchTaskEntry : NSObject
+
+@property (nonatomic, weak, readonly) IGListSectionController *sectionController;
+@property (nonatomic, copy, readonly) IGListPrefetchTask task;
+// read from the worker through the cancellation check
+@property (atomic, assign) BOOL cancelled;
+
+@end
+
+@implementation _IGListPrefetchTaskEntry
+
+- (instancetype)initWithSectionController:(IGListSectionController *)sectionController task:(IGListPrefetchTask)task {
+    if (self = [super init]) {
+        _sectionController = sectionController;
+        _task = [task copy];
+    }
+    return self;
+}
+
+@end
+
+@implementation IGListPrefetchScheduler {
+    __weak IGListAdapter *_listAdapter;
+    // in submission order, so the first of equally distant tasks runs first
+    NSMutableArray<_IGListPrefetchTaskEntry *> *_pendingTasks;
+    NSMutableArray<_IGListPrefetchTaskEntry *> *_runningTasks;
+}
+
+- (instancetype)initWithListAdapter:(IGListAdapter *)listAdapter {
+    IGParameterAssert(listAdapter != nil);
+
+    if (self = [super init]) {
+        _listAdapter = listAdapter;
+        _maxConcurrentTaskCount = 2;
+        _pendingTasks = [NSMutableArray new];
+        _runningTasks = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    for (_IGListPrefetchTaskEntry *entry in _runningTasks) {
+        entry.cancelled = YES;
+    }
+}
+
+#pragma mark - Public API
+
+- (void)setMaxConcurrentTaskCount:(NSInteger)maxConcurrentTaskCount {
+    IGAssertMainThread();
+    IGParameterAssert(maxConcurrentTaskCount > 0);
+
+    _maxConcurrentTaskCount = MAX(maxConcurrentTaskCount, 1);
+    [self _startPendingTasks];
+}
+
+- (NSInteger)pendingTaskCount {
+    return (NSInteger)_pendingTasks.count;
+}
+
+- (NSInteger)runningTaskCount {
+    return (NSInteger)_runningTasks.count;
+}
+
+- (void)submitTaskForSectionController:(IGListSectionController *)sectionController
+                                  task:(IGListPrefetchTask)task {
+    IGAssertMainThread();
+    IGParameterAssert(sectionController != nil);
+    IGParameterAssert(task != nil);
+
+    [_pendingTasks addObject:[[_IGListPrefetchTaskEntry alloc] initWithSectionController:sectionController task:task]];
+    [self _startPendingTasks];
+}
+
+- (void)cancelTasksForSectionController:(IGListSectionController *)sectionController {
+    IGAssertMainThread();
+    IGParameterAssert(sectionController != nil);
+
+    NSIndexSet *cancelledIndexes = [_pendingTasks indexesOfObjectsPassingTest:^BOOL(_IGListPrefetchTaskEntry *entry, NSUInteger idx, BOOL *stop) {
+        return entry.sectionController == sectionController;
+    }];
+    [_pendingTasks removeObjectsAtIndexes:cancelledIndexes];
+
+    // running tasks keep their worker until they return, so they are only asked to stop
+    for (_IGListPrefetchTaskEntry *entry in _runningTasks) {
+        if (entry.sectionController == sectionController) {
+            entry.cancelled = YES;
+        }
+    }
+}
+
+#pragma mark - Private API
+
+- (void)_startPendingTasks {
+    while ((NSInteger)_runningTasks.count < _maxConcurrentTaskCount && _pendingTasks.count > 0) {
+        const NSUInteger index = [self _indexOfClosestPendingTask];
+        if (index == NSNotFound) {
+            // the section controllers of the remaining tasks were deallocated
+            [_pendingTasks removeAllObjects];
+            return;
+        }
+        _IGListPrefetchTaskEntry *entry = _pendingTasks[index];
+        [_pendingTasks removeObjectAtIndex:index];
+        [self _runTask:entry];
+    }
+}
+
+// Distances are read when a worker frees up rather than on submission, so they follow the scroll position
+- (NSUInteger)_indexOfClosestPendingTask {
+    IGListAdapter *listAdapter = _listAdapter;
+    NSUInteger closestIndex = NSNotFound;
+    NSInteger closestDistance = NSIntegerMax;
+    for (NSUInteger idx = 0; idx < _pendingTasks.count; idx++) {
+        IGListSectionController *sectionController = _pendingTasks[idx].sectionController;
+        if (sectionController == nil) {
+            continue;
+        }
+        const NSInteger section = [listAdapter sectionForSectionController:sectionController];
+        NSInteger distance = section == NSNotFound ? NSNotFound : [listAdapter.workingRangeHandler distanceOfSection:section];
+        // sections of unknown distance, e.g. when nothing is visible yet, run after every known one
+        distance = distance == NSNotFound ? NSIntegerMax - 1 : distance;
+        if (distance < closestDistance) {
+            closestIndex = idx;
+            closestDistance = distance;
+        }
+    }
+    return closestIndex;
+}
+
+- (void)_runTask:(_IGListPrefetchTaskEntry *)entry {
+    [_runningTasks addObject:entry];
+
+    __weak __typeof__(self) weakSelf = self;
+    __weak _IGListPrefetchTaskEntry *weakEntry = entry;
+    IGListPrefetchCancellationCheck isCancelled = ^BOOL{
+        _IGListPrefetchTaskEntry *strongEntry = weakEntry;
+        return strongEntry == nil || strongEntry.cancelled;
+    };
+    IGListPrefetchTask task = entry.task;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        if (!isCancelled()) {
+            task(isCancelled);
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf _didFinishTask:entry];
+        });
+    });
+}
+
+- (void)_didFinishTask:(_IGListPrefetchTaskEntry *)entry {
+    [_runningTasks removeObjectIdenticalTo:entry];
+    [self _startPendingTasks];
+}
+
+@end
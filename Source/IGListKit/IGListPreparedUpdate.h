@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+#if !__has_include(<IGListDiffKit/IGListDiffKit.h>)
+#import "IGListDiffable.h"
+#import "IGListMacros.h"
+#else
+#import <IGListDiffKit/IGListDiffable.h>
+#import <IGListDiffKit/IGListMacros.h>
+#endif
+
+@class IGListIndexSetResult;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ An update of an `IGListAdapter` to a snapshot of objects, diffed against the objects of the adapter and with the
+ section controllers of existing objects assigned ahead of time. Created with
+ `-[IGListAdapter prepareUpdateWithObjects:]` on any thread, and applied with
+ `-[IGListAdapter commitPreparedUpdate:animated:completion:]` on the main thread.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+NS_SWIFT_NAME(ListPreparedUpdate)
+@interface IGListPreparedUpdate : NSObject
+
+/**
+ The objects of the update, without duplicate identifiers.
+ */
+@property (nonatomic, copy, readonly) NSArray<id<IGListDiffable>> *objects;
+
+/**
+ The diff from the objects of the adapter when the update was prepared to `objects`.
+ */
+@property (nonatomic, strong, readonly) IGListIndexSetResult *diffResult;
+
+/**
+ :nodoc:
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ :nodoc:
+ */
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
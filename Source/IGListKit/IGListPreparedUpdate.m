@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "IGListPreparedUpdateInternal.h"
+
+#import "IGListTransitionData.h"
+
+@implementation IGListPreparedUpdate
+
+- (instancetype)initWithFromData:(IGListTransitionData *)fromData
+                         objects:(NSArray<id<IGListDiffable>> *)objects
+                      oldIndexes:(NSArray<NSNumber *> *)oldIndexes
+                      diffResult:(IGListIndexSetResult *)diffResult {
+    if (self = [super init]) {
+        _fromData = fromData;
+        _fromObjects = [fromData.toObjects copy] ?: @[];
+        _objects = [objects copy];
+        _oldIndexes = [oldIndexes copy];
+        _diffResult = diffResult;
+    }
+    return self;
+}
+
+@end
@@ -85,6 +85,16 @@ NS_SWIFT_NAME(ListSectionController)
  */
 - (void)didUpdateToObject:(id)object;
 
+/**
+ Prepares a section controller that was removed from the list to be reused for a new object. Reset any state that
+ belongs to the previous object.
+
+ @note Called by `-[IGListAdapter dequeueReusableSectionControllerOfClass:]` before the section controller is returned.
+ Delegates and other configuration set in `-init` are kept. `-didUpdateToObject:` is called with the new object
+ afterwards. **Calling super is not required.**
+ */
+- (void)prepareForReuse;
+
 /**
  Asks the section controller if the cell at the specified index path should be selected
 
@@ -234,6 +244,13 @@ NS_SWIFT_NAME(ListSectionController)
  */
 @property (nonatomic, assign) CGFloat minimumInteritemSpacing;
 
+/**
+ The number of columns `IGListCollectionViewLayout` packs the items of the section in, each item going to the shortest
+ column. Items are stretched to the width of their column (height when scrolling horizontally), the interitem spacing
+ separates columns and the line spacing separates the items of a column. Defaults to 0, which wraps items in rows.
+ */
+@property (nonatomic, assign) NSInteger numberOfColumns;
+
 /**
  The supplementary view source for the section controller. Can be `nil`.
 
@@ -261,6 +278,13 @@ NS_SWIFT_NAME(ListSectionController)
  */
 @property (nonatomic, weak, nullable) id <IGListWorkingRangeDelegate> workingRangeDelegate;
 
+/**
+ The number of items before and after the visible items of the section that are in its item working range, reported to
+ the optional item methods of `workingRangeDelegate`. Useful for sections with many items, which can then prepare only
+ the items near the viewport. Defaults to 0, which sends no item working range events.
+ */
+@property (nonatomic, assign) NSInteger itemWorkingRangeSize;
+
 /**
  An object that handles scroll events for the section controller. Can be `nil`.
 
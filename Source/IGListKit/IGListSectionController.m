@@ -15,6 +15,8 @@
 #import <IGListDiffKit/IGListMacros.h>
 #endif
 
+#import "IGListAdapterInternal.h"
+
 static NSString * const kIGListSectionControllerThreadKey = @"kIGListSectionControllerThreadKey";
 
 @interface IGListSectionControllerThreadContext : NSObject
@@ -65,11 +67,23 @@ void IGListSectionControllerPopThread(void) {
         _minimumInteritemSpacing = 0.0;
         _minimumLineSpacing = 0.0;
         _inset = UIEdgeInsetsZero;
+        _numberOfColumns = 0;
+        _itemWorkingRangeSize = 0;
         _section = NSNotFound;
     }
     return self;
 }
 
+- (void)setScrollDelegate:(id<IGListScrollDelegate>)scrollDelegate {
+    _scrollDelegate = scrollDelegate;
+
+    // the adapter only forwards scroll events to the visible section controllers subscribed to them
+    id<IGListCollectionContext> collectionContext = self.collectionContext;
+    if ([collectionContext isKindOfClass:[IGListAdapter class]]) {
+        [((IGListAdapter *)collectionContext).displayHandler updateScrollSubscriptionForSectionController:self];
+    }
+}
+
 - (NSInteger)numberOfItems {
     return 1;
 }
@@ -85,6 +99,8 @@ void IGListSectionControllerPopThread(void) {
 
 - (void)didUpdateToObject:(id)object {}
 
+- (void)prepareForReuse {}
+
 - (BOOL)shouldSelectItemAtIndex:(NSInteger)index {
     return YES;
 }
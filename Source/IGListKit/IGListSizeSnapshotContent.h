@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Conform your model objects to this protocol to have their item sizes persisted by
+ `-[IGListAdapter writeItemSizeSnapshotToFile:]` and reused on the next launch.
+
+ @note The `diffIdentifier` of a conforming object must be an `NSString` or `NSNumber`, other identifiers do not have a
+ hash that is stable across launches and are never persisted.
+ */
+NS_SWIFT_NAME(ListSizeSnapshotContent)
+@protocol IGListSizeSnapshotContent <NSObject>
+
+/**
+ A hash of everything about the object that affects the sizes of its items, e.g. the text it displays.
+
+ @note The value must be stable across launches, so do not use `-hash` of strings or other Foundation objects.
+ */
+- (uint64_t)sizeSnapshotContentHash;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -7,6 +7,8 @@
 
 #import "IGListTransitionData.h"
 
+#import "IGListTransitionDataInternal.h"
+
 @implementation IGListTransitionData
 
 - (instancetype)initFromObjects:(NSArray *)fromObjects
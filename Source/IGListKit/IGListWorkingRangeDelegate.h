@@ -38,6 +38,60 @@ NS_SWIFT_NAME(ListWorkingRangeDelegate)
  */
 - (void)listAdapter:(IGListAdapter *)listAdapter sectionControllerDidExitWorkingRange:(IGListSectionController *)sectionController;
 
+@optional
+
+/**
+ Notifies the delegate that a section controller will enter one of the tiers of `IGListAdapter.workingRangeTierSizes`.
+
+ @param listAdapter The adapter controlling the list.
+ @param sectionController The section controller entering the tier.
+ @param tier The index of the tier in `workingRangeTierSizes`.
+ @param distance The number of sections between the section controller and the closest visible section, 0 if it is
+ visible.
+ */
+- (void)listAdapter:(IGListAdapter *)listAdapter
+  sectionController:(IGListSectionController *)sectionController
+willEnterWorkingRangeTier:(NSInteger)tier
+           distance:(NSInteger)distance;
+
+/**
+ Notifies the delegate that a section controller exited one of the tiers of `IGListAdapter.workingRangeTierSizes`.
+
+ @param listAdapter The adapter controlling the list.
+ @param sectionController The section controller that exited the tier.
+ @param tier The index of the tier in `workingRangeTierSizes`.
+ @param distance The number of sections between the section controller and the closest visible section, or `NSNotFound`
+ if no section is visible anymore or the section controller was removed.
+ */
+- (void)listAdapter:(IGListAdapter *)listAdapter
+  sectionController:(IGListSectionController *)sectionController
+didExitWorkingRangeTier:(NSInteger)tier
+           distance:(NSInteger)distance;
+
+/**
+ Notifies the delegate that items of a section controller with a positive `itemWorkingRangeSize` will enter its item
+ working range, which spans the visible items of the section and `itemWorkingRangeSize` items on each side.
+
+ @param listAdapter The adapter controlling the list.
+ @param sectionController The section controller owning the items.
+ @param range The indexes of the items entering the range.
+ */
+- (void)listAdapter:(IGListAdapter *)listAdapter
+  sectionController:(IGListSectionController *)sectionController
+itemsWillEnterWorkingRange:(NSRange)range;
+
+/**
+ Notifies the delegate that items of a section controller with a positive `itemWorkingRangeSize` exited its item working
+ range. All items exit once no item of the section is visible.
+
+ @param listAdapter The adapter controlling the list.
+ @param sectionController The section controller owning the items.
+ @param range The indexes of the items that exited the range.
+ */
+- (void)listAdapter:(IGListAdapter *)listAdapter
+  sectionController:(IGListSectionController *)sectionController
+itemsDidExitWorkingRange:(NSRange)range;
+
 @end
 
 NS_ASSUME_NONNULL_END
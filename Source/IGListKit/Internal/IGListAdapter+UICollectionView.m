@@ -25,7 +25,7 @@
 
 - (NSInteger)numberOfSectionsInCollectionView:(UICollectionView *)collectionView {
     _assertNotInMiddleOfObjectUpdate(self.isInObjectUpdateTransaction);
-    return self.sectionMap.objects.count;
+    return self.sectionMap.sectionCount;
 }
 
 - (NSInteger)collectionView:(UICollectionView *)collectionView numberOfItemsInSection:(NSInteger)section {
@@ -220,6 +220,8 @@
     id object = [self.sectionMap objectForSection:indexPath.section];
     [self.displayHandler willDisplayCell:cell forListAdapter:self sectionController:sectionController object:object indexPath:indexPath];
 
+    [self verifySnapshotSizeForItemAtIndexPath:indexPath];
+
     _isSendingWorkingRangeDisplayUpdates = YES;
     [self.workingRangeHandler willDisplayItemAtIndexPath:indexPath forListAdapter:self];
     _isSendingWorkingRangeDisplayUpdates = NO;
@@ -403,6 +405,29 @@
     return attributes;
 }
 
+- (NSInteger)collectionView:(UICollectionView *)collectionView layout:(UICollectionViewLayout *)collectionViewLayout numberOfColumnsInSection:(NSInteger)section {
+    IGWarn(![self.collectionViewDelegate respondsToSelector:_cmd], @"IGListAdapter is consuming method also implemented by the collectionViewDelegate: %@", NSStringFromSelector(_cmd));
+    return [[self sectionControllerForSection:section] numberOfColumns];
+}
+
+- (BOOL)collectionView:(UICollectionView *)collectionView
+                layout:(UICollectionViewLayout *)collectionViewLayout
+              getSizes:(CGSize *)sizes
+       forItemsInRange:(NSRange)range
+             inSection:(NSInteger)section {
+    if (![self getSizes:sizes forItemsInRange:range inSection:section]) {
+        return NO;
+    }
+#if IG_ASSERTIONS_ENABLED
+    for (NSUInteger i = 0; i < range.length; i++) {
+        NSIndexPath *indexPath = [NSIndexPath indexPathForItem:range.location + i inSection:section];
+        IGAssert(!isnan(sizes[i].height), @"IGListAdapter returned NaN height = %f %@", sizes[i].height, [self _debugDetailsForIndexPath:indexPath]);
+        IGAssert(!isnan(sizes[i].width), @"IGListAdapter returned NaN width = %f %@", sizes[i].width, [self _debugDetailsForIndexPath:indexPath]);
+    }
+#endif
+    return YES;
+}
+
 #pragma mark - Assert helpers
 
 - (NSString *)_debugDetailsForIndexPath:(NSIndexPath *)indexPath __attribute__((objc_direct)) {
@@ -13,6 +13,7 @@
 #import "IGListAdapterProxy.h"
 #import "IGListDisplayHandler.h"
 #import "IGListSectionMap.h"
+#import "IGListTransitionData.h"
 #import "IGListWorkingRangeHandler.h"
 
 NS_ASSUME_NONNULL_BEGIN
@@ -73,6 +74,10 @@ IGListBatchContext
 @property (nonatomic, assign, readonly) BOOL isInDataUpdateBlock;
 @property (nonatomic, strong, nullable) IGListSectionMap *previousSectionMap;
 
+// The data of the last update applied to the section map. Atomic, since -prepareUpdateWithObjects: reads its objects
+// and section controllers from any thread.
+@property (atomic, strong) IGListTransitionData *committedData;
+
 /**
  Set of cell identifiers registered with the list context.
  Identifiers are constructed with the `IGListReusableViewIdentifier` function.
@@ -94,6 +99,13 @@ IGListBatchContext
                                                   index:(NSInteger)index
                              usePreviousIfInUpdateBlock:(BOOL)usePreviousIfInUpdateBlock;
 
+/// Sizes a range of items with a single call when the section controller conforms to IGListBatchSizing.
+/// Returns NO if the items must be sized one at a time.
+- (BOOL)getSizes:(CGSize *)sizes forItemsInRange:(NSRange)range inSection:(NSInteger)section;
+
+/// Measures an item whose size came from the size snapshot and invalidates its layout if the size is stale.
+- (void)verifySnapshotSizeForItemAtIndexPath:(NSIndexPath *)indexPath;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -47,7 +47,9 @@ static BOOL isInterceptedSelector(SEL sel) {
 
             // IGListCollectionViewDelegateLayout
             sel == @selector(collectionView:layout:customizedInitialLayoutAttributes:atIndexPath:) ||
-            sel == @selector(collectionView:layout:customizedFinalLayoutAttributes:atIndexPath:)
+            sel == @selector(collectionView:layout:customizedFinalLayoutAttributes:atIndexPath:) ||
+            sel == @selector(collectionView:layout:getSizes:forItemsInRange:inSection:) ||
+            sel == @selector(collectionView:layout:numberOfColumnsInSection:)
             );
 }
 
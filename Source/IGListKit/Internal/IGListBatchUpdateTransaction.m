@@ -24,7 +24,7 @@
 #import "IGListItemUpdatesCollector.h"
 #import "IGListMoveIndexPathInternal.h"
 #import "IGListReloadIndexPath.h"
-#import "IGListTransitionData.h"
+#import "IGListTransitionDataInternal.h"
 #import "UICollectionView+IGListBatchUpdateData.h"
 #import "IGListPerformDiff.h"
 
@@ -169,7 +169,7 @@ willPerformBatchUpdatesWithCollectionView:self.collectionView
                    listIndexSetResult:diffResult
                              animated:self.animated];
     void (^updates)(void) = ^ {
-        [self _applyDataUpdates];
+        [self _applyDataUpdatesWithDiffResult:diffResult];
         [self _applyCollectioViewUpdates:diffResult];
     };
 
@@ -220,14 +220,16 @@ willPerformBatchUpdatesWithCollectionView:self.collectionView
     }
 }
 
-- (void)_applyDataUpdates {
+- (void)_applyDataUpdatesWithDiffResult:(nullable IGListIndexSetResult *)diffResult {
     self.state = IGListBatchUpdateStateExecutingBatchUpdateBlock;
 
     // run the update block so that the adapter can set its items. this makes sure that just before the update is
     // committed that the data source is updated to the /latest/ "toObjects". this makes the data source in sync
     // with the items that the updater is transitioning to
     if (self.applySectionDataBlock != nil && self.sectionData != nil) {
-        self.applySectionDataBlock((IGListTransitionData *)self.sectionData);
+        IGListTransitionData *sectionData = (IGListTransitionData *)self.sectionData;
+        sectionData.diffResult = diffResult;
+        self.applySectionDataBlock(sectionData);
     }
 
     // execute each item update block which should make calls like insert, delete, and reload for index paths
@@ -242,21 +244,19 @@ willPerformBatchUpdatesWithCollectionView:self.collectionView
 
 - (void)_applyCollectioViewUpdates:(IGListIndexSetResult *)diffResult {
     if (self.config.singleItemSectionUpdates) {
-        [self.collectionView deleteSections:diffResult.deletes];
-        [self.collectionView insertSections:diffResult.inserts];
-        for (IGListMoveIndex *move in diffResult.moves) {
-            [self.collectionView moveSection:move.from toSection:move.to];
-        }
+        IGListBatchUpdateData *updateData = [[IGListBatchUpdateData alloc]
+                                             initWithInsertSections:diffResult.inserts
+                                             deleteSections:diffResult.deletes
+                                             moveSections:[NSSet setWithArray:diffResult.moves]
+                                             insertIndexPaths:@[]
+                                             deleteIndexPaths:@[]
+                                             updateIndexPaths:@[]
+                                             moveIndexPaths:@[]];
+        // applied like any other batch so that the layout is told about the section updates before they happen
+        [self.collectionView ig_applyBatchUpdateData:updateData];
         // NOTE: for section updates, it's updated in the IGListSectionController's -didUpdateToObject:, since there is *only* 1 cell for the section, we can just update that cell.
 
-        self.actualCollectionViewUpdates = [[IGListBatchUpdateData alloc]
-                                            initWithInsertSections:diffResult.inserts
-                                            deleteSections:diffResult.deletes
-                                            moveSections:[NSSet setWithArray:diffResult.moves]
-                                            insertIndexPaths:@[]
-                                            deleteIndexPaths:@[]
-                                            updateIndexPaths:@[]
-                                            moveIndexPaths:@[]];
+        self.actualCollectionViewUpdates = updateData;
     } else {
         self.actualCollectionViewUpdates = IGListApplyUpdatesToCollectionView(self.collectionView,
                                                                               diffResult,
@@ -297,7 +297,8 @@ willPerformBatchUpdatesWithCollectionView:self.collectionView
 
 - (void)_reload {
     [self.delegate listAdapterUpdater:self.updater willReloadDataWithCollectionView:self.collectionView isFallbackReload:YES];
-    [self _applyDataUpdates];
+    // the collection view reloads instead of applying the diff, so the adapter rebuilds everything too
+    [self _applyDataUpdatesWithDiffResult:nil];
     [self.collectionView reloadData];
     [self.collectionView layoutIfNeeded];
     [self.delegate listAdapterUpdater:self.updater didReloadDataWithCollectionView:self.collectionView isFallbackReload:YES];
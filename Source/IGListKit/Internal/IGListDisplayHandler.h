@@ -29,6 +29,38 @@ IGLK_SUBCLASSING_RESTRICTED
  */
 @property (nonatomic, strong, readonly) NSCountedSet<IGListSectionController *> *visibleListSections;
 
+/**
+ The section controllers with visible cells, mapped to those cells in the order they were displayed. Unlike
+ `visibleListSections`, does not include section controllers with only supplementary views visible.
+ */
+@property (nonatomic, strong, readonly) NSMapTable<IGListSectionController *, NSMutableArray<UICollectionViewCell *> *> *visibleCellsBySectionController;
+
+/**
+ The visible cells of a section controller, in the order they were displayed.
+
+ @param sectionController A section controller of the IGListAdapter.
+
+ @return An array of cells, empty if none is visible.
+ */
+- (NSArray<UICollectionViewCell *> *)visibleCellsForSectionController:(IGListSectionController *)sectionController;
+
+/**
+ The visible section controllers that have a scroll delegate, in the order they were displayed. Scroll events are only
+ forwarded to these, so that scrolling neither copies `visibleListSections` nor messages section controllers without
+ a scroll delegate.
+
+ @note Scroll delegates can display and end displaying section controllers, which changes the array, so iterate it by
+ index rather than with fast enumeration.
+ */
+@property (nonatomic, strong, readonly) NSArray<IGListSectionController *> *scrollSubscribers;
+
+/**
+ Subscribes a visible section controller to scroll events if it has a scroll delegate, unsubscribes it otherwise.
+
+ @param sectionController A section controller of the IGListAdapter whose scroll delegate changed.
+ */
+- (void)updateScrollSubscriptionForSectionController:(IGListSectionController *)sectionController;
+
 /**
  Tells the handler that a cell will be displayed in the IGListAdapter.
 
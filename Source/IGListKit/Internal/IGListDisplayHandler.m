@@ -21,6 +21,7 @@
 @interface IGListDisplayHandler ()
 
 @property (nonatomic, strong) NSMapTable *visibleViewObjectMap;
+@property (nonatomic, strong, readonly) NSMutableArray<IGListSectionController *> *mutableScrollSubscribers;
 
 @end
 
@@ -29,7 +30,10 @@
 - (instancetype)init {
     if (self = [super init]) {
         _visibleListSections = [NSCountedSet new];
+        _visibleCellsBySectionController = [NSMapTable mapTableWithKeyOptions:NSMapTableObjectPointerPersonality | NSMapTableStrongMemory
+                                                                  valueOptions:NSMapTableStrongMemory];
         _visibleViewObjectMap = [[NSMapTable alloc] initWithKeyOptions:NSMapTableStrongMemory valueOptions:NSMapTableStrongMemory capacity:0];
+        _mutableScrollSubscribers = [NSMutableArray new];
     }
     return self;
 }
@@ -41,6 +45,57 @@
     return object;
 }
 
+- (NSArray<UICollectionViewCell *> *)visibleCellsForSectionController:(IGListSectionController *)sectionController {
+    NSArray<UICollectionViewCell *> *cells = [self.visibleCellsBySectionController objectForKey:sectionController];
+    return cells != nil ? [cells copy] : @[];
+}
+
+- (NSArray<IGListSectionController *> *)scrollSubscribers {
+    return self.mutableScrollSubscribers;
+}
+
+- (void)updateScrollSubscriptionForSectionController:(IGListSectionController *)sectionController {
+    if (sectionController == nil) {
+        return;
+    }
+    NSMutableArray<IGListSectionController *> *scrollSubscribers = self.mutableScrollSubscribers;
+    const NSUInteger index = [scrollSubscribers indexOfObjectIdenticalTo:sectionController];
+    const BOOL subscribes = sectionController.scrollDelegate != nil && [self.visibleListSections countForObject:sectionController] > 0;
+    if (subscribes && index == NSNotFound) {
+        [scrollSubscribers addObject:sectionController];
+    } else if (!subscribes && index != NSNotFound) {
+        [scrollSubscribers removeObjectAtIndex:index];
+    }
+}
+
+- (void)_registerCell:(UICollectionViewCell *)cell forSectionController:(IGListSectionController *)sectionController {
+    if (sectionController == nil) {
+        return;
+    }
+    NSMapTable *visibleCellsBySectionController = self.visibleCellsBySectionController;
+    NSMutableArray<UICollectionViewCell *> *cells = [visibleCellsBySectionController objectForKey:sectionController];
+    if (cells == nil) {
+        cells = [NSMutableArray new];
+        [visibleCellsBySectionController setObject:cells forKey:sectionController];
+    }
+    // UICollectionView can display a cell again without ending its display first
+    if ([cells indexOfObjectIdenticalTo:cell] == NSNotFound) {
+        [cells addObject:cell];
+    }
+}
+
+- (void)_unregisterCell:(UICollectionViewCell *)cell forSectionController:(IGListSectionController *)sectionController {
+    if (sectionController == nil) {
+        return;
+    }
+    NSMapTable *visibleCellsBySectionController = self.visibleCellsBySectionController;
+    NSMutableArray<UICollectionViewCell *> *cells = [visibleCellsBySectionController objectForKey:sectionController];
+    [cells removeObjectIdenticalTo:cell];
+    if (cells != nil && cells.count == 0) {
+        [visibleCellsBySectionController removeObjectForKey:sectionController];
+    }
+}
+
 - (void)_willDisplayReusableView:(UICollectionReusableView *)view
                  forListAdapter:(IGListAdapter *)listAdapter
               sectionController:(IGListSectionController *)sectionController
@@ -59,6 +114,9 @@
         [listAdapter.globalDelegateAnnouncer announceObjectDisplayWithAdapter:listAdapter object:object index:indexPath.section];
     }
     [visibleListSections addObject:sectionController];
+    if ([visibleListSections countForObject:sectionController] == 1) {
+        [self updateScrollSubscriptionForSectionController:sectionController];
+    }
 }
 
 - (void)_didEndDisplayingReusableView:(UICollectionReusableView *)view
@@ -80,6 +138,7 @@
     [visibleSections removeObject:sectionController];
 
     if ([visibleSections countForObject:sectionController] == 0) {
+        [self updateScrollSubscriptionForSectionController:sectionController];
         [sectionController didEndDisplayingSectionControllerWithListAdapter:listAdapter];
         [listAdapter.delegate listAdapter:listAdapter didEndDisplayingObject:object atIndex:section];
         [listAdapter.globalDelegateAnnouncer announceObjectEndDisplayWithAdapter:listAdapter object:object index:indexPath.section];
@@ -113,6 +172,7 @@
     [listAdapter.delegate listAdapter:listAdapter willDisplayObject:object cell:cell atIndexPath:indexPath];
     [listAdapter.globalDelegateAnnouncer announceCellDisplayWithAdapter:listAdapter object:object cell:cell indexPath:indexPath];
 
+    [self _registerCell:cell forSectionController:sectionController];
     [self _willDisplayReusableView:cell forListAdapter:listAdapter sectionController:sectionController object:object indexPath:indexPath];
 }
 
@@ -130,6 +190,7 @@
     [listAdapter.delegate listAdapter:listAdapter didEndDisplayingObject:object cell:cell atIndexPath:indexPath];
     [listAdapter.globalDelegateAnnouncer announceCellEndDisplayWithAdapter:listAdapter object:object cell:cell indexPath:indexPath];
 
+    [self _unregisterCell:cell forSectionController:sectionController];
     [self _didEndDisplayingReusableView:cell forListAdapter:listAdapter sectionController:sectionController object:object indexPath:indexPath];
 }
 
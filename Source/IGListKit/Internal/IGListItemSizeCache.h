@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <UIKit/UIKit.h>
+
+#if !__has_include(<IGListDiffKit/IGListDiffKit.h>)
+#import "IGListDiffable.h"
+#import "IGListMacros.h"
+#else
+#import <IGListDiffKit/IGListDiffable.h>
+#import <IGListDiffKit/IGListMacros.h>
+#endif
+
+@class IGListIndexSetResult;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Caches item sizes returned by section controllers, keyed by the `diffIdentifier` of the section's object, the item
+ index and the container environment (container size, inset and trait collection).
+
+ Sizes for a handful of recently used environments are kept, so returning to a previously seen container size (e.g.
+ rotating back) does not measure again. Sizes of an object are dropped once the object is no longer equal, according to
+ `-isEqualToDiffableObject:`, to the object the sizes were measured for.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+@interface IGListItemSizeCache : NSObject
+
+/**
+ Looks up a cached size.
+
+ @param size Filled with the cached size if one exists.
+ @param object The object powering the section.
+ @param index The index of the item in the section.
+ @param containerSize The size of the container.
+ @param containerInset The adjusted inset of the container.
+ @param traitCollection The trait collection of the container.
+
+ @return `YES` if a size was cached, `NO` otherwise.
+ */
+- (BOOL)getSize:(CGSize *)size
+      forObject:(id<IGListDiffable>)object
+        atIndex:(NSInteger)index
+  containerSize:(CGSize)containerSize
+ containerInset:(UIEdgeInsets)containerInset
+traitCollection:(nullable UITraitCollection *)traitCollection;
+
+/**
+ Stores a measured size. See `-getSize:forObject:atIndex:containerSize:containerInset:traitCollection:`.
+ */
+- (void)setSize:(CGSize)size
+      forObject:(id<IGListDiffable>)object
+        atIndex:(NSInteger)index
+  containerSize:(CGSize)containerSize
+ containerInset:(UIEdgeInsets)containerInset
+traitCollection:(nullable UITraitCollection *)traitCollection;
+
+/**
+ Updates the tracked objects. Sizes of objects that are no longer in `objects`, or that were updated (same
+ `diffIdentifier` but not equal), are removed.
+
+ @param objects The new objects of the list.
+ */
+- (void)updateWithObjects:(NSArray<id<IGListDiffable>> *)objects;
+
+/**
+ Removes the sizes of the objects that a diff deleted or updated, without visiting the objects it left unchanged.
+
+ @param fromObjects The objects the diff started from.
+ @param diffResult The diff from `fromObjects` to the new objects of the list.
+ */
+- (void)updateWithFromObjects:(NSArray<id<IGListDiffable>> *)fromObjects diffResult:(IGListIndexSetResult *)diffResult;
+
+/**
+ Removes every cached size of an object.
+
+ @param object The object whose sizes should be removed.
+ */
+- (void)invalidateSizesForObject:(id<IGListDiffable>)object;
+
+/**
+ Removes every cached size.
+ */
+- (void)removeAllSizes;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "IGListItemSizeCache.h"
+
+#if !__has_include(<IGListDiffKit/IGListDiffKit.h>)
+#import "IGListAssert.h"
+#import "IGListIndexSetResult.h"
+#else
+#import <IGListDiffKit/IGListAssert.h>
+#import <IGListDiffKit/IGListIndexSetResult.h>
+#endif
+
+// number of container environments to keep sizes for, most recently used first
+static const NSUInteger kIGListItemSizeCacheMaxEnvironments = 4;
+
+@interface IGListItemSizeCacheEnvironment : NSObject
+
+@property (nonatomic, assign, readonly) CGSize containerSize;
+@property (nonatomic, assign, readonly) UIEdgeInsets containerInset;
+@property (nonatomic, strong, readonly, nullable) UITraitCollection *traitCollection;
+
+// diffIdentifier -> item index -> size
+@property (nonatomic, strong, readonly) NSMapTable<id, NSMutableDictionary<NSNumber *, NSValue *> *> *sizes;
+
+@end
+
+@implementation IGListItemSizeCacheEnvironment
+
+- (instancetype)initWithContainerSize:(CGSize)containerSize
+                       containerInset:(UIEdgeInsets)containerInset
+                      traitCollection:(UITraitCollection *)traitCollection {
+    if (self = [super init]) {
+        _containerSize = containerSize;
+        _containerInset = containerInset;
+        _traitCollection = traitCollection;
+        _sizes = [NSMapTable strongToStrongObjectsMapTable];
+    }
+    return self;
+}
+
+- (BOOL)matchesContainerSize:(CGSize)containerSize
+              containerInset:(UIEdgeInsets)containerInset
+             traitCollection:(UITraitCollection *)traitCollection {
+    return CGSizeEqualToSize(_containerSize, containerSize)
+    && UIEdgeInsetsEqualToEdgeInsets(_containerInset, containerInset)
+    && (_traitCollection == traitCollection || [_traitCollection isEqual:traitCollection]);
+}
+
+@end
+
+@implementation IGListItemSizeCache {
+    NSMutableArray<IGListItemSizeCacheEnvironment *> *_environments;
+
+    // diffIdentifier -> the object the sizes were measured for
+    NSMapTable<id, id<IGListDiffable>> *_objects;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _environments = [NSMutableArray new];
+        _objects = [NSMapTable strongToStrongObjectsMapTable];
+    }
+    return self;
+}
+
+- (nullable IGListItemSizeCacheEnvironment *)_environmentForContainerSize:(CGSize)containerSize
+                                                           containerInset:(UIEdgeInsets)containerInset
+                                                          traitCollection:(UITraitCollection *)traitCollection
+                                                                   create:(BOOL)create {
+    const NSUInteger count = _environments.count;
+    for (NSUInteger i = 0; i < count; i++) {
+        IGListItemSizeCacheEnvironment *environment = _environments[i];
+        if ([environment matchesContainerSize:containerSize containerInset:containerInset traitCollection:traitCollection]) {
+            if (i > 0) {
+                [_environments removeObjectAtIndex:i];
+                [_environments insertObject:environment atIndex:0];
+            }
+            return environment;
+        }
+    }
+
+    if (!create) {
+        return nil;
+    }
+
+    IGListItemSizeCacheEnvironment *environment = [[IGListItemSizeCacheEnvironment alloc] initWithContainerSize:containerSize
+                                                                                                 containerInset:containerInset
+                                                                                                traitCollection:traitCollection];
+    [_environments insertObject:environment atIndex:0];
+    if (_environments.count > kIGListItemSizeCacheMaxEnvironments) {
+        [_environments removeLastObject];
+    }
+    return environment;
+}
+
+- (BOOL)getSize:(CGSize *)size
+      forObject:(id<IGListDiffable>)object
+        atIndex:(NSInteger)index
+  containerSize:(CGSize)containerSize
+ containerInset:(UIEdgeInsets)containerInset
+traitCollection:(UITraitCollection *)traitCollection {
+    IGParameterAssert(size != NULL);
+    IGParameterAssert(object != nil);
+
+    IGListItemSizeCacheEnvironment *environment = [self _environmentForContainerSize:containerSize
+                                                                      containerInset:containerInset
+                                                                     traitCollection:traitCollection
+                                                                              create:NO];
+    NSValue *value = [[environment.sizes objectForKey:[object diffIdentifier]] objectForKey:@(index)];
+    if (value == nil) {
+        return NO;
+    }
+    *size = value.CGSizeValue;
+    return YES;
+}
+
+- (void)setSize:(CGSize)size
+      forObject:(id<IGListDiffable>)object
+        atIndex:(NSInteger)index
+  containerSize:(CGSize)containerSize
+ containerInset:(UIEdgeInsets)containerInset
+traitCollection:(UITraitCollection *)traitCollection {
+    IGParameterAssert(object != nil);
+
+    id diffIdentifier = [object diffIdentifier];
+    if ([_objects objectForKey:diffIdentifier] == nil) {
+        [_objects setObject:object forKey:diffIdentifier];
+    }
+
+    IGListItemSizeCacheEnvironment *environment = [self _environmentForContainerSize:containerSize
+                                                                      containerInset:containerInset
+                                                                     traitCollection:traitCollection
+                                                                              create:YES];
+    NSMutableDictionary<NSNumber *, NSValue *> *sizes = [environment.sizes objectForKey:diffIdentifier];
+    if (sizes == nil) {
+        sizes = [NSMutableDictionary new];
+        [environment.sizes setObject:sizes forKey:diffIdentifier];
+    }
+    sizes[@(index)] = [NSValue valueWithCGSize:size];
+}
+
+- (void)updateWithObjects:(NSArray<id<IGListDiffable>> *)objects {
+    NSMapTable<id, id<IGListDiffable>> *previousObjects = _objects;
+    NSMapTable<id, id<IGListDiffable>> *nextObjects = [NSMapTable strongToStrongObjectsMapTable];
+
+    for (id<IGListDiffable> object in objects) {
+        id diffIdentifier = [object diffIdentifier];
+        id<IGListDiffable> previousObject = [previousObjects objectForKey:diffIdentifier];
+        if (previousObject == nil) {
+            continue;
+        }
+        if (previousObject == object || [previousObject isEqualToDiffableObject:object]) {
+            // keep tracking the newest instance so that pointer comparisons stay cheap on the next update
+            [nextObjects setObject:object forKey:diffIdentifier];
+        }
+    }
+
+    _objects = nextObjects;
+
+    // drop the sizes of objects that were removed or updated
+    for (IGListItemSizeCacheEnvironment *environment in _environments) {
+        NSMapTable *sizes = environment.sizes;
+        for (id diffIdentifier in [[sizes keyEnumerator] allObjects]) {
+            if ([nextObjects objectForKey:diffIdentifier] == nil) {
+                [sizes removeObjectForKey:diffIdentifier];
+            }
+        }
+    }
+}
+
+- (void)updateWithFromObjects:(NSArray<id<IGListDiffable>> *)fromObjects diffResult:(IGListIndexSetResult *)diffResult {
+    IGParameterAssert(fromObjects != nil);
+    IGParameterAssert(diffResult != nil);
+
+    if (_objects.count == 0) {
+        return;
+    }
+
+    // the diff already compared every object, so only the deleted and updated ones are looked at. updated indexes are
+    // indexes of the old objects, like deleted ones.
+    void (^invalidate)(NSUInteger, BOOL *) = ^(NSUInteger idx, BOOL *stop) {
+        [self invalidateSizesForObject:fromObjects[idx]];
+    };
+    [diffResult.deletes enumerateIndexesUsingBlock:invalidate];
+    [diffResult.updates enumerateIndexesUsingBlock:invalidate];
+}
+
+- (void)invalidateSizesForObject:(id<IGListDiffable>)object {
+    IGParameterAssert(object != nil);
+
+    id diffIdentifier = [object diffIdentifier];
+    [_objects removeObjectForKey:diffIdentifier];
+    for (IGListItemSizeCacheEnvironment *environment in _environments) {
+        [environment.sizes removeObjectForKey:diffIdentifier];
+    }
+}
+
+- (void)removeAllSizes {
+    [_environments removeAllObjects];
+    [_objects removeAllObjects];
+}
+
+@end
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ A plain rect used by the layout storage so that it does not depend on CoreGraphics.
+ */
+struct IGListLayoutRect {
+    double x;
+    double y;
+    double width;
+    double height;
+};
+
+/**
+ Stores the item frames of every section in a single structure-of-arrays buffer. Sections are addressed through a table
+ of offsets into the buffer, so a 100k item list is four contiguous arrays instead of one heap allocation per section.
+
+ Sections are always rebuilt from a given section, or from an item of the last kept section, to the end, which is what
+ the layout does on invalidation. Truncating keeps the allocated capacity, so re-laying out the same content does not
+ reallocate.
+
+ In compact mode coordinates are stored as 32-bit floats, halving the memory footprint. Coordinates farther than ~1M
+ points from the origin lose sub-pixel precision in that mode.
+ */
+class IGListLayoutFrameStorage {
+public:
+    explicit IGListLayoutFrameStorage(bool compact = false) : _compact(compact), _sectionOffsets(1, 0) {}
+
+    bool isCompact() const {
+        return _compact;
+    }
+
+    /// Switching modes drops every stored frame.
+    void setCompact(bool compact) {
+        if (_compact != compact) {
+            _compact = compact;
+            _wide.clear();
+            _narrow.clear();
+            _sectionOffsets.assign(1, 0);
+        }
+    }
+
+    std::size_t sectionCount() const {
+        return _sectionOffsets.size() - 1;
+    }
+
+    std::size_t itemCount(std::size_t section) const {
+        return _sectionOffsets[section + 1] - _sectionOffsets[section];
+    }
+
+    std::size_t totalItemCount() const {
+        return _sectionOffsets.back();
+    }
+
+    /// The index of the first item of `section` among the items of all sections, `section` can be the section count.
+    std::size_t firstItemIndex(std::size_t section) const {
+        return _sectionOffsets[section];
+    }
+
+    /// The section of the item at `index` among the items of all sections.
+    std::size_t sectionOfItemIndex(std::size_t index) const {
+        return (std::size_t)(std::upper_bound(_sectionOffsets.begin(), _sectionOffsets.end(), index) - _sectionOffsets.begin()) - 1;
+    }
+
+    /// Drops `section` and every section after it, keeping the allocated capacity.
+    void truncateToSection(std::size_t section) {
+        if (section >= sectionCount()) {
+            return;
+        }
+        _sectionOffsets.resize(section + 1);
+        _resizeItems(_sectionOffsets.back());
+    }
+
+    /// Changes the item count of the last section, keeping the frames of the items it still has.
+    void resizeLastSection(std::size_t itemCount) {
+        _sectionOffsets.back() = _sectionOffsets[_sectionOffsets.size() - 2] + itemCount;
+        _resizeItems(_sectionOffsets.back());
+    }
+
+    /// Appends a section with `itemCount` zeroed frames and returns its index.
+    std::size_t appendSection(std::size_t itemCount) {
+        const std::size_t total = _sectionOffsets.back() + itemCount;
+        _sectionOffsets.push_back(total);
+        _resizeItems(total);
+        return sectionCount() - 1;
+    }
+
+    void setFrame(std::size_t section, std::size_t item, const IGListLayoutRect &frame) {
+        const std::size_t index = _sectionOffsets[section] + item;
+        if (_compact) {
+            _narrow.set(index, frame);
+        } else {
+            _wide.set(index, frame);
+        }
+    }
+
+    IGListLayoutRect frame(std::size_t section, std::size_t item) const {
+        return frameAtIndex(_sectionOffsets[section] + item);
+    }
+
+    IGListLayoutRect frameAtIndex(std::size_t index) const {
+        return _compact ? _narrow.get(index) : _wide.get(index);
+    }
+
+private:
+    template <typename T>
+    struct Columns {
+        std::vector<T> x;
+        std::vector<T> y;
+        std::vector<T> width;
+        std::vector<T> height;
+
+        void resize(std::size_t count) {
+            x.resize(count);
+            y.resize(count);
+            width.resize(count);
+            height.resize(count);
+        }
+
+        void clear() {
+            // swap with empty vectors to actually release the memory of the mode we are leaving
+            std::vector<T>().swap(x);
+            std::vector<T>().swap(y);
+            std::vector<T>().swap(width);
+            std::vector<T>().swap(height);
+        }
+
+        void set(std::size_t index, const IGListLayoutRect &frame) {
+            x[index] = static_cast<T>(frame.x);
+            y[index] = static_cast<T>(frame.y);
+            width[index] = static_cast<T>(frame.width);
+            height[index] = static_cast<T>(frame.height);
+        }
+
+        IGListLayoutRect get(std::size_t index) const {
+            return {x[index], y[index], width[index], height[index]};
+        }
+    };
+
+    void _resizeItems(std::size_t count) {
+        if (_compact) {
+            _narrow.resize(count);
+        } else {
+            _wide.resize(count);
+        }
+    }
+
+    bool _compact;
+    Columns<double> _wide;
+    Columns<float> _narrow;
+
+    // _sectionOffsets[section] is the index of the first item of `section`, the last element is the total item count
+    std::vector<std::size_t> _sectionOffsets;
+};
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ The last range returned by IGListLayoutSpanIndex::find. Queries of overlapping spans, e.g. while scrolling, start
+ searching from it, so finding the new range costs the log of how far its edges moved instead of the log of the count.
+ */
+struct IGListLayoutSpanIndexHint {
+    std::size_t first;
+    std::size_t last;
+};
+
+/**
+ Indexes the spans of the elements of a layout in the scroll direction, in layout order, to find the elements that can
+ intersect a span without walking all of them.
+
+ Elements are mostly sorted by position but not strictly: a short section can follow a tall item on the same row, and
+ a section with a smaller top inset can start above the previous item. Instead of sorting, the index keeps running
+ maximums, which are always sorted:
+   - the elements before the first one whose running maximum end is past the start of the query all end before it
+   - no element starts earlier than its running maximum start minus the deepest dip so far, so the elements from the
+     first one whose running maximum start is past the end of the query plus that dip all start after it
+
+ All arrays are prefixes, so the layout can truncate and append from its first invalid section like its frame storage.
+ */
+class IGListLayoutSpanIndex {
+public:
+    std::size_t count() const {
+        return _maxEnd.size();
+    }
+
+    /// Drops the element at `count` and every element after it.
+    void truncate(std::size_t count) {
+        if (count >= this->count()) {
+            return;
+        }
+        _maxEnd.resize(count);
+        _maxStart.resize(count);
+        _maxDip.resize(count);
+    }
+
+    void append(double start, double end) {
+        if (_maxEnd.empty()) {
+            _maxEnd.push_back(end);
+            _maxStart.push_back(start);
+            _maxDip.push_back(0);
+            return;
+        }
+        const double previousMaxStart = _maxStart.back();
+        _maxEnd.push_back(std::max(_maxEnd.back(), end));
+        _maxStart.push_back(std::max(previousMaxStart, start));
+        _maxDip.push_back(std::max(_maxDip.back(), previousMaxStart - start));
+    }
+
+    /**
+     Finds the elements [first, last) that can intersect the open span (start, end). The range contains every element
+     that does, plus the few unsorted ones around its edges that the caller filters out with the real frames. The search
+     starts from `hint`, which is updated with the result.
+     */
+    void find(double start, double end, IGListLayoutSpanIndexHint &hint) const {
+        const std::size_t n = count();
+        if (n == 0) {
+            hint = {0, 0};
+            return;
+        }
+        const double dip = _maxDip.back();
+        const std::size_t first = _firstIndex(_maxEnd, hint.first, [start](double value) { return value > start; });
+        const std::size_t last = _firstIndex(_maxStart, hint.last, [end, dip](double value) { return value >= end + dip; });
+        hint = {first, std::max(first, last)};
+    }
+
+private:
+    /// Returns the first index whose value satisfies `predicate`, or the count if none does. `predicate` has to be
+    /// monotonic over `values`.
+    template <typename Predicate>
+    static std::size_t _firstIndex(const std::vector<double> &values, std::size_t hint, Predicate predicate) {
+        const std::size_t n = values.size();
+        hint = std::min(hint, n);
+
+        // gallop away from the hint until the answer is bracketed in [low, high]
+        std::size_t low = 0;
+        std::size_t high = n;
+        if (hint == n || predicate(values[hint])) {
+            high = hint;
+            for (std::size_t step = 1; high > 0; step *= 2) {
+                const std::size_t probe = high > step ? high - step : 0;
+                if (!predicate(values[probe])) {
+                    low = probe + 1;
+                    break;
+                }
+                high = probe;
+            }
+        } else {
+            low = hint + 1;
+            for (std::size_t step = 1; low < n; step *= 2) {
+                const std::size_t probe = std::min(low + step - 1, n - 1);
+                if (predicate(values[probe])) {
+                    high = probe;
+                    break;
+                }
+                low = probe + 1;
+            }
+        }
+        return (std::size_t)(std::partition_point(values.begin() + low, values.begin() + high, [&predicate](double value) {
+            return !predicate(value);
+        }) - values.begin());
+    }
+
+    // running maximum of the end of the elements
+    std::vector<double> _maxEnd;
+    // running maximum of the start of the elements
+    std::vector<double> _maxStart;
+    // running maximum of how far an element starts before the running maximum start of the elements before it
+    std::vector<double> _maxDip;
+};
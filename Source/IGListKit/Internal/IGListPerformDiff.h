@@ -33,6 +33,8 @@ typedef void (^IGListDiffExecutorCompletion)(IGListIndexSetResult *result, BOOL
  @param allowsBackgroundDiffing Allows the diffing to be performed off the main thread
  @param adaptiveConfig Details of how the adaptive diffing should work
  @param completion Returns the diffing results. Can be called async or sync, but will be called on main thread.
+
+ @note If `data` already has a diff result, e.g. from a prepared update, it is returned synchronously without diffing.
  */
 NS_SWIFT_NAME(ListPerformDiff(data:view:allowsBackgroundDiffing:adaptiveConfig:completion:))
 FOUNDATION_EXTERN void IGListPerformDiffWithData(IGListTransitionData *_Nullable data,
@@ -13,7 +13,7 @@
 #import <IGListDiffKit/IGListDiff.h>
 #endif
 
-#import "IGListTransitionData.h"
+#import "IGListTransitionDataInternal.h"
 #import "IGListViewVisibilityTracker.h"
 
 #pragma mark - Regular (not adaptive)
@@ -91,6 +91,13 @@ void IGListPerformDiffWithData(IGListTransitionData *_Nullable data,
     if (!completion) {
         return;
     }
+
+    // diffed ahead of the update by -[IGListAdapter prepareUpdateWithObjects:]
+    IGListIndexSetResult *const preparedResult = data.diffResult;
+    if (preparedResult != nil) {
+        completion(preparedResult, NO);
+        return;
+    }
     
     if (adaptiveConfig.enabled) {
         _adaptivePerformDiffWithData(data, view, allowsBackground, adaptiveConfig, completion);
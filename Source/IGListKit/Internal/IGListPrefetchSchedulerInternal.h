@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "IGListPrefetchScheduler.h"
+
+@class IGListAdapter;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface IGListPrefetchScheduler ()
+
+/**
+ Initializes a scheduler prioritizing tasks by the distance of their section controller from the visible sections of
+ `listAdapter`.
+ */
+- (instancetype)initWithListAdapter:(IGListAdapter *)listAdapter NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "IGListPreparedUpdate.h"
+
+@class IGListTransitionData;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface IGListPreparedUpdate ()
+
+/**
+ Initializes an update from the objects of the last update applied to the adapter.
+
+ @param fromData The data of the last update applied to the adapter, whose `toObjects` were diffed against.
+ @param objects The objects of the update.
+ @param oldIndexes For each object, the index of the object with the same identifier in the `toObjects` of `fromData`,
+ `NSNotFound` for new objects. `nil` when the adapter looks up existing section controllers itself on commit.
+ @param diffResult The diff from the `toObjects` of `fromData` to `objects`.
+ */
+- (instancetype)initWithFromData:(nullable IGListTransitionData *)fromData
+                         objects:(NSArray<id<IGListDiffable>> *)objects
+                      oldIndexes:(nullable NSArray<NSNumber *> *)oldIndexes
+                      diffResult:(IGListIndexSetResult *)diffResult NS_DESIGNATED_INITIALIZER;
+
+/**
+ Held weakly so that the update doesn't retain section controllers off the main thread. Once the adapter moved on and
+ released it, the update no longer applies as prepared.
+ */
+@property (nonatomic, weak, readonly, nullable) IGListTransitionData *fromData;
+
+@property (nonatomic, copy, readonly) NSArray<id<IGListDiffable>> *fromObjects;
+
+@property (nonatomic, copy, readonly, nullable) NSArray<NSNumber *> *oldIndexes;
+
+@end
+
+NS_ASSUME_NONNULL_END
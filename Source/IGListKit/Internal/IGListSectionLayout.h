@@ -0,0 +1,456 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "IGListLayoutFrameStorage.h"
+
+/**
+ The section flow of IGListCollectionViewLayout, without any dependency on UIKit or CoreGraphics so that it can run off
+ the main thread and be tested on its own.
+
+ Items wrap to a new row when they no longer fit. A section starts on a new row if it has a header or packs columns,
+ and is then laid out from the origin and shifted, which lets IGListLayoutSectionsConcurrently lay out runs of sections
+ concurrently.
+ */
+
+struct IGListLayoutSize {
+    double width;
+    double height;
+};
+
+struct IGListLayoutInsets {
+    double top;
+    double left;
+    double bottom;
+    double right;
+};
+
+struct IGListLayoutEnvironment {
+    bool vertical;
+    // the collection view bounds inset by its content inset
+    double containerWidth;
+    double containerHeight;
+    // frames are rounded to pixels of this scale
+    double scale;
+    bool stretchToEdge;
+    bool showHeaderWhenEmpty;
+};
+
+struct IGListSectionLayoutInput {
+    std::vector<IGListLayoutSize> itemSizes;
+    IGListLayoutSize headerSize;
+    IGListLayoutSize footerSize;
+    IGListLayoutInsets insets;
+    double lineSpacing;
+    double interitemSpacing;
+    // 0 wraps items in rows, any other count packs them in that many columns
+    std::size_t columnCount;
+};
+
+/**
+ The laid out section, and the cursor the next section continues from. A zeroed result is the cursor of the first
+ section.
+ */
+struct IGListSectionLayoutResult {
+    IGListLayoutRect bounds;
+    IGListLayoutRect headerBounds;
+    IGListLayoutRect footerBounds;
+    double lastItemCoordInScrollDirection;
+    double lastItemCoordInFixedDirection;
+    double lastNextRowCoordInScrollDirection;
+};
+
+/**
+ The state of IGListLayoutSection right before an item that starts a row of its section. The items before it only affect
+ the rest of the section through this state, so a section whose later items changed can be laid out again from the row
+ of the first changed item.
+ */
+struct IGListSectionRowCursor {
+    std::size_t firstItem;
+    double itemCoordInScrollDirection;
+    double nextRowCoordInScrollDirection;
+    double itemCoordInFixedDirection;
+    IGListLayoutRect rollingSectionBounds;
+};
+
+// avoids wrapping items because of float overflow
+static const double IGListSectionLayoutEpsilon = 1.0;
+
+inline IGListLayoutRect IGListLayoutRectIntegralScaled(const IGListLayoutRect &rect, double scale) {
+    return {
+        std::floor(rect.x * scale) / scale,
+        std::floor(rect.y * scale) / scale,
+        std::ceil(rect.width * scale) / scale,
+        std::ceil(rect.height * scale) / scale,
+    };
+}
+
+inline IGListLayoutRect IGListLayoutRectUnion(const IGListLayoutRect &lhs, const IGListLayoutRect &rhs) {
+    const double minX = std::min(lhs.x, rhs.x);
+    const double minY = std::min(lhs.y, rhs.y);
+    const double maxX = std::max(lhs.x + lhs.width, rhs.x + rhs.width);
+    const double maxY = std::max(lhs.y + lhs.height, rhs.y + rhs.height);
+    return {minX, minY, maxX - minX, maxY - minY};
+}
+
+/**
+ The fixed and scroll direction views of an environment and a section.
+ */
+struct IGListSectionLayoutAxes {
+    IGListSectionLayoutAxes(const IGListLayoutEnvironment &environment, const IGListSectionLayoutInput &input)
+    : vertical(environment.vertical) {
+        const IGListLayoutInsets &insets = input.insets;
+        leadingInsetInScrollDirection = vertical ? insets.top : insets.left;
+        trailingInsetInScrollDirection = vertical ? insets.bottom : insets.right;
+        leadingInsetInFixedDirection = vertical ? insets.left : insets.top;
+        trailingInsetInFixedDirection = vertical ? insets.right : insets.bottom;
+
+        const double containerLengthInFixedDirection = vertical ? environment.containerWidth : environment.containerHeight;
+        paddedLengthInFixedDirection = containerLengthInFixedDirection - leadingInsetInFixedDirection - trailingInsetInFixedDirection;
+        maxCoordinateInFixedDirection = containerLengthInFixedDirection - trailingInsetInFixedDirection;
+
+        const bool hideHeaderWhenItemsEmpty = input.itemSizes.empty() && !environment.showHeaderWhenEmpty;
+        headerLengthInScrollDirection = hideHeaderWhenItemsEmpty ? 0 : lengthInScrollDirection(input.headerSize);
+        footerLengthInScrollDirection = hideHeaderWhenItemsEmpty ? 0 : lengthInScrollDirection(input.footerSize);
+    }
+
+    double lengthInScrollDirection(const IGListLayoutSize &size) const {
+        return vertical ? size.height : size.width;
+    }
+
+    double lengthInFixedDirection(const IGListLayoutSize &size) const {
+        return vertical ? size.width : size.height;
+    }
+
+    double minInScrollDirection(const IGListLayoutRect &rect) const {
+        return vertical ? rect.y : rect.x;
+    }
+
+    double maxInScrollDirection(const IGListLayoutRect &rect) const {
+        return vertical ? rect.y + rect.height : rect.x + rect.width;
+    }
+
+    // the length of the first item in the fixed direction, as the layout clamps it
+    double firstItemLengthInFixedDirection(const IGListSectionLayoutInput &input) const {
+        return std::min(lengthInFixedDirection(input.itemSizes.front()), paddedLengthInFixedDirection);
+    }
+
+    bool vertical;
+    double leadingInsetInScrollDirection;
+    double trailingInsetInScrollDirection;
+    double leadingInsetInFixedDirection;
+    double trailingInsetInFixedDirection;
+    double paddedLengthInFixedDirection;
+    double maxCoordinateInFixedDirection;
+    double headerLengthInScrollDirection;
+    double footerLengthInScrollDirection;
+};
+
+/**
+ Lays out one section after `previous`, writing its item frames to `frames`.
+
+ When `rows` is set, the cursor of the first item and of every item that wraps to a new row is appended to it. When
+ `resume` is set, the items before `resume->firstItem` are left as they are in `frames` and their sizes in `input` are
+ not read. `resume` has to be a cursor recorded for the same section, after the same `previous`. Sections packed in
+ columns record no rows.
+
+ Columns have the same length in the fixed direction, separated by the interitem spacing, and items are stretched to
+ it. Each item goes to the shortest column so far, the leading one on ties, and the items of a column are separated by
+ the line spacing.
+ */
+inline IGListSectionLayoutResult IGListLayoutSection(const IGListSectionLayoutInput &input,
+                                                     std::size_t section,
+                                                     const IGListLayoutEnvironment &environment,
+                                                     const IGListSectionLayoutResult &previous,
+                                                     IGListLayoutFrameStorage &frames,
+                                                     std::vector<IGListSectionRowCursor> *rows = nullptr,
+                                                     const IGListSectionRowCursor *resume = nullptr) {
+    const IGListSectionLayoutAxes axes(environment, input);
+    const IGListLayoutInsets &insets = input.insets;
+    const std::size_t itemCount = input.itemSizes.size();
+    const bool itemsEmpty = itemCount == 0;
+    const bool hideHeaderWhenItemsEmpty = itemsEmpty && !environment.showHeaderWhenEmpty;
+    const bool headerExists = axes.headerLengthInScrollDirection > 0;
+    const bool footerExists = axes.footerLengthInScrollDirection > 0;
+
+    // start the section accounting for the header size
+    // header length in scroll direction is subtracted from the sectionBounds when calculating the header bounds after items are done
+    // this bumps the first row of items over enough to make room for the header
+    double itemCoordInScrollDirection = previous.lastItemCoordInScrollDirection + axes.headerLengthInScrollDirection;
+    double nextRowCoordInScrollDirection = previous.lastNextRowCoordInScrollDirection + axes.headerLengthInScrollDirection;
+
+    // add the leading inset in fixed direction in case the section falls on the same row as the previous
+    // if the section is newlined then the coord in fixed direction is reset
+    double itemCoordInFixedDirection = previous.lastItemCoordInFixedDirection + axes.leadingInsetInFixedDirection;
+
+    // union item frames and optionally the header to find a bounding box of the entire section
+    IGListLayoutRect rollingSectionBounds = previous.bounds;
+
+    const bool packsColumns = input.columnCount > 0 && !itemsEmpty;
+    std::size_t firstItem = packsColumns ? itemCount : 0;
+    if (resume != nullptr) {
+        firstItem = resume->firstItem;
+        itemCoordInScrollDirection = resume->itemCoordInScrollDirection;
+        nextRowCoordInScrollDirection = resume->nextRowCoordInScrollDirection;
+        itemCoordInFixedDirection = resume->itemCoordInFixedDirection;
+        rollingSectionBounds = resume->rollingSectionBounds;
+    }
+
+    if (packsColumns) {
+        const std::size_t columnCount = input.columnCount;
+        const double columnLength = std::max((axes.paddedLengthInFixedDirection - input.interitemSpacing * (columnCount - 1)) / columnCount, 0.0);
+
+        // a min-heap of the coordinate of the next item of each column in the scroll direction, then of the column index
+        typedef std::pair<double, std::size_t> IGListLayoutColumn;
+        std::priority_queue<IGListLayoutColumn, std::vector<IGListLayoutColumn>, std::greater<IGListLayoutColumn>> columns;
+        for (std::size_t column = 0; column < columnCount; column++) {
+            columns.push({nextRowCoordInScrollDirection, column});
+        }
+
+        for (std::size_t item = 0; item < itemCount; item++) {
+            const IGListLayoutSize &size = input.itemSizes[item];
+            const IGListLayoutColumn column = columns.top();
+            columns.pop();
+
+            const double coordInFixedDirection = axes.leadingInsetInFixedDirection + column.second * (columnLength + input.interitemSpacing);
+            const IGListLayoutRect rawFrame = environment.vertical ?
+            IGListLayoutRect{coordInFixedDirection, column.first + insets.top, columnLength, size.height} :
+            IGListLayoutRect{column.first + insets.left, coordInFixedDirection, size.width, columnLength};
+            const IGListLayoutRect frame = IGListLayoutRectIntegralScaled(rawFrame, environment.scale);
+
+            frames.setFrame(section, item, frame);
+
+            nextRowCoordInScrollDirection = std::max(axes.maxInScrollDirection(frame) - axes.leadingInsetInScrollDirection, nextRowCoordInScrollDirection);
+            rollingSectionBounds = item == 0 ? frame : IGListLayoutRectUnion(rollingSectionBounds, frame);
+            columns.push({column.first + axes.lengthInScrollDirection(size) + input.lineSpacing, column.second});
+        }
+
+        // the next section starts below the longest column
+        itemCoordInScrollDirection = nextRowCoordInScrollDirection;
+        itemCoordInFixedDirection = axes.maxCoordinateInFixedDirection;
+    }
+
+    for (std::size_t item = firstItem; item < itemCount; item++) {
+        const IGListLayoutSize &size = input.itemSizes[item];
+        double itemLengthInFixedDirection = std::min(axes.lengthInFixedDirection(size), axes.paddedLengthInFixedDirection);
+
+        // if the origin and length in fixed direction of the item busts the size of the container
+        // or if this is the first item and the header has a non-zero size
+        // newline to the next row and reset
+        const bool newline = itemCoordInFixedDirection + itemLengthInFixedDirection > axes.maxCoordinateInFixedDirection + IGListSectionLayoutEpsilon
+        || (item == 0 && headerExists);
+        if (rows != nullptr && (newline || item == 0)) {
+            rows->push_back({item, itemCoordInScrollDirection, nextRowCoordInScrollDirection, itemCoordInFixedDirection, rollingSectionBounds});
+        }
+        if (newline) {
+            itemCoordInScrollDirection = nextRowCoordInScrollDirection;
+            itemCoordInFixedDirection = axes.leadingInsetInFixedDirection;
+
+            // if newlining, always append line spacing unless its the very first item of the section
+            if (item > 0) {
+                itemCoordInScrollDirection += input.lineSpacing;
+            }
+        }
+
+        const double distanceToEdge = axes.paddedLengthInFixedDirection - (itemCoordInFixedDirection + itemLengthInFixedDirection);
+        if (environment.stretchToEdge && distanceToEdge > 0 && distanceToEdge <= IGListSectionLayoutEpsilon) {
+            itemLengthInFixedDirection = axes.paddedLengthInFixedDirection - itemCoordInFixedDirection;
+        }
+
+        const IGListLayoutRect rawFrame = environment.vertical ?
+        IGListLayoutRect{itemCoordInFixedDirection, itemCoordInScrollDirection + insets.top, itemLengthInFixedDirection, size.height} :
+        IGListLayoutRect{itemCoordInScrollDirection + insets.left, itemCoordInFixedDirection, size.width, itemLengthInFixedDirection};
+        const IGListLayoutRect frame = IGListLayoutRectIntegralScaled(rawFrame, environment.scale);
+
+        frames.setFrame(section, item, frame);
+
+        // track the max size of the row to find the coord of the next row, adjust for leading inset while iterating items
+        nextRowCoordInScrollDirection = std::max(axes.maxInScrollDirection(frame) - axes.leadingInsetInScrollDirection, nextRowCoordInScrollDirection);
+
+        // increase the rolling coord in fixed direction appropriately and add item spacing for all items on the same row
+        itemCoordInFixedDirection += itemLengthInFixedDirection + input.interitemSpacing;
+
+        // union the rolling section bounds
+        rollingSectionBounds = item == 0 ? frame : IGListLayoutRectUnion(rollingSectionBounds, frame);
+    }
+
+    IGListSectionLayoutResult result;
+    result.headerBounds = environment.vertical ?
+    IGListLayoutRect{insets.left,
+                     itemsEmpty ? axes.maxInScrollDirection(rollingSectionBounds) : axes.minInScrollDirection(rollingSectionBounds) - input.headerSize.height,
+                     axes.paddedLengthInFixedDirection,
+                     hideHeaderWhenItemsEmpty ? 0 : input.headerSize.height} :
+    IGListLayoutRect{itemsEmpty ? axes.maxInScrollDirection(rollingSectionBounds) : axes.minInScrollDirection(rollingSectionBounds) - input.headerSize.width,
+                     insets.top,
+                     hideHeaderWhenItemsEmpty ? 0 : input.headerSize.width,
+                     axes.paddedLengthInFixedDirection};
+
+    if (itemsEmpty) {
+        rollingSectionBounds = result.headerBounds;
+    }
+
+    result.footerBounds = environment.vertical ?
+    IGListLayoutRect{insets.left,
+                     axes.maxInScrollDirection(rollingSectionBounds),
+                     axes.paddedLengthInFixedDirection,
+                     hideHeaderWhenItemsEmpty ? 0 : input.footerSize.height} :
+    IGListLayoutRect{axes.maxInScrollDirection(rollingSectionBounds) + insets.right,
+                     insets.top,
+                     hideHeaderWhenItemsEmpty ? 0 : input.footerSize.width,
+                     axes.paddedLengthInFixedDirection};
+
+    // union the header before setting the bounds of the section
+    // only do this when the header has a size, otherwise the union stretches to box empty space
+    if (headerExists) {
+        rollingSectionBounds = IGListLayoutRectUnion(rollingSectionBounds, result.headerBounds);
+    }
+    if (footerExists) {
+        rollingSectionBounds = IGListLayoutRectUnion(rollingSectionBounds, result.footerBounds);
+    }
+    result.bounds = rollingSectionBounds;
+
+    // bump the coord for the next section with the right insets
+    itemCoordInFixedDirection += axes.trailingInsetInFixedDirection;
+
+    // find the farthest point in the section and add the trailing inset to find the next row's coord
+    nextRowCoordInScrollDirection = std::max(nextRowCoordInScrollDirection, axes.maxInScrollDirection(rollingSectionBounds) + axes.trailingInsetInScrollDirection);
+
+    // keep track of coordinates for partial invalidation
+    result.lastItemCoordInScrollDirection = itemCoordInScrollDirection;
+    result.lastItemCoordInFixedDirection = itemCoordInFixedDirection;
+    result.lastNextRowCoordInScrollDirection = nextRowCoordInScrollDirection;
+    return result;
+}
+
+/**
+ Whether a section probably starts on a new row no matter where the previous section ended: it has a header, or its
+ first item fills the row. Only used to pick where runs of sections start, IGListSectionStartsNewRow has the final say.
+ */
+inline bool IGListSectionLikelyStartsNewRow(const IGListSectionLayoutInput &input, const IGListLayoutEnvironment &environment) {
+    if (input.itemSizes.empty()) {
+        // an empty section positions its header after the bounds of the previous section
+        return false;
+    }
+    const IGListSectionLayoutAxes axes(environment, input);
+    return input.columnCount > 0
+    || axes.headerLengthInScrollDirection > 0
+    || axes.firstItemLengthInFixedDirection(input) >= axes.paddedLengthInFixedDirection - IGListSectionLayoutEpsilon;
+}
+
+/**
+ Whether the first item of a section wraps to a new row when laid out after `previous`.
+ */
+inline bool IGListSectionStartsNewRow(const IGListSectionLayoutInput &input,
+                                      const IGListLayoutEnvironment &environment,
+                                      const IGListSectionLayoutResult &previous) {
+    if (input.itemSizes.empty()) {
+        return false;
+    }
+    const IGListSectionLayoutAxes axes(environment, input);
+    return input.columnCount > 0
+    || axes.headerLengthInScrollDirection > 0
+    || previous.lastItemCoordInFixedDirection + axes.leadingInsetInFixedDirection + axes.firstItemLengthInFixedDirection(input)
+       > axes.maxCoordinateInFixedDirection + IGListSectionLayoutEpsilon;
+}
+
+inline void IGListSectionLayoutResultOffset(IGListSectionLayoutResult &result, bool vertical, double offset) {
+    IGListLayoutRect *rects[] = {&result.bounds, &result.headerBounds, &result.footerBounds};
+    for (IGListLayoutRect *rect : rects) {
+        (vertical ? rect->y : rect->x) += offset;
+    }
+    result.lastItemCoordInScrollDirection += offset;
+    result.lastNextRowCoordInScrollDirection += offset;
+}
+
+/**
+ Lays out `inputs`, the sections starting at `firstSection`, after `previous`. Produces the same results as calling
+ IGListLayoutSection for each section in order.
+
+ The sections are split in runs that likely start on a new row, and `parallelFor(count, body)` is called once to lay out
+ every run from the origin, so it must call `body(index)` for every index in [0, count) and return once they all did.
+ The runs are then placed in order: a run that really starts on a new row is shifted by the scroll coordinate of that
+ row, any other run is laid out again after the run before it. Shifts that are not a whole number of pixels are also
+ laid out again, because rounding a shifted frame to pixels is not the same as shifting a rounded frame.
+ */
+template <typename ParallelFor>
+inline void IGListLayoutSectionsConcurrently(const std::vector<IGListSectionLayoutInput> &inputs,
+                                             std::size_t firstSection,
+                                             const IGListLayoutEnvironment &environment,
+                                             const IGListSectionLayoutResult &previous,
+                                             IGListLayoutFrameStorage &frames,
+                                             std::vector<IGListSectionLayoutResult> &results,
+                                             ParallelFor &&parallelFor) {
+    const std::size_t count = inputs.size();
+    results.resize(count);
+    if (count == 0) {
+        return;
+    }
+
+    // runStarts[run] is the index of the first section of the run, the last element is `count`
+    std::vector<std::size_t> runStarts(1, 0);
+    for (std::size_t i = 1; i < count; i++) {
+        if (IGListSectionLikelyStartsNewRow(inputs[i], environment)) {
+            runStarts.push_back(i);
+        }
+    }
+    runStarts.push_back(count);
+    const std::size_t runCount = runStarts.size() - 1;
+
+    const auto layoutRun = [&](std::size_t run, const IGListSectionLayoutResult &start) {
+        IGListSectionLayoutResult cursor = start;
+        for (std::size_t i = runStarts[run]; i < runStarts[run + 1]; i++) {
+            cursor = IGListLayoutSection(inputs[i], firstSection + i, environment, cursor, frames);
+            results[i] = cursor;
+        }
+    };
+
+    // the first run continues from the real cursor, every other run starts from the origin
+    parallelFor(runCount, [&](std::size_t run) {
+        layoutRun(run, run == 0 ? previous : IGListSectionLayoutResult());
+    });
+
+    std::vector<double> offsets(runCount, 0);
+    for (std::size_t run = 1; run < runCount; run++) {
+        const std::size_t start = runStarts[run];
+        const IGListSectionLayoutResult &before = results[start - 1];
+        const double offset = before.lastNextRowCoordInScrollDirection;
+        const double pixels = offset * environment.scale;
+        if (IGListSectionStartsNewRow(inputs[start], environment, before) && std::fabs(pixels - std::round(pixels)) < 1e-6) {
+            offsets[run] = offset;
+            for (std::size_t i = start; i < runStarts[run + 1]; i++) {
+                IGListSectionLayoutResultOffset(results[i], environment.vertical, offset);
+            }
+        } else {
+            layoutRun(run, before);
+        }
+    }
+
+    parallelFor(runCount, [&](std::size_t run) {
+        const double offset = offsets[run];
+        if (offset == 0) {
+            return;
+        }
+        for (std::size_t i = runStarts[run]; i < runStarts[run + 1]; i++) {
+            const std::size_t section = firstSection + i;
+            const std::size_t itemCount = inputs[i].itemSizes.size();
+            for (std::size_t item = 0; item < itemCount; item++) {
+                IGListLayoutRect frame = frames.frame(section, item);
+                (environment.vertical ? frame.y : frame.x) += offset;
+                frames.setFrame(section, item, frame);
+            }
+        }
+    });
+}
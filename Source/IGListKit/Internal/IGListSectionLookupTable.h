@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ Maps the hashes of the keys of a section map to their sections, so that looking up a section neither boxes indexes nor
+ calls back into the keys until a stored hash matches.
+
+ The table does not store keys: each entry is a key's hash and its section, and lookups are given a predicate that
+ compares the key looked up to the key of a candidate section. It is an open-addressing table with linear probing at a
+ load factor of at most 1/2, in a single contiguous buffer. Clearing keeps the buffer, so rebuilding a map of the same
+ size does not allocate.
+ */
+class IGListSectionLookupTable {
+public:
+    static const std::size_t notFound = SIZE_MAX;
+
+    std::size_t count() const {
+        return _count;
+    }
+
+    /// Removes every entry, keeping the allocated capacity.
+    void clear() {
+        for (Entry &entry : _entries) {
+            entry.section = notFound;
+        }
+        _count = 0;
+    }
+
+    /// Grows the table so that `count` entries fit without rehashing.
+    void reserve(std::size_t count) {
+        std::size_t capacity = 8;
+        while (capacity < count * 2) {
+            capacity *= 2;
+        }
+        if (capacity > _entries.size()) {
+            _rehash(capacity);
+        }
+    }
+
+    /**
+     Maps `hash` to `section`. An entry of the same hash for which `isEqual(section)` returns true is replaced, like
+     setting an existing key of a map table.
+     */
+    template <typename IsEqual>
+    void insert(std::size_t hash, std::size_t section, IsEqual &&isEqual) {
+        reserve(_count + 1);
+        std::size_t slot = _slot(hash);
+        while (_entries[slot].section != notFound) {
+            Entry &entry = _entries[slot];
+            if (entry.hash == hash && isEqual(entry.section)) {
+                entry.section = section;
+                return;
+            }
+            slot = (slot + 1) & _mask;
+        }
+        _entries[slot] = {hash, section};
+        _count++;
+    }
+
+    /// The section of the entry of the same hash for which `isEqual(section)` returns true, `notFound` otherwise.
+    template <typename IsEqual>
+    std::size_t find(std::size_t hash, IsEqual &&isEqual) const {
+        if (_count == 0) {
+            return notFound;
+        }
+        for (std::size_t slot = _slot(hash); _entries[slot].section != notFound; slot = (slot + 1) & _mask) {
+            const Entry &entry = _entries[slot];
+            if (entry.hash == hash && isEqual(entry.section)) {
+                return entry.section;
+            }
+        }
+        return notFound;
+    }
+
+    /// Removes the entry mapping `hash` to `section`, if any.
+    void erase(std::size_t hash, std::size_t section) {
+        if (_count == 0) {
+            return;
+        }
+        std::size_t slot = _slot(hash);
+        while (_entries[slot].section != section || _entries[slot].hash != hash) {
+            if (_entries[slot].section == notFound) {
+                return;
+            }
+            slot = (slot + 1) & _mask;
+        }
+        // shift back the entries of the probe sequence that could not be stored in their own slot, so that lookups
+        // never stop early at the hole
+        std::size_t next = slot;
+        while (true) {
+            next = (next + 1) & _mask;
+            if (_entries[next].section == notFound) {
+                break;
+            }
+            const std::size_t home = _slot(_entries[next].hash);
+            const bool reachable = slot <= next ? (slot < home && home <= next) : (slot < home || home <= next);
+            if (!reachable) {
+                _entries[slot] = _entries[next];
+                slot = next;
+            }
+        }
+        _entries[slot].section = notFound;
+        _count--;
+    }
+
+private:
+    struct Entry {
+        std::size_t hash;
+        std::size_t section;
+    };
+
+    std::vector<Entry> _entries;
+    std::size_t _count = 0;
+    std::size_t _mask = 0;
+    unsigned _shift = 64;
+
+    // Fibonacci hashing, since the hashes of NSNumber and pointers mostly differ in their low bits
+    std::size_t _slot(std::size_t hash) const {
+        return (std::size_t)(((uint64_t)hash * 0x9E3779B97F4A7C15ull) >> _shift);
+    }
+
+    void _rehash(std::size_t capacity) {
+        std::vector<Entry> entries(capacity, Entry{0, notFound});
+        entries.swap(_entries);
+        _mask = capacity - 1;
+        _shift = 64;
+        for (std::size_t size = capacity; size > 1; size /= 2) {
+            _shift--;
+        }
+        for (const Entry &entry : entries) {
+            if (entry.section != notFound) {
+                std::size_t slot = _slot(entry.hash);
+                while (_entries[slot].section != notFound) {
+                    slot = (slot + 1) & _mask;
+                }
+                _entries[slot] = entry;
+            }
+        }
+    }
+};
@@ -13,6 +13,7 @@
 #import <IGListDiffKit/IGListMacros.h>
 #endif
 
+@class IGListIndexSetResult;
 @class IGListSectionController;
 @protocol IGListDiffable;
 
@@ -29,15 +30,39 @@ IGLK_SUBCLASSING_RESTRICTED
 @interface IGListSectionMap : NSObject <NSCopying>
 
 /**
- @param mapTable Table used to keep a relationship between the object and its section-controller
+ @param mapTable Table whose key pointer functions decide how objects are looked up, e.g. by `-diffIdentifier`. Its
+ entries are not used.
  */
 - (instancetype)initWithMapTable:(NSMapTable<id<IGListDiffable>, IGListSectionController *> *)mapTable NS_DESIGNATED_INITIALIZER;
 
+/**
+ Creates a map of objects and section controllers that looks objects up like another map. Unlike
+ `-updateWithObjects:sectionControllers:`, it leaves the sections of the section controllers untouched, so it can hold
+ an earlier state of `map` without sharing its storage.
+
+ @param objects The objects in the collection.
+ @param sectionControllers The section controllers that map to each object.
+ @param map The map whose lookup of objects to use.
+ */
+- (instancetype)initWithObjects:(NSArray<id<IGListDiffable>> *)objects
+             sectionControllers:(NSArray<IGListSectionController *> *)sectionControllers
+                    lookupOfMap:(IGListSectionMap *)map NS_DESIGNATED_INITIALIZER;
+
 /**
  The objects stored in the map.
  */
 @property (nonatomic, strong, readonly) NSArray<id<IGListDiffable>> *objects;
 
+/**
+ The number of objects stored in the map, without copying them like `objects` does.
+ */
+@property (nonatomic, assign, readonly) NSInteger sectionCount;
+
+/**
+ The section controllers stored in the map, in section order.
+ */
+@property (nonatomic, strong, readonly) NSArray<IGListSectionController *> *sectionControllers;
+
 /**
  Update the map with objects and the section controller counterparts.
 
@@ -46,6 +71,23 @@ IGLK_SUBCLASSING_RESTRICTED
  */
 - (void)updateWithObjects:(NSArray<id<IGListDiffable>> *)objects sectionControllers:(NSArray<IGListSectionController *> *)sectionControllers;
 
+/**
+ Update the map with objects and the section controller counterparts, given the diff from the objects of the map.
+
+ Only the sections from the first inserted, deleted or moved one are updated, so an insert at the end of a long list
+ does not touch the sections before it. Falls back to `-updateWithObjects:sectionControllers:` if the diff is not from
+ the objects of the map.
+
+ @param objects The objects in the collection.
+ @param sectionControllers The section controllers that map to each object.
+ @param fromObjects The objects the diff is from.
+ @param diffResult The diff from `fromObjects` to `objects`, with objects looked up by `-diffIdentifier`.
+ */
+- (void)updateWithObjects:(NSArray<id<IGListDiffable>> *)objects
+       sectionControllers:(NSArray<IGListSectionController *> *)sectionControllers
+              fromObjects:(NSArray<id<IGListDiffable>> *)fromObjects
+               diffResult:(IGListIndexSetResult *)diffResult;
+
 /**
  Fetch a section controller given a section.
 
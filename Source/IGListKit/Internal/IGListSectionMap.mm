@@ -0,0 +1,513 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "IGListSectionMap.h"
+
+#import <memory>
+#import <vector>
+
+#if !__has_include(<IGListDiffKit/IGListDiffKit.h>)
+#import "IGListAssert.h"
+#import "IGListIndexSetResult.h"
+#import "IGListMoveIndex.h"
+#else
+#import <IGListDiffKit/IGListAssert.h>
+#import <IGListDiffKit/IGListIndexSetResult.h>
+#import <IGListDiffKit/IGListMoveIndex.h>
+#endif
+
+#import "IGListSectionControllerInternal.h"
+#import "IGListSectionLookupTable.h"
+
+typedef NSUInteger (*IGListSectionMapHashFunction)(const void *item, NSUInteger (*size)(const void *item));
+typedef BOOL (*IGListSectionMapIsEqualFunction)(const void *item1, const void *item2, NSUInteger (*size)(const void *item));
+typedef NSUInteger (*IGListSectionMapSizeFunction)(const void *item);
+
+// the lookup of NSMapTable's object personality, for pointer functions that do not expose theirs
+static NSUInteger IGListSectionMapObjectHash(const void *item, NSUInteger (*size)(const void *item)) {
+    return [(__bridge id)item hash];
+}
+
+static BOOL IGListSectionMapObjectIsEqual(const void *item1, const void *item2, NSUInteger (*size)(const void *item)) {
+    return [(__bridge id)item1 isEqual:(__bridge id)item2];
+}
+
+static std::size_t IGListSectionMapPointerHash(__unsafe_unretained id object) {
+    return (std::size_t)(__bridge void *)object;
+}
+
+/**
+ Everything a copy of the map shares until one of them writes.
+ */
+struct IGListSectionMapStorage {
+    // owns the section controllers of `sectionControllers`
+    NSArray<IGListSectionController *> *sectionControllersArray;
+    // indexed by section, without retaining them so that copying the storage only copies pointers
+    std::vector<__unsafe_unretained IGListSectionController *> sectionControllers;
+    // the hash of the object of each section, so that replacing it does not hash the previous object again
+    std::vector<NSUInteger> objectHashes;
+    IGListSectionLookupTable objectSections;
+    IGListSectionLookupTable sectionControllerSections;
+    NSMutableArray<id<NSObject>> *diffIdentifiersSnapshot;
+};
+
+@interface IGListSectionMap ()
+
+@property (nonatomic, strong, nullable) NSMutableArray<id<NSObject>> *diffIdentifiersSnapshot;
+
+- (instancetype)initWithStorageOfMap:(IGListSectionMap *)map NS_DESIGNATED_INITIALIZER;
+
+@end
+
+/**
+ Lookups go through flat hash tables over the cached hashes of the objects and the addresses of the section controllers,
+ and sections index a vector of section controllers, so none of them box indexes and only looking up an object hashes
+ it.
+
+ The storage is copy-on-write: `objects` and `-copy` share it instead of copying it, and the first write after sharing
+ copies only what it changes.
+ */
+@implementation IGListSectionMap {
+    // an NSMutableArray when _objectsUnique is YES, otherwise possibly shared with readers of `objects` and other maps
+    NSArray<id<IGListDiffable>> *_objects;
+    BOOL _objectsUnique;
+    // shared with copies of the map, which is unique when it is its only owner
+    std::shared_ptr<IGListSectionMapStorage> _storage;
+
+    // the lookup of the key pointer functions of the map table the map was created with
+    IGListSectionMapHashFunction _hashFunction;
+    IGListSectionMapIsEqualFunction _isEqualFunction;
+    IGListSectionMapSizeFunction _sizeFunction;
+}
+
+- (instancetype)initWithMapTable:(NSMapTable<id<IGListDiffable>, IGListSectionController *> *)mapTable {
+  IGParameterAssert(mapTable != nil);
+  
+  if (self = [super init]) {
+    NSPointerFunctions *keyFunctions = mapTable.keyPointerFunctions;
+    if (keyFunctions.hashFunction != NULL && keyFunctions.isEqualFunction != NULL) {
+      _hashFunction = keyFunctions.hashFunction;
+      _isEqualFunction = keyFunctions.isEqualFunction;
+      _sizeFunction = keyFunctions.sizeFunction;
+    } else {
+      _hashFunction = IGListSectionMapObjectHash;
+      _isEqualFunction = IGListSectionMapObjectIsEqual;
+    }
+
+    _objects = @[];
+    _storage = std::make_shared<IGListSectionMapStorage>();
+  }
+  return self;
+}
+
+- (instancetype)initWithObjects:(NSArray<id<IGListDiffable>> *)objects
+             sectionControllers:(NSArray<IGListSectionController *> *)sectionControllers
+                    lookupOfMap:(IGListSectionMap *)map {
+    IGParameterAssert(objects.count == sectionControllers.count);
+    IGParameterAssert(map != nil);
+
+    if (self = [super init]) {
+        _hashFunction = map->_hashFunction;
+        _isEqualFunction = map->_isEqualFunction;
+        _sizeFunction = map->_sizeFunction;
+
+        _objects = [objects copy];
+        _storage = std::make_shared<IGListSectionMapStorage>();
+        [self _updateAllDiffIdentifiers];
+        [self _fillStorageWithSectionControllers:sectionControllers];
+    }
+    return self;
+}
+
+
+#pragma mark - Public API
+
+- (NSArray<id<IGListDiffable>> *)objects {
+    // the caller keeps this array, so the next write copies it
+    _objectsUnique = NO;
+    return _objects;
+}
+
+- (NSInteger)sectionCount {
+    return (NSInteger)_objects.count;
+}
+
+- (NSArray<IGListSectionController *> *)sectionControllers {
+    return _storage->sectionControllersArray ?: @[];
+}
+
+- (NSInteger)sectionForSectionController:(IGListSectionController *)sectionController {
+    IGParameterAssert(sectionController != nil);
+
+    const std::vector<__unsafe_unretained IGListSectionController *> &sectionControllers = _storage->sectionControllers;
+    const std::size_t section = _storage->sectionControllerSections.find(IGListSectionMapPointerHash(sectionController), [&](std::size_t candidate) {
+        return sectionControllers[candidate] == sectionController;
+    });
+    return section != IGListSectionLookupTable::notFound ? (NSInteger)section : NSNotFound;
+}
+
+- (IGListSectionController *)sectionControllerForSection:(NSInteger)section {
+    const std::vector<__unsafe_unretained IGListSectionController *> &sectionControllers = _storage->sectionControllers;
+    if (section < 0 || (std::size_t)section >= sectionControllers.size()) {
+        return nil;
+    }
+    return sectionControllers[section];
+}
+
+- (void)updateWithObjects:(NSArray<id<IGListDiffable>> *)objects sectionControllers:(NSArray<IGListSectionController *> *)sectionControllers {
+    IGParameterAssert(objects.count == sectionControllers.count);
+
+    [self reset];
+
+    [self _validateAllDiffIdentifiers];
+    // free for the immutable arrays of the updater
+    _objects = [objects copy];
+    _objectsUnique = NO;
+    [self _updateAllDiffIdentifiers];
+
+    // -reset left the storage unique and empty
+    [self _fillStorageWithSectionControllers:sectionControllers];
+
+    id firstObject = objects.firstObject;
+    id lastObject = objects.lastObject;
+
+    NSUInteger idx = 0;
+    for (id object in objects) {
+        // set the index of the list for easy reverse lookup
+        __unsafe_unretained IGListSectionController *sectionController = _storage->sectionControllers[idx];
+        sectionController.isFirstSection = (object == firstObject);
+        sectionController.isLastSection = (object == lastObject);
+        sectionController.section = (NSInteger)idx;
+        idx++;
+    }
+}
+
+- (void)updateWithObjects:(NSArray<id<IGListDiffable>> *)objects
+       sectionControllers:(NSArray<IGListSectionController *> *)sectionControllers
+              fromObjects:(NSArray<id<IGListDiffable>> *)fromObjects
+               diffResult:(IGListIndexSetResult *)diffResult {
+    IGParameterAssert(objects.count == sectionControllers.count);
+    IGParameterAssert(diffResult != nil);
+
+    const NSUInteger oldCount = _objects.count;
+    const NSUInteger newCount = objects.count;
+    // the diff has to be from the objects of the map, which the adapter passes without copying them
+    if (fromObjects != _objects || oldCount - diffResult.deletes.count + diffResult.inserts.count != newCount) {
+        [self updateWithObjects:objects sectionControllers:sectionControllers];
+        return;
+    }
+
+    // sections before the first change keep their object identity, section controller and index
+    NSUInteger firstChange = MIN(MIN(diffResult.inserts.firstIndex, diffResult.deletes.firstIndex), newCount);
+    for (IGListMoveIndex *move in diffResult.moves) {
+        firstChange = MIN(firstChange, (NSUInteger)MIN(move.from, move.to));
+    }
+    // an updated object gets a new section controller if its class changed
+    NSIndexSet *updates = diffResult.updates;
+    for (NSUInteger section = updates.firstIndex; section < firstChange; section = [updates indexGreaterThanIndex:section]) {
+        if (_storage->sectionControllers[section] != sectionControllers[section]) {
+            firstChange = section;
+        }
+    }
+
+    [self _validateAllDiffIdentifiers];
+    [self _ensureUniqueStorage];
+    IGListSectionMapStorage &storage = *_storage;
+    NSArray<IGListSectionController *> *oldSectionControllersArray = storage.sectionControllersArray;
+    storage.sectionControllersArray = [sectionControllers copy];
+
+    __unsafe_unretained IGListSectionController *oldFirst = oldCount > 0 ? storage.sectionControllers.front() : nil;
+    __unsafe_unretained IGListSectionController *oldLast = oldCount > 0 ? storage.sectionControllers.back() : nil;
+
+    // the objects that stay keep their section controller, so their hashes are found without hashing them again
+    std::vector<NSUInteger> hashes;
+    hashes.reserve(newCount - firstChange);
+    for (NSUInteger section = firstChange; section < newCount; section++) {
+        __unsafe_unretained IGListSectionController *sectionController = storage.sectionControllersArray[section];
+        const std::size_t oldSection = storage.sectionControllerSections.find(IGListSectionMapPointerHash(sectionController), [&](std::size_t candidate) {
+            return storage.sectionControllers[candidate] == sectionController;
+        });
+        hashes.push_back(oldSection != IGListSectionLookupTable::notFound
+                         ? storage.objectHashes[oldSection]
+                         : _hashFunction((__bridge void *)objects[section], _sizeFunction));
+    }
+
+    [diffResult.deletes enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop) {
+        IGListSectionController *sectionController = oldSectionControllersArray[section];
+        sectionController.section = NSNotFound;
+        sectionController.isFirstSection = NO;
+        sectionController.isLastSection = NO;
+    }];
+
+    for (NSUInteger section = firstChange; section < oldCount; section++) {
+        storage.objectSections.erase(storage.objectHashes[section], section);
+        storage.sectionControllerSections.erase(IGListSectionMapPointerHash(storage.sectionControllers[section]), section);
+    }
+    storage.objectHashes.resize(firstChange);
+    storage.sectionControllers.resize(firstChange);
+
+    _objects = [objects copy];
+    _objectsUnique = NO;
+    [self _updateAllDiffIdentifiers];
+
+    for (NSUInteger section = firstChange; section < newCount; section++) {
+        __unsafe_unretained id object = _objects[section];
+        __unsafe_unretained IGListSectionController *sectionController = storage.sectionControllersArray[section];
+        const NSUInteger hash = hashes[section - firstChange];
+        storage.objectHashes.push_back(hash);
+        storage.objectSections.insert(hash, section, [&](std::size_t candidate) {
+            return [self _object:object isEqualToObjectAtSection:candidate];
+        });
+        storage.sectionControllers.push_back(sectionController);
+        storage.sectionControllerSections.insert(IGListSectionMapPointerHash(sectionController), section, [&](std::size_t candidate) {
+            return storage.sectionControllers[candidate] == sectionController;
+        });
+        sectionController.section = (NSInteger)section;
+    }
+
+    oldFirst.isFirstSection = NO;
+    oldLast.isLastSection = NO;
+    if (newCount > 0) {
+        storage.sectionControllers.front().isFirstSection = YES;
+        storage.sectionControllers.back().isLastSection = YES;
+    }
+}
+
+- (nullable IGListSectionController *)sectionControllerForObject:(id<IGListDiffable>)object {
+    IGParameterAssert(object != nil);
+
+    return [self sectionControllerForSection:[self sectionForObject:object]];
+}
+
+- (nullable id<IGListDiffable>)objectForSection:(NSInteger)section {
+    if (section < 0) {
+        return nil;
+    }
+
+    NSArray *objects = _objects;
+    if ((NSUInteger)section >= objects.count) {
+        return nil;
+    }
+
+    return objects[section];
+}
+
+- (NSInteger)sectionForObject:(id<IGListDiffable>)object {
+    if (object == nil) {
+        return NSNotFound;
+    }
+
+    const NSUInteger hash = _hashFunction((__bridge void *)object, _sizeFunction);
+    const std::size_t section = _storage->objectSections.find(hash, [&](std::size_t candidate) {
+        return [self _object:object isEqualToObjectAtSection:candidate];
+    });
+    return section != IGListSectionLookupTable::notFound ? (NSInteger)section : NSNotFound;
+}
+
+- (void)reset {
+    [self enumerateUsingBlock:^(id  _Nonnull object, IGListSectionController * _Nonnull sectionController, NSInteger section, BOOL * _Nonnull stop) {
+        sectionController.section = NSNotFound;
+        sectionController.isFirstSection = NO;
+        sectionController.isLastSection = NO;
+    }];
+
+    if (_storage.use_count() == 1) {
+        IGListSectionMapStorage &storage = *_storage;
+        storage.sectionControllersArray = nil;
+        storage.sectionControllers.clear();
+        storage.objectHashes.clear();
+        storage.objectSections.clear();
+        storage.sectionControllerSections.clear();
+    } else {
+        // leave the shared storage to the copy, without copying its entries only to remove them
+        NSMutableArray<id<NSObject>> *diffIdentifiersSnapshot = _storage->diffIdentifiersSnapshot;
+        _storage = std::make_shared<IGListSectionMapStorage>();
+        _storage->diffIdentifiersSnapshot = [diffIdentifiersSnapshot mutableCopy];
+    }
+}
+
+- (void)updateObject:(id<IGListDiffable>)object {
+    IGParameterAssert(object != nil);
+    const NSInteger section = [self sectionForObject:object];
+
+    [self _validateDiffIdentifierAtSection:section];
+    if (!_objectsUnique) {
+        _objects = [_objects mutableCopy];
+        _objectsUnique = YES;
+    }
+    // throws before touching the storage if the object is not in the map
+    ((NSMutableArray *)_objects)[section] = object;
+
+    [self _ensureUniqueStorage];
+    IGListSectionMapStorage &storage = *_storage;
+    const NSUInteger hash = _hashFunction((__bridge void *)object, _sizeFunction);
+    storage.objectSections.erase(storage.objectHashes[section], (std::size_t)section);
+    storage.objectHashes[section] = hash;
+    storage.objectSections.insert(hash, (std::size_t)section, [&](std::size_t candidate) {
+        return [self _object:object isEqualToObjectAtSection:candidate];
+    });
+    [self _updateDiffIdentifierAtSection:section newObject:object];
+}
+
+- (void)enumerateUsingBlock:(void (^)(id<IGListDiffable> object, IGListSectionController *sectionController, NSInteger section, BOOL *stop))block {
+    IGParameterAssert(block != nil);
+
+    BOOL stop = NO;
+    // the block can update the map, which then writes to its own copy of the storage
+    const std::shared_ptr<IGListSectionMapStorage> storage = _storage;
+    NSArray *objects = self.objects;
+    for (NSInteger section = 0; section < (NSInteger)storage->sectionControllers.size(); section++) {
+        block(objects[section], storage->sectionControllers[section], section, &stop);
+        if (stop) {
+            break;
+        }
+    }
+}
+
+
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone {
+    IGListSectionMap *copy = [[IGListSectionMap allocWithZone:zone] initWithStorageOfMap:self];
+    if (copy != nil) {
+        _objectsUnique = NO;
+    }
+    return copy;
+}
+
+- (instancetype)initWithStorageOfMap:(IGListSectionMap *)map {
+    if (self = [super init]) {
+        // both maps share everything until one of them writes
+        _objects = map->_objects;
+        _storage = map->_storage;
+        _hashFunction = map->_hashFunction;
+        _isEqualFunction = map->_isEqualFunction;
+        _sizeFunction = map->_sizeFunction;
+    }
+    return self;
+}
+
+#pragma mark - Copy-on-write
+
+- (void)_ensureUniqueStorage {
+    if (_storage.use_count() > 1) {
+        _storage = std::make_shared<IGListSectionMapStorage>(*_storage);
+        _storage->diffIdentifiersSnapshot = [_storage->diffIdentifiersSnapshot mutableCopy];
+    }
+}
+
+- (NSMutableArray<id<NSObject>> *)diffIdentifiersSnapshot {
+    return _storage->diffIdentifiersSnapshot;
+}
+
+- (void)setDiffIdentifiersSnapshot:(NSMutableArray<id<NSObject>> *)diffIdentifiersSnapshot {
+    [self _ensureUniqueStorage];
+    _storage->diffIdentifiersSnapshot = diffIdentifiersSnapshot;
+}
+
+#pragma mark - Lookups
+
+- (void)_fillStorageWithSectionControllers:(NSArray<IGListSectionController *> *)sectionControllers {
+    IGListSectionMapStorage &storage = *_storage;
+    storage.sectionControllersArray = [sectionControllers copy];
+    const NSUInteger count = _objects.count;
+    storage.sectionControllers.reserve(count);
+    storage.objectHashes.reserve(count);
+    storage.objectSections.reserve(count);
+    storage.sectionControllerSections.reserve(count);
+
+    NSUInteger idx = 0;
+    for (id object in _objects) {
+        __unsafe_unretained IGListSectionController *sectionController = storage.sectionControllersArray[idx];
+
+        const NSUInteger hash = _hashFunction((__bridge void *)object, _sizeFunction);
+        storage.objectHashes.push_back(hash);
+        storage.objectSections.insert(hash, idx, [&](std::size_t candidate) {
+            return [self _object:object isEqualToObjectAtSection:candidate];
+        });
+
+        storage.sectionControllers.push_back(sectionController);
+        storage.sectionControllerSections.insert(IGListSectionMapPointerHash(sectionController), idx, [&](std::size_t candidate) {
+            return storage.sectionControllers[candidate] == sectionController;
+        });
+        idx++;
+    }
+}
+
+- (BOOL)_object:(id<IGListDiffable>)object isEqualToObjectAtSection:(std::size_t)section {
+    id<IGListDiffable> other = _objects[section];
+    // the same instance is equal to itself, without asking the pointer functions which could send -diffIdentifier
+    return object == other || _isEqualFunction((__bridge void *)object, (__bridge void *)other, _sizeFunction);
+}
+
+
+#pragma mark - Diff Identifiers validation
+
+#if IG_ASSERTIONS_ENABLED
+static void IGListSectionMapValidateDiffIdentifier(NSUInteger section, NSArray<id<IGListDiffable>> *mObjects, NSArray<id<NSObject>> *_Nullable diffIdentifiersSnapshot) {
+  if (mObjects.count != diffIdentifiersSnapshot.count) {
+    // Don't have an accurate snapshot of the diff identifiers.
+    return;
+  }
+  
+  if (section < 0 || section >= mObjects.count) {
+    return;
+  }
+  
+  id<IGListDiffable> const object = mObjects[section];
+  id<NSObject> const newDiffIdentifier = [object diffIdentifier];
+  id<NSObject> const oldDiffIdentifier = diffIdentifiersSnapshot[section];
+  
+  // Between updates, we don't expect the diffIdentifier to change for the same section. If it does, we lose our ability to find the
+  // corresponding section-controller in `objectToSectionControllerMap` and usually crash. For example:
+  // - Section has suddently 0 items, so batch updates are wrong
+  // - Adapter returns nil cell
+  // The fix is to make sure -diffIdentifier is not mutable. Generally, -diffIdentifier should be pretty simple (like a UUID)
+  // and -isEqualToDiffableObject should be where we compare all other relevant properties to trigger an update.
+  IGAssert([oldDiffIdentifier isEqual:newDiffIdentifier], @"Diff identifier changed for object %@ at section %i, from %@ to %@",
+           NSStringFromClass([(NSObject *)object class]),
+           (unsigned int)section,
+           oldDiffIdentifier,
+           newDiffIdentifier);
+}
+#endif
+
+- (void)_validateAllDiffIdentifiers {
+#if IG_ASSERTIONS_ENABLED
+  for (NSUInteger section = 0; section < _objects.count; section++) {
+    IGListSectionMapValidateDiffIdentifier(section, _objects, _storage->diffIdentifiersSnapshot);
+  }
+#endif
+}
+
+- (void)_validateDiffIdentifierAtSection:(NSInteger)section {
+#if IG_ASSERTIONS_ENABLED
+  IGListSectionMapValidateDiffIdentifier(section, _objects, _storage->diffIdentifiersSnapshot);
+#endif
+}
+
+- (void)_updateAllDiffIdentifiers {
+#if IG_ASSERTIONS_ENABLED
+  IGListSectionMapStorage &storage = *_storage;
+  if (!storage.diffIdentifiersSnapshot) {
+    storage.diffIdentifiersSnapshot = [NSMutableArray new];
+  }
+  
+  [storage.diffIdentifiersSnapshot removeAllObjects];
+  for (id<IGListDiffable> object in _objects) {
+    [storage.diffIdentifiersSnapshot addObject:[object diffIdentifier]];
+  }
+#endif
+}
+
+- (void)_updateDiffIdentifierAtSection:(NSInteger)section newObject:(id<IGListDiffable>)newObject {
+#if IG_ASSERTIONS_ENABLED
+  _storage->diffIdentifiersSnapshot[section] = newObject.diffIdentifier;
+#endif
+}
+
+@end
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ A persisted list of item sizes, used to skip measuring on the first layout pass after a launch.
+
+ File layout, in host byte order:
+   IGListSizeSnapshotHeader
+   IGListSizeSnapshotEntry[entryCount], sorted by (identifierHash, index, containerWidth)
+
+ A file with a different magic (including a byte-swapped one), version, length or checksum is rejected.
+ */
+
+static const uint32_t IGListSizeSnapshotMagic = 0x534c4749; // "IGLS"
+// 2: identifier hashes include the type of the identifier
+static const uint32_t IGListSizeSnapshotVersion = 2;
+
+struct IGListSizeSnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t entryCount;
+    // IGListSizeSnapshotHash of the entries
+    uint64_t checksum;
+};
+
+struct IGListSizeSnapshotEntry {
+    // stable hash of the diffIdentifier of the object
+    uint64_t identifierHash;
+    // hash of everything that affects the size of the object, provided by the object
+    uint64_t contentHash;
+    uint32_t index;
+    float containerWidth;
+    float width;
+    float height;
+};
+
+static_assert(sizeof(IGListSizeSnapshotHeader) == 24, "snapshot header layout changed, bump IGListSizeSnapshotVersion");
+static_assert(sizeof(IGListSizeSnapshotEntry) == 32, "snapshot entry layout changed, bump IGListSizeSnapshotVersion");
+
+/// 64-bit FNV-1a. Stable across processes and platforms, which std::hash is not.
+inline uint64_t IGListSizeSnapshotHash(const void *bytes, std::size_t length, uint64_t hash = 14695981039346656037ULL) {
+    const unsigned char *p = static_cast<const unsigned char *>(bytes);
+    for (std::size_t i = 0; i < length; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline bool IGListSizeSnapshotEntryKeyLess(const IGListSizeSnapshotEntry &lhs, const IGListSizeSnapshotEntry &rhs) {
+    if (lhs.identifierHash != rhs.identifierHash) {
+        return lhs.identifierHash < rhs.identifierHash;
+    }
+    if (lhs.index != rhs.index) {
+        return lhs.index < rhs.index;
+    }
+    return lhs.containerWidth < rhs.containerWidth;
+}
+
+inline bool IGListSizeSnapshotEntryKeyEqual(const IGListSizeSnapshotEntry &lhs, const IGListSizeSnapshotEntry &rhs) {
+    return lhs.identifierHash == rhs.identifierHash
+    && lhs.index == rhs.index
+    && lhs.containerWidth == rhs.containerWidth;
+}
+
+/**
+ Collects sizes and serializes them. Adding an entry with the key of an existing entry replaces it, so measuring the
+ same items again while scrolling does not grow the writer. Entries of objects that leave the list have to be removed
+ with `removeIdentifier` or `pruneToIdentifiers`.
+ */
+class IGListSizeSnapshotWriter {
+public:
+    void add(const IGListSizeSnapshotEntry &entry) {
+        _entries[Key(entry.identifierHash, entry.index, entry.containerWidth)] = entry;
+    }
+
+    /// Adds an entry only if there is no entry with its key yet.
+    void insert(const IGListSizeSnapshotEntry &entry) {
+        _entries.insert(std::make_pair(Key(entry.identifierHash, entry.index, entry.containerWidth), entry));
+    }
+
+    /// Removes every entry of an identifier.
+    void removeIdentifier(uint64_t identifierHash) {
+        auto it = _entries.lower_bound(Key(identifierHash, 0, -std::numeric_limits<float>::infinity()));
+        while (it != _entries.end() && std::get<0>(it->first) == identifierHash) {
+            it = _entries.erase(it);
+        }
+    }
+
+    /// Removes every entry whose identifier is not in `identifierHashes`.
+    void pruneToIdentifiers(const std::set<uint64_t> &identifierHashes) {
+        auto it = _entries.begin();
+        while (it != _entries.end()) {
+            if (identifierHashes.count(std::get<0>(it->first)) == 0) {
+                it = _entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::size_t count() const {
+        return _entries.size();
+    }
+
+    std::vector<uint8_t> serialize() const {
+        // the keys order entries like IGListSizeSnapshotEntryKeyLess
+        std::vector<IGListSizeSnapshotEntry> unique;
+        unique.reserve(_entries.size());
+        for (const auto &keyAndEntry : _entries) {
+            unique.push_back(keyAndEntry.second);
+        }
+
+        const std::size_t entriesLength = unique.size() * sizeof(IGListSizeSnapshotEntry);
+        IGListSizeSnapshotHeader header;
+        header.magic = IGListSizeSnapshotMagic;
+        header.version = IGListSizeSnapshotVersion;
+        header.entryCount = unique.size();
+        header.checksum = IGListSizeSnapshotHash(unique.data(), entriesLength);
+
+        std::vector<uint8_t> data(sizeof(header) + entriesLength);
+        std::memcpy(data.data(), &header, sizeof(header));
+        if (entriesLength > 0) {
+            std::memcpy(data.data() + sizeof(header), unique.data(), entriesLength);
+        }
+        return data;
+    }
+
+    /// Writes to a temporary file and renames it, so a reader never sees a partially written snapshot.
+    bool writeToFile(const std::string &path) const {
+        const std::vector<uint8_t> data = serialize();
+        const std::string temporaryPath = path + ".tmp";
+        FILE *file = std::fopen(temporaryPath.c_str(), "wb");
+        if (file == nullptr) {
+            return false;
+        }
+        const bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+        const bool closed = std::fclose(file) == 0;
+        if (!written || !closed || std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+private:
+    // identifier hash, item index, container width
+    typedef std::tuple<uint64_t, uint32_t, float> Key;
+
+    std::map<Key, IGListSizeSnapshotEntry> _entries;
+};
+
+/**
+ A read-only snapshot. Files are memory-mapped, so opening one only touches the pages that lookups read plus one pass
+ to validate the checksum.
+ */
+class IGListSizeSnapshot {
+public:
+    /// Returns nullptr if the file does not exist or is not a valid snapshot.
+    static std::unique_ptr<IGListSizeSnapshot> openFile(const std::string &path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return nullptr;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(IGListSizeSnapshotHeader)) {
+            ::close(fd);
+            return nullptr;
+        }
+        const std::size_t length = (std::size_t)info.st_size;
+        void *mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            return nullptr;
+        }
+        std::unique_ptr<IGListSizeSnapshot> snapshot(new IGListSizeSnapshot(static_cast<const uint8_t *>(mapping), length, mapping));
+        return snapshot->_isValid() ? std::move(snapshot) : nullptr;
+    }
+
+    /// Returns nullptr if `data` is not a valid snapshot.
+    static std::unique_ptr<IGListSizeSnapshot> fromData(std::vector<uint8_t> data) {
+        std::unique_ptr<IGListSizeSnapshot> snapshot(new IGListSizeSnapshot(std::move(data)));
+        return snapshot->_isValid() ? std::move(snapshot) : nullptr;
+    }
+
+    ~IGListSizeSnapshot() {
+        if (_mapping != nullptr) {
+            ::munmap(_mapping, _length);
+        }
+    }
+
+    IGListSizeSnapshot(const IGListSizeSnapshot &) = delete;
+    IGListSizeSnapshot &operator=(const IGListSizeSnapshot &) = delete;
+
+    std::size_t count() const {
+        return _count;
+    }
+
+    const IGListSizeSnapshotEntry &entryAtIndex(std::size_t index) const {
+        return _entries()[index];
+    }
+
+    /// Finds the size stored for a key. Entries whose content hash differs are treated as missing.
+    bool find(uint64_t identifierHash, uint32_t index, float containerWidth, uint64_t contentHash, float *width, float *height) const {
+        IGListSizeSnapshotEntry key;
+        key.identifierHash = identifierHash;
+        key.index = index;
+        key.containerWidth = containerWidth;
+
+        const IGListSizeSnapshotEntry *begin = _entries();
+        const IGListSizeSnapshotEntry *end = begin + _count;
+        const IGListSizeSnapshotEntry *match = std::lower_bound(begin, end, key, IGListSizeSnapshotEntryKeyLess);
+        if (match == end || !IGListSizeSnapshotEntryKeyEqual(*match, key) || match->contentHash != contentHash) {
+            return false;
+        }
+        *width = match->width;
+        *height = match->height;
+        return true;
+    }
+
+private:
+    IGListSizeSnapshot(const uint8_t *bytes, std::size_t length, void *mapping)
+    : _bytes(bytes), _length(length), _mapping(mapping), _count(0) {}
+
+    explicit IGListSizeSnapshot(std::vector<uint8_t> data)
+    : _owned(std::move(data)), _bytes(_owned.data()), _length(_owned.size()), _mapping(nullptr), _count(0) {}
+
+    const IGListSizeSnapshotEntry *_entries() const {
+        return reinterpret_cast<const IGListSizeSnapshotEntry *>(_bytes + sizeof(IGListSizeSnapshotHeader));
+    }
+
+    bool _isValid() {
+        if (_length < sizeof(IGListSizeSnapshotHeader)) {
+            return false;
+        }
+        IGListSizeSnapshotHeader header;
+        std::memcpy(&header, _bytes, sizeof(header));
+        if (header.magic != IGListSizeSnapshotMagic || header.version != IGListSizeSnapshotVersion) {
+            return false;
+        }
+        const std::size_t entriesLength = _length - sizeof(header);
+        if (entriesLength % sizeof(IGListSizeSnapshotEntry) != 0
+            || header.entryCount != entriesLength / sizeof(IGListSizeSnapshotEntry)
+            || header.checksum != IGListSizeSnapshotHash(_bytes + sizeof(header), entriesLength)) {
+            return false;
+        }
+        _count = (std::size_t)header.entryCount;
+        return true;
+    }
+
+    std::vector<uint8_t> _owned;
+    const uint8_t *_bytes;
+    std::size_t _length;
+    void *_mapping;
+    std::size_t _count;
+};
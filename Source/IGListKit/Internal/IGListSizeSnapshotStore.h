@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <UIKit/UIKit.h>
+
+#if !__has_include(<IGListDiffKit/IGListDiffKit.h>)
+#import "IGListDiffable.h"
+#import "IGListMacros.h"
+#else
+#import <IGListDiffKit/IGListDiffable.h>
+#import <IGListDiffKit/IGListMacros.h>
+#endif
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Bridges the plain C++ `IGListSizeSnapshot` to the adapter. Loads the sizes persisted by a previous launch, records the
+ sizes measured during this launch, and tracks which loaded sizes still have to be verified against a real measurement.
+
+ Only objects conforming to `IGListSizeSnapshotContent` whose `diffIdentifier` is an `NSString` or `NSNumber` are
+ supported, every other object is ignored.
+ */
+IGLK_SUBCLASSING_RESTRICTED
+@interface IGListSizeSnapshotStore : NSObject
+
+/**
+ Creates a store seeded with the snapshot at `path`.
+
+ @param path The path of a snapshot written by `-writeToFile:`.
+
+ @note The store still records sizes when the file is missing or invalid, see `loaded`.
+ */
+- (instancetype)initWithContentsOfFile:(NSString *)path NS_DESIGNATED_INITIALIZER;
+
+/**
+ `YES` if a valid snapshot was loaded.
+ */
+@property (nonatomic, assign, readonly, getter=isLoaded) BOOL loaded;
+
+/**
+ Looks up a persisted size. A found size is marked as pending verification.
+
+ @param size Filled with the persisted size if one exists.
+ @param object The object powering the section.
+ @param index The index of the item in the section.
+ @param containerWidth The width of the container.
+
+ @return `YES` if a size was found, `NO` otherwise.
+ */
+- (BOOL)getSize:(CGSize *)size forObject:(id<IGListDiffable>)object atIndex:(NSInteger)index containerWidth:(CGFloat)containerWidth;
+
+/**
+ Records a measured size so that it is included in the next written snapshot.
+ */
+- (void)recordSize:(CGSize)size forObject:(id<IGListDiffable>)object atIndex:(NSInteger)index containerWidth:(CGFloat)containerWidth;
+
+/**
+ Clears the pending verification mark of an item.
+
+ @param object The object powering the section.
+ @param index The index of the item in the section.
+ @param snapshotSize Filled with the size returned from the snapshot if the item was pending.
+
+ @return `YES` if the size of the item came from the snapshot and was not verified yet.
+ */
+- (BOOL)consumePendingVerificationForObject:(id<IGListDiffable>)object
+                                    atIndex:(NSInteger)index
+                               snapshotSize:(CGSize *)snapshotSize;
+
+/**
+ Stops returning persisted sizes for an object, e.g. after one of its sizes turned out to be stale. Its recorded sizes
+ are removed too.
+ */
+- (void)invalidateObject:(id<IGListDiffable>)object;
+
+/**
+ Removes the recorded sizes of an object that left the list, so that they are not written to the next snapshot.
+ */
+- (void)removeObject:(id<IGListDiffable>)object;
+
+/**
+ Removes the recorded sizes of every object that is not in `objects`.
+
+ @param objects The objects of the list.
+ */
+- (void)pruneToObjects:(NSArray<id<IGListDiffable>> *)objects;
+
+/**
+ Writes the recorded sizes, along with the persisted sizes that were returned but not verified yet.
+
+ @return `YES` if the snapshot was written.
+ */
+- (BOOL)writeToFile:(NSString *)path;
+
+/**
+ :nodoc:
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ :nodoc:
+ */
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "IGListSizeSnapshotStore.h"
+
+#import <map>
+#import <set>
+#import <utility>
+
+#if !__has_include(<IGListDiffKit/IGListDiffKit.h>)
+#import "IGListAssert.h"
+#else
+#import <IGListDiffKit/IGListAssert.h>
+#endif
+
+#import "IGListSizeSnapshot.h"
+#import "IGListSizeSnapshotContent.h"
+
+// identifier hash, item index
+typedef std::pair<uint64_t, uint32_t> IGListSizeSnapshotItemKey;
+
+static BOOL IGListSizeSnapshotIdentifierHash(id<IGListDiffable> object, uint64_t *hash) {
+    if (![(id)object conformsToProtocol:@protocol(IGListSizeSnapshotContent)]) {
+        return NO;
+    }
+    id diffIdentifier = [object diffIdentifier];
+    NSString *string = nil;
+    // the type is hashed too, so that @1 and @"1" do not share sizes
+    char type;
+    if ([diffIdentifier isKindOfClass:[NSString class]]) {
+        string = diffIdentifier;
+        type = 's';
+    } else if ([diffIdentifier isKindOfClass:[NSNumber class]]) {
+        string = [diffIdentifier stringValue];
+        type = 'n';
+    } else {
+        // -hash of other identifiers is not stable across launches
+        return NO;
+    }
+    const char *bytes = string.UTF8String;
+    *hash = IGListSizeSnapshotHash(bytes, strlen(bytes), IGListSizeSnapshotHash(&type, sizeof(type)));
+    return YES;
+}
+
+@implementation IGListSizeSnapshotStore {
+    std::unique_ptr<IGListSizeSnapshot> _snapshot;
+    IGListSizeSnapshotWriter _writer;
+    // items whose size was returned from the snapshot but not measured yet -> returned entry, carried over to the next
+    // snapshot unless the item is measured first
+    std::map<IGListSizeSnapshotItemKey, IGListSizeSnapshotEntry> _pendingVerification;
+    std::set<uint64_t> _rejectedIdentifiers;
+}
+
+- (instancetype)initWithContentsOfFile:(NSString *)path {
+    IGParameterAssert(path != nil);
+    if (self = [super init]) {
+        _snapshot = IGListSizeSnapshot::openFile(path.fileSystemRepresentation);
+    }
+    return self;
+}
+
+- (BOOL)isLoaded {
+    return _snapshot != nullptr;
+}
+
+- (BOOL)getSize:(CGSize *)size forObject:(id<IGListDiffable>)object atIndex:(NSInteger)index containerWidth:(CGFloat)containerWidth {
+    IGParameterAssert(size != NULL);
+    IGParameterAssert(object != nil);
+
+    uint64_t identifierHash;
+    if (_snapshot == nullptr
+        || !IGListSizeSnapshotIdentifierHash(object, &identifierHash)
+        || _rejectedIdentifiers.count(identifierHash) > 0) {
+        return NO;
+    }
+
+    IGListSizeSnapshotEntry entry;
+    entry.identifierHash = identifierHash;
+    entry.contentHash = [(id<IGListSizeSnapshotContent>)object sizeSnapshotContentHash];
+    entry.index = (uint32_t)index;
+    entry.containerWidth = (float)containerWidth;
+    if (!_snapshot->find(identifierHash, entry.index, entry.containerWidth, entry.contentHash, &entry.width, &entry.height)) {
+        return NO;
+    }
+    *size = CGSizeMake(entry.width, entry.height);
+    _pendingVerification[IGListSizeSnapshotItemKey(identifierHash, entry.index)] = entry;
+    return YES;
+}
+
+- (void)recordSize:(CGSize)size forObject:(id<IGListDiffable>)object atIndex:(NSInteger)index containerWidth:(CGFloat)containerWidth {
+    IGParameterAssert(object != nil);
+
+    uint64_t identifierHash;
+    if (!IGListSizeSnapshotIdentifierHash(object, &identifierHash)) {
+        return;
+    }
+
+    IGListSizeSnapshotEntry entry;
+    entry.identifierHash = identifierHash;
+    entry.contentHash = [(id<IGListSizeSnapshotContent>)object sizeSnapshotContentHash];
+    entry.index = (uint32_t)index;
+    entry.containerWidth = (float)containerWidth;
+    entry.width = (float)size.width;
+    entry.height = (float)size.height;
+    _writer.add(entry);
+}
+
+- (BOOL)consumePendingVerificationForObject:(id<IGListDiffable>)object atIndex:(NSInteger)index snapshotSize:(CGSize *)snapshotSize {
+    IGParameterAssert(object != nil);
+    IGParameterAssert(snapshotSize != NULL);
+
+    uint64_t identifierHash;
+    if (_pendingVerification.empty() || !IGListSizeSnapshotIdentifierHash(object, &identifierHash)) {
+        return NO;
+    }
+    auto it = _pendingVerification.find(IGListSizeSnapshotItemKey(identifierHash, (uint32_t)index));
+    if (it == _pendingVerification.end()) {
+        return NO;
+    }
+    *snapshotSize = CGSizeMake(it->second.width, it->second.height);
+    _pendingVerification.erase(it);
+    return YES;
+}
+
+- (void)invalidateObject:(id<IGListDiffable>)object {
+    IGParameterAssert(object != nil);
+
+    uint64_t identifierHash;
+    if (_snapshot == nullptr || !IGListSizeSnapshotIdentifierHash(object, &identifierHash)) {
+        return;
+    }
+    _rejectedIdentifiers.insert(identifierHash);
+    [self _removeSizesForIdentifierHash:identifierHash];
+}
+
+- (void)removeObject:(id<IGListDiffable>)object {
+    IGParameterAssert(object != nil);
+
+    uint64_t identifierHash;
+    if (IGListSizeSnapshotIdentifierHash(object, &identifierHash)) {
+        [self _removeSizesForIdentifierHash:identifierHash];
+    }
+}
+
+- (void)pruneToObjects:(NSArray<id<IGListDiffable>> *)objects {
+    IGParameterAssert(objects != nil);
+
+    std::set<uint64_t> identifierHashes;
+    for (id<IGListDiffable> object in objects) {
+        uint64_t identifierHash;
+        if (IGListSizeSnapshotIdentifierHash(object, &identifierHash)) {
+            identifierHashes.insert(identifierHash);
+        }
+    }
+    _writer.pruneToIdentifiers(identifierHashes);
+
+    auto it = _pendingVerification.begin();
+    while (it != _pendingVerification.end()) {
+        if (identifierHashes.count(it->first.first) == 0) {
+            it = _pendingVerification.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+- (void)_removeSizesForIdentifierHash:(uint64_t)identifierHash {
+    _writer.removeIdentifier(identifierHash);
+
+    auto it = _pendingVerification.lower_bound(IGListSizeSnapshotItemKey(identifierHash, 0));
+    while (it != _pendingVerification.end() && it->first.first == identifierHash) {
+        it = _pendingVerification.erase(it);
+    }
+}
+
+- (BOOL)writeToFile:(NSString *)path {
+    IGParameterAssert(path != nil);
+
+    // sizes returned from the snapshot but never measured are still the best known sizes of their items
+    IGListSizeSnapshotWriter writer = _writer;
+    for (const auto &keyAndEntry : _pendingVerification) {
+        writer.insert(keyAndEntry.second);
+    }
+    return writer.writeToFile(path.fileSystemRepresentation);
+}
+
+@end
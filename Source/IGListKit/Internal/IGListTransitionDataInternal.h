@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "IGListTransitionData.h"
+
+@class IGListIndexSetResult;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface IGListTransitionData ()
+
+/// The diff from `fromObjects` to `toObjects`, when the updater applies one. Lets the adapter apply only the changes to
+/// its section map.
+@property (nonatomic, strong, nullable) IGListIndexSetResult *diffResult;
+
+@end
+
+NS_ASSUME_NONNULL_END
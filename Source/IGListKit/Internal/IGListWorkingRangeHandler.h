@@ -5,10 +5,15 @@
  * LICENSE file in the root directory of this source tree.
  */
 
-#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
 
 @class IGListAdapter;
 
+/**
+ The scroll velocity, in points per second, from which the working range is entirely ahead of the visible sections.
+ */
+FOUNDATION_EXTERN const CGFloat IGListWorkingRangeFullSkewVelocity;
+
 @interface IGListWorkingRangeHandler : NSObject
 
 /**
@@ -37,4 +42,48 @@
 - (void)didEndDisplayingItemAtIndexPath:(NSIndexPath *)indexPath
                          forListAdapter:(IGListAdapter *)listAdapter;
 
+/**
+ Tells the handler how fast the IGListKit infra scrolls, to lean the working range toward the scroll direction. At
+ `IGListWorkingRangeFullSkewVelocity` or faster, the whole range is ahead of the visible sections; a velocity of 0 makes
+ the range symmetric again. The lead of a range only changes once the velocity is well past the one that rounds to it.
+
+ @param velocity The scroll velocity in points per second, positive toward later sections.
+ @param listAdapter The adapter managing the infra.
+ */
+- (void)updateScrollVelocity:(CGFloat)velocity
+              forListAdapter:(IGListAdapter *)listAdapter;
+
+/**
+ Replaces the additional working range tiers. Section controllers of the previous tiers exit them, and the sections around
+ the visible ones enter the new tiers.
+
+ @param tierSizes The number of sections before and after the viewport in each tier.
+ @param listAdapter The adapter managing the infra.
+ */
+- (void)updateTierSizes:(NSArray<NSNumber *> *)tierSizes
+         forListAdapter:(IGListAdapter *)listAdapter;
+
+/**
+ The number of sections between a section and the closest visible section.
+
+ @param section The section index in the UICollectionView.
+
+ @return 0 for visible sections, `NSNotFound` when no section is visible.
+ */
+- (NSInteger)distanceOfSection:(NSInteger)section;
+
+/**
+ Tells the handler that the objects of the IGListKit infra changed, so the section controllers of the working range are
+ looked up again on the next display event instead of being tracked by section index.
+ */
+- (void)didUpdateSections;
+
+/**
+ Looks up the section controllers of the working ranges again after an update, so the ones that are no longer part of
+ the IGListKit infra exit their ranges before they can be reused.
+
+ @param listAdapter The adapter managing the infra.
+ */
+- (void)exitRemovedSectionControllersForListAdapter:(IGListAdapter *)listAdapter;
+
 @end
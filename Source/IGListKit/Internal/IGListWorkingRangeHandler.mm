@@ -7,27 +7,21 @@
 
 #import "IGListWorkingRangeHandler.h"
 
+#import <deque>
+#import <map>
 #import <set>
+#import <unordered_map>
 #import <unordered_set>
+#import <vector>
 
 #if !__has_include(<IGListDiffKit/IGListDiffKit.h>)
 #import "IGListAssert.h"
 #else
 #import <IGListDiffKit/IGListAssert.h>
 #endif
-#import "IGListAdapter.h"
+#import "IGListAdapterInternal.h"
 #import "IGListSectionController.h"
 
-struct _IGListWorkingRangeHandlerIndexPath {
-    NSInteger section;
-    NSInteger row;
-    size_t hash;
-
-    bool operator==(const _IGListWorkingRangeHandlerIndexPath &other) const {
-        return (section == other.section && row == other.row);
-    }
-};
-
 struct _IGListWorkingRangeHandlerSectionControllerWrapper {
     IGListSectionController *sectionController;
 
@@ -36,35 +30,125 @@ struct _IGListWorkingRangeHandlerSectionControllerWrapper {
     }
 };
 
-struct _IGListWorkingRangeHandlerIndexPathHash {
-    size_t operator()(const _IGListWorkingRangeHandlerIndexPath& o) const {
-        return (size_t)o.hash;
-    }
-};
-
 struct _IGListWorkingRangeHashID {
     size_t operator()(const _IGListWorkingRangeHandlerSectionControllerWrapper &o) const {
         return (size_t)[o.sectionController hash];
     }
 };
 
+const CGFloat IGListWorkingRangeFullSkewVelocity = 4000.0;
+
+// how far past a rounding boundary, in sections, the lead of a tier must be before it changes
+static const CGFloat IGListWorkingRangeLeadHysteresis = 0.25;
+
 typedef std::unordered_set<_IGListWorkingRangeHandlerSectionControllerWrapper, _IGListWorkingRangeHashID> _IGListWorkingRangeSectionControllerSet;
-typedef std::unordered_set<_IGListWorkingRangeHandlerIndexPath, _IGListWorkingRangeHandlerIndexPathHash> _IGListWorkingRangeIndexPathSet;
 
-@interface IGListWorkingRangeHandler ()
+/**
+ A range of sections around the visible ones, along with the section controllers of [start, end) in section order.
+ */
+struct _IGListWorkingRangeTier {
+    NSInteger size;
+    // the number of sections moved from behind the visible sections to ahead of them, in [-size, size]
+    NSInteger lead;
+    NSInteger start;
+    NSInteger end;
+    std::deque<_IGListWorkingRangeHandlerSectionControllerWrapper> sectionControllers;
+};
 
-@property (nonatomic, assign, readonly) NSInteger workingRangeSize;
+// The number of sections between `section` and the closest visible section, 0 for visible sections
+static NSInteger _IGListWorkingRangeDistance(NSInteger section, NSInteger firstVisibleSection, NSInteger lastVisibleSection) {
+    if (section == NSNotFound || firstVisibleSection > lastVisibleSection) {
+        return NSNotFound;
+    }
+    if (section < firstVisibleSection) {
+        return firstVisibleSection - section;
+    }
+    return section > lastVisibleSection ? section - lastVisibleSection : 0;
+}
 
-@end
+// The first tier is the range of `workingRangeSize`, reported through the original callbacks. The others are the tiers of
+// -updateTierSizes:forListAdapter:, reported with their index.
+static void _IGListWorkingRangeNotifyEnter(IGListAdapter *listAdapter,
+                                           IGListSectionController *sectionController,
+                                           size_t tier,
+                                           NSInteger distance) {
+    id <IGListWorkingRangeDelegate> workingRangeDelegate = sectionController.workingRangeDelegate;
+    if (tier == 0) {
+        [workingRangeDelegate listAdapter:listAdapter sectionControllerWillEnterWorkingRange:sectionController];
+    } else if ([workingRangeDelegate respondsToSelector:@selector(listAdapter:sectionController:willEnterWorkingRangeTier:distance:)]) {
+        [workingRangeDelegate listAdapter:listAdapter
+                        sectionController:sectionController
+                willEnterWorkingRangeTier:(NSInteger)tier - 1
+                                 distance:distance];
+    }
+}
+
+/**
+ The items of a visible section within `itemWorkingRangeSize` of its visible items, [start, end).
+ */
+struct _IGListItemWorkingRange {
+    IGListSectionController *sectionController;
+    NSInteger start;
+    NSInteger end;
+};
+
+static void _IGListItemWorkingRangeNotifyEnter(IGListAdapter *listAdapter,
+                                               IGListSectionController *sectionController,
+                                               NSInteger start,
+                                               NSInteger end) {
+    id <IGListWorkingRangeDelegate> workingRangeDelegate = sectionController.workingRangeDelegate;
+    if (start < end && [workingRangeDelegate respondsToSelector:@selector(listAdapter:sectionController:itemsWillEnterWorkingRange:)]) {
+        [workingRangeDelegate listAdapter:listAdapter
+                        sectionController:sectionController
+               itemsWillEnterWorkingRange:NSMakeRange((NSUInteger)start, (NSUInteger)(end - start))];
+    }
+}
+
+static void _IGListItemWorkingRangeNotifyExit(IGListAdapter *listAdapter,
+                                              IGListSectionController *sectionController,
+                                              NSInteger start,
+                                              NSInteger end) {
+    id <IGListWorkingRangeDelegate> workingRangeDelegate = sectionController.workingRangeDelegate;
+    if (start < end && [workingRangeDelegate respondsToSelector:@selector(listAdapter:sectionController:itemsDidExitWorkingRange:)]) {
+        [workingRangeDelegate listAdapter:listAdapter
+                        sectionController:sectionController
+                 itemsDidExitWorkingRange:NSMakeRange((NSUInteger)start, (NSUInteger)(end - start))];
+    }
+}
+
+static void _IGListWorkingRangeNotifyExit(IGListAdapter *listAdapter,
+                                          IGListSectionController *sectionController,
+                                          size_t tier,
+                                          NSInteger distance) {
+    id <IGListWorkingRangeDelegate> workingRangeDelegate = sectionController.workingRangeDelegate;
+    if (tier == 0) {
+        [listAdapter.prefetchScheduler cancelTasksForSectionController:sectionController];
+        [workingRangeDelegate listAdapter:listAdapter sectionControllerDidExitWorkingRange:sectionController];
+    } else if ([workingRangeDelegate respondsToSelector:@selector(listAdapter:sectionController:didExitWorkingRangeTier:distance:)]) {
+        [workingRangeDelegate listAdapter:listAdapter
+                        sectionController:sectionController
+                  didExitWorkingRangeTier:(NSInteger)tier - 1
+                                 distance:distance];
+    }
+}
 
 @implementation IGListWorkingRangeHandler {
-    _IGListWorkingRangeIndexPathSet _visibleSectionIndices;
-    _IGListWorkingRangeSectionControllerSet _workingRangeSectionControllers;
+    // the visible items of every section with at least one, ordered so the first and last section and item are at hand
+    std::map<NSInteger, std::set<NSInteger>> _visibleItemsBySection;
+    // the item working ranges of the visible sections whose section controller has a positive itemWorkingRangeSize
+    std::unordered_map<NSInteger, _IGListItemWorkingRange> _itemWorkingRanges;
+    // the range of `workingRangeSize` first, then the tiers
+    std::vector<_IGListWorkingRangeTier> _tiers;
+    // how far the ranges lean toward the scroll direction, in [-1, 1]
+    CGFloat _scrollSkew;
+    // set when the sections of the adapter changed, so the section controllers of the ranges are looked up again
+    BOOL _needsSectionControllerLookup;
 }
 
 - (instancetype)initWithWorkingRangeSize:(NSInteger)workingRangeSize {
     if (self = [super init]) {
-        _workingRangeSize = workingRangeSize;
+        _tiers.resize(1);
+        _tiers[0].size = workingRangeSize;
     }
     return self;
 }
@@ -74,13 +158,10 @@ typedef std::unordered_set<_IGListWorkingRangeHandlerIndexPath, _IGListWorkingRa
     IGParameterAssert(indexPath != nil);
     IGParameterAssert(listAdapter != nil);
 
-    _visibleSectionIndices.insert({
-        .section = indexPath.section,
-        .row = indexPath.row,
-        .hash = indexPath.hash
-    });
+    _visibleItemsBySection[indexPath.section].insert(indexPath.item);
 
     [self _updateWorkingRangesWithListAdapter:listAdapter];
+    [self _updateItemWorkingRangeOfSection:indexPath.section listAdapter:listAdapter];
 }
 
 - (void)didEndDisplayingItemAtIndexPath:(NSIndexPath *)indexPath
@@ -88,69 +169,282 @@ typedef std::unordered_set<_IGListWorkingRangeHandlerIndexPath, _IGListWorkingRa
     IGParameterAssert(indexPath != nil);
     IGParameterAssert(listAdapter != nil);
 
-    _visibleSectionIndices.erase({
-        .section = indexPath.section,
-        .row = indexPath.row,
-        .hash = indexPath.hash
-    });
+    auto it = _visibleItemsBySection.find(indexPath.section);
+    if (it != _visibleItemsBySection.end()) {
+        it->second.erase(indexPath.item);
+        if (it->second.empty()) {
+            _visibleItemsBySection.erase(it);
+        }
+    }
+
+    [self _updateWorkingRangesWithListAdapter:listAdapter];
+    [self _updateItemWorkingRangeOfSection:indexPath.section listAdapter:listAdapter];
+}
+
+- (void)updateScrollVelocity:(CGFloat)velocity
+              forListAdapter:(IGListAdapter *)listAdapter {
+    IGParameterAssert(listAdapter != nil);
+
+    _scrollSkew = MAX(MIN(velocity / IGListWorkingRangeFullSkewVelocity, 1.0), -1.0);
+    BOOL leadChanged = NO;
+    for (_IGListWorkingRangeTier &tier : _tiers) {
+        // a velocity hovering around a rounding boundary would otherwise move sections in and out of the range
+        const CGFloat targetLead = _scrollSkew * tier.size;
+        if (velocity != 0 && fabs(targetLead - tier.lead) <= 0.5 + IGListWorkingRangeLeadHysteresis) {
+            continue;
+        }
+        const NSInteger lead = (NSInteger)round(targetLead);
+        leadChanged = leadChanged || lead != tier.lead;
+        tier.lead = lead;
+    }
+    if (leadChanged) {
+        [self _updateWorkingRangesWithListAdapter:listAdapter];
+    }
+}
+
+- (void)updateTierSizes:(NSArray<NSNumber *> *)tierSizes
+         forListAdapter:(IGListAdapter *)listAdapter {
+    IGParameterAssert(tierSizes != nil);
+    IGParameterAssert(listAdapter != nil);
+
+    // The sections of the previous tiers exit them before the new tiers are filled
+    const NSInteger firstVisibleSection = _visibleItemsBySection.empty() ? 0 : _visibleItemsBySection.begin()->first;
+    const NSInteger lastVisibleSection = _visibleItemsBySection.empty() ? -1 : _visibleItemsBySection.rbegin()->first;
+    for (size_t tier = 1; tier < _tiers.size(); tier++) {
+        NSInteger section = _tiers[tier].start;
+        for (const _IGListWorkingRangeHandlerSectionControllerWrapper &wrapper : _tiers[tier].sectionControllers) {
+            const NSInteger distance = _IGListWorkingRangeDistance(section++, firstVisibleSection, lastVisibleSection);
+            _IGListWorkingRangeNotifyExit(listAdapter, wrapper.sectionController, tier, distance);
+        }
+    }
+
+    _tiers.resize(1);
+    for (NSNumber *tierSize in tierSizes) {
+        IGAssert(tierSize.integerValue >= 0, @"Working range tier sizes must not be negative, got %@", tierSize);
+        _IGListWorkingRangeTier tier = _IGListWorkingRangeTier();
+        tier.size = MAX(tierSize.integerValue, 0);
+        tier.lead = (NSInteger)round(_scrollSkew * tier.size);
+        _tiers.push_back(tier);
+    }
 
     [self _updateWorkingRangesWithListAdapter:listAdapter];
 }
 
+- (NSInteger)distanceOfSection:(NSInteger)section {
+    if (_visibleItemsBySection.empty()) {
+        return NSNotFound;
+    }
+    return _IGListWorkingRangeDistance(section, _visibleItemsBySection.begin()->first, _visibleItemsBySection.rbegin()->first);
+}
+
+- (void)didUpdateSections {
+    _needsSectionControllerLookup = YES;
+}
+
+- (void)exitRemovedSectionControllersForListAdapter:(IGListAdapter *)listAdapter {
+    IGParameterAssert(listAdapter != nil);
+
+    if (_needsSectionControllerLookup) {
+        [self _updateWorkingRangesWithListAdapter:listAdapter];
+    }
+
+    // Item working ranges are keyed by section, so only drop the ones of section controllers that left the adapter
+    std::vector<_IGListItemWorkingRange> removedItemWorkingRanges;
+    for (auto it = _itemWorkingRanges.begin(); it != _itemWorkingRanges.end();) {
+        if ([listAdapter.sectionMap sectionForSectionController:it->second.sectionController] == NSNotFound) {
+            removedItemWorkingRanges.push_back(it->second);
+            it = _itemWorkingRanges.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (const _IGListItemWorkingRange &range : removedItemWorkingRanges) {
+        _IGListItemWorkingRangeNotifyExit(listAdapter, range.sectionController, range.start, range.end);
+    }
+}
+
 #pragma mark - Working Ranges
 
 - (void)_updateWorkingRangesWithListAdapter:(IGListAdapter *)listAdapter {
     IGAssertMainThread();
     // This method is optimized C++ to improve straight-line speed of these operations. Change at your peril.
 
-    // We use a std::set because it is ordered.
-    std::set<NSInteger> visibleSectionSet = std::set<NSInteger>();
-    for (const _IGListWorkingRangeHandlerIndexPath &indexPath : _visibleSectionIndices) {
-        visibleSectionSet.insert(indexPath.section);
+    // An empty visible range, [0, -1], makes every range empty
+    const NSInteger firstVisibleSection = _visibleItemsBySection.empty() ? 0 : _visibleItemsBySection.begin()->first;
+    const NSInteger lastVisibleSection = _visibleItemsBySection.empty() ? -1 : _visibleItemsBySection.rbegin()->first;
+    const NSInteger sectionCount = listAdapter.sectionMap.sectionCount;
+    const BOOL needsSectionControllerLookup = _needsSectionControllerLookup;
+    _needsSectionControllerLookup = NO;
+
+    // All tiers are updated in one pass over the same visible sections
+    for (size_t tier = 0; tier < _tiers.size(); tier++) {
+        NSInteger start = 0;
+        NSInteger end = 0;
+        if (firstVisibleSection <= lastVisibleSection) {
+            start = MAX(firstVisibleSection - (_tiers[tier].size - _tiers[tier].lead), 0);
+            end = MIN(lastVisibleSection + 1 + _tiers[tier].size + _tiers[tier].lead, sectionCount);
+            end = MAX(end, start);
+        }
+
+        if (needsSectionControllerLookup
+            || start >= _tiers[tier].end
+            || end <= _tiers[tier].start) {
+            // The section indexes of the range can't be trusted after an update, and the ranges don't overlap after e.g.
+            // scrolling to the top, so every section of the range is looked up again
+            if (start != end || _tiers[tier].start != _tiers[tier].end) {
+                [self _lookUpTier:tier
+                      fromSection:start
+                        toSection:end
+              firstVisibleSection:firstVisibleSection
+               lastVisibleSection:lastVisibleSection
+                      listAdapter:listAdapter];
+            }
+        } else if (start != _tiers[tier].start || end != _tiers[tier].end) {
+            // Most display events happen within the range, which then stays the same
+            [self _moveTier:tier
+                fromSection:start
+                  toSection:end
+        firstVisibleSection:firstVisibleSection
+         lastVisibleSection:lastVisibleSection
+                listAdapter:listAdapter];
+        }
     }
+}
 
-    NSInteger start;
-    NSInteger end;
-    if (visibleSectionSet.size() == 0) {
-        // We're now devoid of any visible sections. Bail
-        start = 0;
-        end = 0;
-    } else {
-        start = MAX(*visibleSectionSet.begin() - _workingRangeSize, 0);
-        end = MIN(*visibleSectionSet.rbegin() + 1 + _workingRangeSize, (NSInteger)listAdapter.objects.count);
+// Only looks up and notifies the section controllers of the sections joining or leaving the range
+- (void)_moveTier:(size_t)tier
+        fromSection:(NSInteger)start
+          toSection:(NSInteger)end
+firstVisibleSection:(NSInteger)firstVisibleSection
+ lastVisibleSection:(NSInteger)lastVisibleSection
+        listAdapter:(IGListAdapter *)listAdapter {
+    _IGListWorkingRangeTier &range = _tiers[tier];
+    const NSInteger previousStart = range.start;
+    const NSInteger previousEnd = range.end;
+    range.start = start;
+    range.end = end;
+
+    // Tell the section controllers of the sections joining the range that they have entered the working range
+    for (NSInteger section = previousStart - 1; section >= start; section--) {
+        IGListSectionController *sectionController = [listAdapter.sectionMap sectionControllerForSection:section];
+        range.sectionControllers.push_front({sectionController});
+        _IGListWorkingRangeNotifyEnter(listAdapter, sectionController, tier, _IGListWorkingRangeDistance(section, firstVisibleSection, lastVisibleSection));
     }
+    for (NSInteger section = previousEnd; section < end; section++) {
+        IGListSectionController *sectionController = [listAdapter.sectionMap sectionControllerForSection:section];
+        range.sectionControllers.push_back({sectionController});
+        _IGListWorkingRangeNotifyEnter(listAdapter, sectionController, tier, _IGListWorkingRangeDistance(section, firstVisibleSection, lastVisibleSection));
+    }
+
+    // Tell the section controllers of the sections leaving the range that they have exited the working range
+    for (NSInteger section = previousStart; section < start; section++) {
+        IGListSectionController *sectionController = range.sectionControllers.front().sectionController;
+        range.sectionControllers.pop_front();
+        _IGListWorkingRangeNotifyExit(listAdapter, sectionController, tier, _IGListWorkingRangeDistance(section, firstVisibleSection, lastVisibleSection));
+    }
+    for (NSInteger section = previousEnd - 1; section >= end; section--) {
+        IGListSectionController *sectionController = range.sectionControllers.back().sectionController;
+        range.sectionControllers.pop_back();
+        _IGListWorkingRangeNotifyExit(listAdapter, sectionController, tier, _IGListWorkingRangeDistance(section, firstVisibleSection, lastVisibleSection));
+    }
+}
+
+// Looks up the section controller of every section in the new range and compares them with the previous ones, for
+// when the section indexes of the previous range can't be trusted or don't overlap with the new range.
+- (void)_lookUpTier:(size_t)tier
+        fromSection:(NSInteger)start
+          toSection:(NSInteger)end
+firstVisibleSection:(NSInteger)firstVisibleSection
+ lastVisibleSection:(NSInteger)lastVisibleSection
+        listAdapter:(IGListAdapter *)listAdapter {
+    _IGListWorkingRangeTier &range = _tiers[tier];
 
     // Build the current set of working range section controllers
-    _IGListWorkingRangeSectionControllerSet workingRangeSectionControllers (MAX(visibleSectionSet.size(), 1));
+    std::deque<_IGListWorkingRangeHandlerSectionControllerWrapper> workingRangeSectionControllers;
+    _IGListWorkingRangeSectionControllerSet workingRangeSectionControllerSet(MAX(end - start, 1));
     for (NSInteger idx = start; idx < end; idx++) {
-        id item = [listAdapter objectAtSection:idx];
-        IGListSectionController *sectionController = [listAdapter sectionControllerForObject:item];
-        workingRangeSectionControllers.insert({sectionController});
+        IGListSectionController *sectionController = [listAdapter.sectionMap sectionControllerForSection:idx];
+        workingRangeSectionControllers.push_back({sectionController});
+        workingRangeSectionControllerSet.insert({sectionController});
     }
+    const _IGListWorkingRangeSectionControllerSet previousSectionControllerSet(range.sectionControllers.begin(),
+                                                                               range.sectionControllers.end());
+
+    range.sectionControllers.swap(workingRangeSectionControllers);
+    range.start = start;
+    range.end = end;
 
     // Tell any new section controllers that they have entered the working range
-    for (const _IGListWorkingRangeHandlerSectionControllerWrapper &wrapper : workingRangeSectionControllers) {
+    for (const _IGListWorkingRangeHandlerSectionControllerWrapper &wrapper : workingRangeSectionControllerSet) {
         // Check if the item exists in the old working range item array.
-        auto it = _workingRangeSectionControllers.find(wrapper);
-        if (it == _workingRangeSectionControllers.end()) {
+        auto it = previousSectionControllerSet.find(wrapper);
+        if (it == previousSectionControllerSet.end()) {
             // The section controller isn't in the existing list, so it's new.
-            id <IGListWorkingRangeDelegate> workingRangeDelegate = wrapper.sectionController.workingRangeDelegate;
-            [workingRangeDelegate listAdapter:listAdapter sectionControllerWillEnterWorkingRange:wrapper.sectionController];
+            const NSInteger section = [listAdapter.sectionMap sectionForSectionController:wrapper.sectionController];
+            _IGListWorkingRangeNotifyEnter(listAdapter, wrapper.sectionController, tier, _IGListWorkingRangeDistance(section, firstVisibleSection, lastVisibleSection));
         }
     }
 
     // Tell any removed section controllers that they have exited the working range
-    for (const _IGListWorkingRangeHandlerSectionControllerWrapper &wrapper : _workingRangeSectionControllers) {
+    for (const _IGListWorkingRangeHandlerSectionControllerWrapper &wrapper : previousSectionControllerSet) {
         // Check if the item exists in the new list of section controllers
-        auto it = workingRangeSectionControllers.find(wrapper);
-        if (it == workingRangeSectionControllers.end()) {
+        auto it = workingRangeSectionControllerSet.find(wrapper);
+        if (it == workingRangeSectionControllerSet.end()) {
             // If the item does not exist in the new list, then it's been removed.
-            id <IGListWorkingRangeDelegate> workingRangeDelegate = wrapper.sectionController.workingRangeDelegate;
-            [workingRangeDelegate listAdapter:listAdapter sectionControllerDidExitWorkingRange:wrapper.sectionController];
+            const NSInteger section = [listAdapter.sectionMap sectionForSectionController:wrapper.sectionController];
+            _IGListWorkingRangeNotifyExit(listAdapter, wrapper.sectionController, tier, _IGListWorkingRangeDistance(section, firstVisibleSection, lastVisibleSection));
+        }
+    }
+}
+
+#pragma mark - Item Working Ranges
+
+- (void)_updateItemWorkingRangeOfSection:(NSInteger)section listAdapter:(IGListAdapter *)listAdapter {
+    auto visibleItems = _visibleItemsBySection.find(section);
+    IGListSectionController *sectionController = nil;
+    NSInteger start = 0;
+    NSInteger end = 0;
+    if (visibleItems != _visibleItemsBySection.end()) {
+        sectionController = [listAdapter.sectionMap sectionControllerForSection:section];
+        const NSInteger itemWorkingRangeSize = sectionController.itemWorkingRangeSize;
+        if (itemWorkingRangeSize > 0) {
+            start = MAX(*visibleItems->second.begin() - itemWorkingRangeSize, 0);
+            end = MIN(*visibleItems->second.rbegin() + 1 + itemWorkingRangeSize, [sectionController numberOfItems]);
+            end = MAX(end, start);
         }
     }
 
-    _workingRangeSectionControllers = workingRangeSectionControllers;
+    auto it = _itemWorkingRanges.find(section);
+    if (it != _itemWorkingRanges.end() && (it->second.sectionController != sectionController || start == end)) {
+        // The section isn't visible anymore, or belongs to another section controller after an update
+        const _IGListItemWorkingRange range = it->second;
+        _itemWorkingRanges.erase(it);
+        _IGListItemWorkingRangeNotifyExit(listAdapter, range.sectionController, range.start, range.end);
+        it = _itemWorkingRanges.end();
+    }
+    if (start == end) {
+        return;
+    }
+    if (it == _itemWorkingRanges.end()) {
+        _itemWorkingRanges[section] = {sectionController, start, end};
+        _IGListItemWorkingRangeNotifyEnter(listAdapter, sectionController, start, end);
+        return;
+    }
+
+    const NSInteger previousStart = it->second.start;
+    const NSInteger previousEnd = it->second.end;
+    it->second.start = start;
+    it->second.end = end;
+    if (start >= previousEnd || end <= previousStart) {
+        _IGListItemWorkingRangeNotifyEnter(listAdapter, sectionController, start, end);
+        _IGListItemWorkingRangeNotifyExit(listAdapter, sectionController, previousStart, previousEnd);
+        return;
+    }
+    // Only the items on either side of the overlap enter or exit the range
+    _IGListItemWorkingRangeNotifyEnter(listAdapter, sectionController, start, previousStart);
+    _IGListItemWorkingRangeNotifyEnter(listAdapter, sectionController, previousEnd, end);
+    _IGListItemWorkingRangeNotifyExit(listAdapter, sectionController, previousStart, start);
+    _IGListItemWorkingRangeNotifyExit(listAdapter, sectionController, end, previousEnd);
 }
 
 @end
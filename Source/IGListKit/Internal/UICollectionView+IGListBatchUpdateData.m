@@ -7,6 +7,8 @@
 
 #import "UICollectionView+IGListBatchUpdateData.h"
 
+#import "IGListCollectionViewLayoutCompatible.h"
+
 #if !__has_include(<IGListDiffKit/IGListDiffKit.h>)
 #import "IGListBatchUpdateData.h"
 #else
@@ -16,6 +18,11 @@
 @implementation UICollectionView (IGListBatchUpdateData)
 
 - (void)ig_applyBatchUpdateData:(IGListBatchUpdateData *)updateData {
+    id<IGListCollectionViewLayoutCompatible> layout = (id<IGListCollectionViewLayoutCompatible>)self.collectionViewLayout;
+    if ([layout respondsToSelector:@selector(willApplyBatchUpdateData:)]) {
+        [layout willApplyBatchUpdateData:updateData];
+    }
+
     [self deleteItemsAtIndexPaths:updateData.deleteIndexPaths];
     [self insertItemsAtIndexPaths:updateData.insertIndexPaths];
     [self reloadItemsAtIndexPaths:updateData.updateIndexPaths];
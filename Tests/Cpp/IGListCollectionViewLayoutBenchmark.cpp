@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "IGListLayoutSpanIndex.h"
+#include "IGListSectionLayout.h"
+
+// Measures the passes of IGListCollectionViewLayout on its UIKit-free core, for feeds of 1k, 10k and 100k items:
+// full layouts, layouts invalidated from the top, middle and bottom section, and the rect queries of a scroll at 60 and
+// 120 Hz. Reports latency percentiles and heap allocations per operation. Run through
+// scripts/run_cpp_tests.sh --benchmark, optionally with the largest item count as argument.
+
+static std::atomic<std::size_t> IGListBenchmarkAllocationCount(0);
+static std::atomic<std::size_t> IGListBenchmarkAllocatedBytes(0);
+
+void *operator new(std::size_t size) {
+    IGListBenchmarkAllocationCount++;
+    IGListBenchmarkAllocatedBytes += size;
+    void *pointer = std::malloc(size > 0 ? size : 1);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+struct IGListBenchmarkSamples {
+    std::vector<double> nanoseconds;
+    std::size_t allocationCount;
+    std::size_t allocatedBytes;
+};
+
+// Runs `body` `iterations` times, timing each run and counting the allocations of all of them.
+template <typename Body>
+static IGListBenchmarkSamples measure(std::size_t iterations, Body &&body) {
+    IGListBenchmarkSamples samples;
+    samples.nanoseconds.reserve(iterations);
+    const std::size_t allocationCount = IGListBenchmarkAllocationCount;
+    const std::size_t allocatedBytes = IGListBenchmarkAllocatedBytes;
+    for (std::size_t i = 0; i < iterations; i++) {
+        const auto start = std::chrono::steady_clock::now();
+        body(i);
+        samples.nanoseconds.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+    }
+    // the samples were reserved up front, so the loop only counts the allocations of `body`
+    samples.allocationCount = IGListBenchmarkAllocationCount - allocationCount;
+    samples.allocatedBytes = IGListBenchmarkAllocatedBytes - allocatedBytes;
+    return samples;
+}
+
+static double percentile(const std::vector<double> &sorted, double fraction) {
+    const std::size_t index = (std::size_t)(fraction * (double)(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static void report(const char *name, IGListBenchmarkSamples samples) {
+    std::vector<double> &sorted = samples.nanoseconds;
+    std::sort(sorted.begin(), sorted.end());
+    const double count = (double)sorted.size();
+    std::printf("  %-22s %7zu runs  p50 %9.1f us  p90 %9.1f us  p99 %9.1f us  max %9.1f us  %8.1f allocs/op  %10.0f bytes/op\n",
+                name,
+                sorted.size(),
+                percentile(sorted, 0.5) / 1000,
+                percentile(sorted, 0.9) / 1000,
+                percentile(sorted, 0.99) / 1000,
+                sorted.back() / 1000,
+                (double)samples.allocationCount / count,
+                (double)samples.allocatedBytes / count);
+}
+
+// deterministic so that runs compare
+struct IGListBenchmarkRandom {
+    uint32_t state;
+
+    uint32_t next(uint32_t bound) {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) % bound;
+    }
+};
+
+// a mix of full width rows, grids, columns and items of random widths, some with headers and footers
+static std::vector<IGListSectionLayoutInput> genFeed(std::size_t itemCount) {
+    IGListBenchmarkRandom random{42};
+    std::vector<IGListSectionLayoutInput> inputs;
+    std::size_t generated = 0;
+    while (generated < itemCount) {
+        IGListSectionLayoutInput input = IGListSectionLayoutInput();
+        input.insets = random.next(2) == 0 ? IGListLayoutInsets{0, 0, 0, 0} : IGListLayoutInsets{8, 8, 8, 8};
+        input.lineSpacing = 1;
+        input.interitemSpacing = 1;
+        input.headerSize = random.next(3) == 0 ? IGListLayoutSize{375, 44} : IGListLayoutSize{0, 0};
+        input.footerSize = random.next(8) == 0 ? IGListLayoutSize{375, 20} : IGListLayoutSize{0, 0};
+
+        const double padded = 375 - input.insets.left - input.insets.right;
+        const uint32_t kind = random.next(4);
+        input.columnCount = kind == 3 ? 2 : 0;
+        const std::size_t count = std::min<std::size_t>(1 + random.next(19), itemCount - generated);
+        for (std::size_t item = 0; item < count; item++) {
+            const double width = kind == 0 ? padded : (kind == 1 ? (padded - 2) / 3 : 40 + random.next(200));
+            input.itemSizes.push_back({width, 44.0 + random.next(200)});
+        }
+        generated += count;
+        inputs.push_back(input);
+    }
+    return inputs;
+}
+
+/**
+ The layout pass of IGListCollectionViewLayout without its delegate calls and attributes: sections from the first
+ invalid one are laid out again in place, then the span indexes used by rect queries are rebuilt from there.
+ */
+struct IGListBenchmarkLayout {
+    std::vector<IGListSectionLayoutInput> inputs;
+    IGListLayoutEnvironment environment;
+    IGListLayoutFrameStorage frames;
+    std::vector<IGListSectionLayoutResult> results;
+    IGListLayoutSpanIndex sectionSpans;
+    IGListLayoutSpanIndex itemSpans;
+    IGListLayoutSpanIndexHint sectionHint;
+    IGListLayoutSpanIndexHint itemHint;
+
+    void layoutFromSection(std::size_t firstInvalidSection) {
+        frames.truncateToSection(firstInvalidSection);
+        results.resize(firstInvalidSection);
+        IGListSectionLayoutResult previous = firstInvalidSection > 0 ? results.back() : IGListSectionLayoutResult();
+        for (std::size_t section = firstInvalidSection; section < inputs.size(); section++) {
+            frames.appendSection(inputs[section].itemSizes.size());
+            previous = IGListLayoutSection(inputs[section], section, environment, previous, frames);
+            results.push_back(previous);
+        }
+
+        sectionSpans.truncate(firstInvalidSection);
+        itemSpans.truncate(frames.firstItemIndex(firstInvalidSection));
+        for (std::size_t section = firstInvalidSection; section < inputs.size(); section++) {
+            const IGListLayoutRect &bounds = results[section].bounds;
+            sectionSpans.append(bounds.y, bounds.y + bounds.height);
+            for (std::size_t item = 0; item < frames.itemCount(section); item++) {
+                const IGListLayoutRect frame = frames.frame(section, item);
+                itemSpans.append(frame.y, frame.y + frame.height);
+            }
+        }
+    }
+
+    // the number of sections and items intersecting [start, end), like -layoutAttributesForElementsInRect:
+    std::size_t countElementsInSpan(double start, double end) {
+        std::size_t count = 0;
+        sectionSpans.find(start, end, sectionHint);
+        for (std::size_t section = sectionHint.first; section < sectionHint.last; section++) {
+            const IGListLayoutRect &bounds = results[section].bounds;
+            count += bounds.y + bounds.height > start && bounds.y < end ? 1 : 0;
+        }
+        itemSpans.find(start, end, itemHint);
+        if (itemHint.first == itemHint.last) {
+            return count;
+        }
+        // the layout maps every index to its index path
+        std::size_t section = frames.sectionOfItemIndex(itemHint.first);
+        for (std::size_t index = itemHint.first; index < itemHint.last; index++) {
+            while (index >= frames.firstItemIndex(section + 1)) {
+                section++;
+            }
+            const IGListLayoutRect frame = frames.frameAtIndex(index);
+            count += frame.y + frame.height > start && frame.y < end ? 1 : 0;
+        }
+        return count;
+    }
+
+    double contentHeight() const {
+        return results.empty() ? 0 : results.back().lastNextRowCoordInScrollDirection;
+    }
+};
+
+static void benchmarkFeed(std::size_t itemCount) {
+    IGListBenchmarkLayout layout;
+    layout.inputs = genFeed(itemCount);
+    layout.environment.vertical = true;
+    layout.environment.containerWidth = 375;
+    layout.environment.containerHeight = 812;
+    layout.environment.scale = 3;
+    layout.environment.stretchToEdge = false;
+    layout.environment.showHeaderWhenEmpty = false;
+    layout.sectionHint = {0, 0};
+    layout.itemHint = {0, 0};
+    const std::size_t sectionCount = layout.inputs.size();
+
+    std::printf("%zu items, %zu sections\n", itemCount, sectionCount);
+
+    // the first pass allocates the buffers, later passes of the same content reuse them
+    const std::size_t iterations = std::max<std::size_t>(10, 200000 / itemCount);
+    report("first layout", measure(1, [&](std::size_t) {
+        layout.layoutFromSection(0);
+    }));
+    report("full layout", measure(iterations, [&](std::size_t) {
+        layout.layoutFromSection(0);
+    }));
+
+    // each run changes the size of the first item of the section, then lays out again from it
+    const std::size_t invalidatedSections[] = {0, sectionCount / 2, sectionCount - 1};
+    const char *invalidationNames[] = {"invalidate top", "invalidate middle", "invalidate bottom"};
+    for (std::size_t i = 0; i < 3; i++) {
+        const std::size_t section = invalidatedSections[i];
+        report(invalidationNames[i], measure(iterations * 10, [&](std::size_t run) {
+            IGListLayoutSize &size = layout.inputs[section].itemSizes.front();
+            size.height = 44.0 + (double)(run % 2);
+            layout.layoutFromSection(section);
+        }));
+    }
+
+    // a fling at 4000 pt/s from the top, one query of the visible rect per frame
+    const double viewport = layout.environment.containerHeight;
+    const double maxOffset = std::max(layout.contentHeight() - viewport, 0.0);
+    const double frameRates[] = {60, 120};
+    const char *scrollNames[] = {"scroll queries 60 Hz", "scroll queries 120 Hz"};
+    std::size_t visibleElements = 0;
+    for (std::size_t i = 0; i < 2; i++) {
+        const double step = 4000 / frameRates[i];
+        const std::size_t frameCount = std::min<std::size_t>((std::size_t)(maxOffset / step) + 1, 20000);
+        report(scrollNames[i], measure(frameCount, [&](std::size_t frame) {
+            const double offset = (double)frame * step;
+            visibleElements += layout.countElementsInSpan(offset, offset + viewport);
+        }));
+    }
+    std::printf("  %-22s %.0f pt, %zu elements queried\n\n", "content height", layout.contentHeight(), visibleElements);
+}
+
+int main(int argc, char **argv) {
+    const std::size_t maxItemCount = argc > 1 ? (std::size_t)std::strtoul(argv[1], nullptr, 10) : 100000;
+    for (std::size_t itemCount = 1000; itemCount <= maxItemCount; itemCount *= 10) {
+        benchmarkFeed(itemCount);
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ A minimal test runner for the plain C++ parts of IGListKit, so they can be tested without XCTest (e.g. on Linux).
+ Run through scripts/run_cpp_tests.sh.
+ */
+
+struct IGListCppTestCase {
+    const char *name;
+    std::function<void(bool &)> body;
+};
+
+inline std::vector<IGListCppTestCase> &IGListCppTestCases() {
+    static std::vector<IGListCppTestCase> cases;
+    return cases;
+}
+
+struct IGListCppTestRegistration {
+    IGListCppTestRegistration(const char *name, std::function<void(bool &)> body) {
+        IGListCppTestCases().push_back({name, body});
+    }
+};
+
+#define IGLIST_CPP_TEST(name) \
+    static void name(bool &_passed); \
+    static IGListCppTestRegistration _registration_##name(#name, name); \
+    static void name(bool &_passed)
+
+#define IGLIST_CPP_ASSERT(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: assertion failed: %s\n", __FILE__, __LINE__, #condition); \
+            _passed = false; \
+            return; \
+        } \
+    } while (0)
+
+inline int IGListCppRunTests() {
+    int failures = 0;
+    for (const IGListCppTestCase &testCase : IGListCppTestCases()) {
+        bool passed = true;
+        testCase.body(passed);
+        std::printf("%s %s\n", passed ? "[  OK  ]" : "[FAILED]", testCase.name);
+        failures += passed ? 0 : 1;
+    }
+    std::printf("%zu tests, %d failures\n", IGListCppTestCases().size(), failures);
+    return failures == 0 ? 0 : 1;
+}
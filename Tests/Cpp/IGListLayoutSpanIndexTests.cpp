@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "IGListCppTestHelpers.h"
+
+#include <cstdint>
+
+#include "IGListLayoutFrameStorage.h"
+#include "IGListLayoutSpanIndex.h"
+
+struct IGListTestSpan {
+    double start;
+    double end;
+};
+
+// rows of mixed heights, with an occasional element starting before the previous ones like a section with a smaller inset
+static std::vector<IGListTestSpan> genSpans(std::size_t count, uint32_t seed) {
+    std::vector<IGListTestSpan> spans;
+    uint32_t state = seed;
+    double row = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        state = state * 1664525u + 1013904223u;
+        const double length = 5 + (state >> 8) % 100;
+        const bool newRow = (state >> 4) % 3 != 0;
+        const bool dips = (state >> 12) % 17 == 0;
+        if (newRow) {
+            row += 10 + (state >> 16) % 50;
+        }
+        const double start = dips ? row - 4 : row;
+        spans.push_back({start, start + length});
+    }
+    return spans;
+}
+
+static bool rangeContainsIntersectingSpans(const std::vector<IGListTestSpan> &spans,
+                                           const IGListLayoutSpanIndexHint &range,
+                                           double start,
+                                           double end) {
+    for (std::size_t i = 0; i < spans.size(); i++) {
+        const bool intersects = spans[i].end > start && spans[i].start < end;
+        if (intersects && (i < range.first || i >= range.last)) {
+            std::fprintf(stderr, "span %zu (%.0f, %.0f) intersects (%.0f, %.0f) but is outside [%zu, %zu)\n",
+                         i, spans[i].start, spans[i].end, start, end, range.first, range.last);
+            return false;
+        }
+    }
+    return true;
+}
+
+IGLIST_CPP_TEST(test_whenQueryingScrollingWindows_thatEveryIntersectingSpanIsFound) {
+    const std::vector<IGListTestSpan> spans = genSpans(2000, 7);
+    IGListLayoutSpanIndex index;
+    for (const IGListTestSpan &span : spans) {
+        index.append(span.start, span.end);
+    }
+
+    // scroll down and back up in small steps, reusing the hint like the layout does
+    IGListLayoutSpanIndexHint hint = {0, 0};
+    const double contentEnd = spans.back().end;
+    for (double offset = -50; offset < contentEnd; offset += 13) {
+        index.find(offset, offset + 600, hint);
+        IGLIST_CPP_ASSERT(rangeContainsIntersectingSpans(spans, hint, offset, offset + 600));
+    }
+    for (double offset = contentEnd; offset > -50; offset -= 29) {
+        index.find(offset, offset + 600, hint);
+        IGLIST_CPP_ASSERT(rangeContainsIntersectingSpans(spans, hint, offset, offset + 600));
+    }
+}
+
+IGLIST_CPP_TEST(test_whenQueryingWithStaleHints_thatEveryIntersectingSpanIsFound) {
+    const std::vector<IGListTestSpan> spans = genSpans(500, 3);
+    IGListLayoutSpanIndex index;
+    for (const IGListTestSpan &span : spans) {
+        index.append(span.start, span.end);
+    }
+
+    const std::size_t hints[] = {0, 1, 250, 499, 500, 100000};
+    for (std::size_t first : hints) {
+        for (std::size_t last : hints) {
+            for (double offset = 0; offset < spans.back().end; offset += 211) {
+                IGListLayoutSpanIndexHint hint = {first, last};
+                index.find(offset, offset + 300, hint);
+                IGLIST_CPP_ASSERT(rangeContainsIntersectingSpans(spans, hint, offset, offset + 300));
+            }
+        }
+    }
+}
+
+IGLIST_CPP_TEST(test_whenSpansAreSorted_thatRangeIsExact) {
+    IGListLayoutSpanIndex index;
+    for (int i = 0; i < 10; i++) {
+        index.append(i * 10, i * 10 + 10);
+    }
+    IGListLayoutSpanIndexHint hint = {0, 0};
+    index.find(25, 45, hint);
+    IGLIST_CPP_ASSERT(hint.first == 2 && hint.last == 5);
+
+    // touching edges do not intersect, like CGRectIntersectsRect
+    index.find(30, 40, hint);
+    IGLIST_CPP_ASSERT(hint.first == 3 && hint.last == 4);
+
+    index.find(200, 300, hint);
+    IGLIST_CPP_ASSERT(hint.first == hint.last);
+}
+
+IGLIST_CPP_TEST(test_whenTruncatingAndAppending_thatIndexMatchesRebuiltIndex) {
+    const std::vector<IGListTestSpan> spans = genSpans(300, 11);
+    IGListLayoutSpanIndex index;
+    for (const IGListTestSpan &span : spans) {
+        index.append(span.start, span.end);
+    }
+
+    // drop a deep dip at the end, then rebuild the tail with different spans
+    index.truncate(100);
+    IGLIST_CPP_ASSERT(index.count() == 100);
+    std::vector<IGListTestSpan> rebuilt(spans.begin(), spans.begin() + 100);
+    const std::vector<IGListTestSpan> tail = genSpans(50, 5);
+    for (const IGListTestSpan &span : tail) {
+        const IGListTestSpan shifted = {span.start + spans[99].end, span.end + spans[99].end};
+        index.append(shifted.start, shifted.end);
+        rebuilt.push_back(shifted);
+    }
+
+    IGListLayoutSpanIndexHint hint = {0, 0};
+    for (double offset = 0; offset < rebuilt.back().end; offset += 37) {
+        index.find(offset, offset + 250, hint);
+        IGLIST_CPP_ASSERT(rangeContainsIntersectingSpans(rebuilt, hint, offset, offset + 250));
+    }
+}
+
+IGLIST_CPP_TEST(test_whenIndexIsEmpty_thatRangeIsEmpty) {
+    IGListLayoutSpanIndex index;
+    IGListLayoutSpanIndexHint hint = {4, 9};
+    index.find(0, 100, hint);
+    IGLIST_CPP_ASSERT(hint.first == 0 && hint.last == 0);
+}
+
+IGLIST_CPP_TEST(test_whenFindingSectionOfItemIndex_thatEmptySectionsAreSkipped) {
+    IGListLayoutFrameStorage frames;
+    frames.appendSection(0);
+    frames.appendSection(3);
+    frames.appendSection(0);
+    frames.appendSection(2);
+    IGLIST_CPP_ASSERT(frames.firstItemIndex(3) == 3);
+    IGLIST_CPP_ASSERT(frames.firstItemIndex(4) == 5);
+    IGLIST_CPP_ASSERT(frames.sectionOfItemIndex(0) == 1);
+    IGLIST_CPP_ASSERT(frames.sectionOfItemIndex(2) == 1);
+    IGLIST_CPP_ASSERT(frames.sectionOfItemIndex(3) == 3);
+    IGLIST_CPP_ASSERT(frames.sectionOfItemIndex(4) == 3);
+}
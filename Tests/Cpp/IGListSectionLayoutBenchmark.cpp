@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+
+#include "IGListSectionLayout.h"
+
+// Compares laying out a large feed serially and concurrently. Run through scripts/run_cpp_tests.sh --benchmark.
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void threadedParallelFor(std::size_t count, const std::function<void(std::size_t)> &body) {
+    const std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i = t; i < count; i += threadCount) {
+                body(i);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+int main(int argc, char **argv) {
+    const std::size_t sectionCount = argc > 1 ? (std::size_t)std::strtoul(argv[1], nullptr, 10) : 20000;
+    const std::size_t itemsPerSection = 10;
+
+    IGListLayoutEnvironment environment;
+    environment.vertical = true;
+    environment.containerWidth = 375;
+    environment.containerHeight = 812;
+    environment.scale = 3;
+    environment.stretchToEdge = false;
+    environment.showHeaderWhenEmpty = false;
+
+    // every section has a header and a grid of items
+    std::vector<IGListSectionLayoutInput> inputs(sectionCount);
+    for (std::size_t section = 0; section < sectionCount; section++) {
+        IGListSectionLayoutInput &input = inputs[section];
+        input.headerSize = {375, 44};
+        input.footerSize = {0, 0};
+        input.insets = {0, 0, 8, 0};
+        input.lineSpacing = 1;
+        input.interitemSpacing = 1;
+        for (std::size_t item = 0; item < itemsPerSection; item++) {
+            input.itemSizes.push_back({124, 124 + (double)(section % 5)});
+        }
+    }
+
+    IGListLayoutFrameStorage frames;
+    for (const IGListSectionLayoutInput &input : inputs) {
+        frames.appendSection(input.itemSizes.size());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    IGListSectionLayoutResult cursor = IGListSectionLayoutResult();
+    for (std::size_t section = 0; section < sectionCount; section++) {
+        cursor = IGListLayoutSection(inputs[section], section, environment, cursor, frames);
+    }
+    const double serialTime = millisecondsSince(start);
+    const double serialHeight = cursor.lastNextRowCoordInScrollDirection;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<IGListSectionLayoutResult> results;
+    IGListLayoutSectionsConcurrently(inputs, 0, environment, IGListSectionLayoutResult(), frames, results, threadedParallelFor);
+    const double concurrentTime = millisecondsSince(start);
+
+    std::printf("items:      %zu\n", sectionCount * itemsPerSection);
+    std::printf("threads:    %u\n", std::thread::hardware_concurrency());
+    std::printf("serial:     %.2f ms\n", serialTime);
+    std::printf("concurrent: %.2f ms\n", concurrentTime);
+    return results.back().lastNextRowCoordInScrollDirection == serialHeight ? 0 : 1;
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "IGListCppTestHelpers.h"
+
+#include <cstdint>
+#include <thread>
+
+#include "IGListSectionLayout.h"
+
+// deterministic so that failures reproduce
+struct IGListTestRandom {
+    uint32_t state;
+
+    uint32_t next(uint32_t bound) {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) % bound;
+    }
+};
+
+static IGListLayoutEnvironment genEnvironment(bool vertical, double scale) {
+    IGListLayoutEnvironment environment;
+    environment.vertical = vertical;
+    environment.containerWidth = vertical ? 375 : 10000;
+    environment.containerHeight = vertical ? 10000 : 375;
+    environment.scale = scale;
+    environment.stretchToEdge = false;
+    environment.showHeaderWhenEmpty = false;
+    return environment;
+}
+
+// a mix of full width rows, grids, columns, headers, footers and empty sections
+static std::vector<IGListSectionLayoutInput> genFeed(bool vertical, std::size_t sectionCount, uint32_t seed, bool fractionalInsets) {
+    IGListTestRandom random{seed};
+    std::vector<IGListSectionLayoutInput> inputs(sectionCount);
+    for (IGListSectionLayoutInput &input : inputs) {
+        const double inset = fractionalInsets ? 2.5 : 4;
+        input.insets = random.next(2) == 0 ? IGListLayoutInsets{0, 0, 0, 0} : IGListLayoutInsets{inset, inset, inset, inset};
+        input.lineSpacing = random.next(3);
+        input.interitemSpacing = random.next(3);
+        input.headerSize = random.next(3) == 0 ? IGListLayoutSize{375, 30} : IGListLayoutSize{0, 0};
+        input.footerSize = random.next(5) == 0 ? IGListLayoutSize{375, 10} : IGListLayoutSize{0, 0};
+
+        const double padded = 375 - input.insets.left - input.insets.right;
+        const uint32_t kind = random.next(4);
+        const std::size_t itemCount = kind == 0 ? 0 : 1 + random.next(12);
+        for (std::size_t item = 0; item < itemCount; item++) {
+            const double fixedLength = kind == 1 ? padded : (kind == 2 ? padded / 3 : 40 + random.next(200));
+            const double scrollLength = 20 + random.next(100);
+            input.itemSizes.push_back(vertical ? IGListLayoutSize{fixedLength, scrollLength} : IGListLayoutSize{scrollLength, fixedLength});
+        }
+        input.columnCount = kind == 3 && random.next(2) == 0 ? 1 + random.next(3) : 0;
+    }
+    return inputs;
+}
+
+static std::vector<IGListSectionLayoutResult> layoutSerially(const std::vector<IGListSectionLayoutInput> &inputs,
+                                                             const IGListLayoutEnvironment &environment,
+                                                             IGListLayoutFrameStorage &frames) {
+    std::vector<IGListSectionLayoutResult> results;
+    IGListSectionLayoutResult cursor = IGListSectionLayoutResult();
+    for (std::size_t section = 0; section < inputs.size(); section++) {
+        frames.appendSection(inputs[section].itemSizes.size());
+        cursor = IGListLayoutSection(inputs[section], section, environment, cursor, frames);
+        results.push_back(cursor);
+    }
+    return results;
+}
+
+static void threadedParallelFor(std::size_t count, const std::function<void(std::size_t)> &body) {
+    std::vector<std::thread> threads;
+    const std::size_t threadCount = 4;
+    for (std::size_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i = t; i < count; i += threadCount) {
+                body(i);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+static bool rectsEqual(const IGListLayoutRect &lhs, const IGListLayoutRect &rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.width == rhs.width && lhs.height == rhs.height;
+}
+
+static bool layoutsMatch(bool vertical, double scale, uint32_t seed, bool fractionalInsets) {
+    const IGListLayoutEnvironment environment = genEnvironment(vertical, scale);
+    const std::vector<IGListSectionLayoutInput> inputs = genFeed(vertical, 500, seed, fractionalInsets);
+
+    IGListLayoutFrameStorage serialFrames;
+    const std::vector<IGListSectionLayoutResult> serialResults = layoutSerially(inputs, environment, serialFrames);
+
+    IGListLayoutFrameStorage frames;
+    for (const IGListSectionLayoutInput &input : inputs) {
+        frames.appendSection(input.itemSizes.size());
+    }
+    std::vector<IGListSectionLayoutResult> results;
+    IGListLayoutSectionsConcurrently(inputs, 0, environment, IGListSectionLayoutResult(), frames, results, threadedParallelFor);
+
+    for (std::size_t section = 0; section < inputs.size(); section++) {
+        const IGListSectionLayoutResult &expected = serialResults[section];
+        const IGListSectionLayoutResult &actual = results[section];
+        if (!rectsEqual(expected.bounds, actual.bounds)
+            || !rectsEqual(expected.headerBounds, actual.headerBounds)
+            || !rectsEqual(expected.footerBounds, actual.footerBounds)
+            || expected.lastItemCoordInScrollDirection != actual.lastItemCoordInScrollDirection
+            || expected.lastItemCoordInFixedDirection != actual.lastItemCoordInFixedDirection
+            || expected.lastNextRowCoordInScrollDirection != actual.lastNextRowCoordInScrollDirection) {
+            std::fprintf(stderr, "section %zu differs\n", section);
+            return false;
+        }
+        for (std::size_t item = 0; item < inputs[section].itemSizes.size(); item++) {
+            if (!rectsEqual(serialFrames.frame(section, item), frames.frame(section, item))) {
+                std::fprintf(stderr, "item %zu of section %zu differs\n", item, section);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+IGLIST_CPP_TEST(test_whenLayingOutVerticalFeedConcurrently_thatFramesMatchSerialLayout) {
+    for (uint32_t seed = 1; seed <= 5; seed++) {
+        IGLIST_CPP_ASSERT(layoutsMatch(true, 2, seed, false));
+        IGLIST_CPP_ASSERT(layoutsMatch(true, 3, seed, false));
+    }
+}
+
+IGLIST_CPP_TEST(test_whenLayingOutHorizontalFeedConcurrently_thatFramesMatchSerialLayout) {
+    for (uint32_t seed = 1; seed <= 5; seed++) {
+        IGLIST_CPP_ASSERT(layoutsMatch(false, 2, seed, false));
+    }
+}
+
+IGLIST_CPP_TEST(test_whenInsetsAreNotPixelAligned_thatFramesMatchSerialLayout) {
+    for (uint32_t seed = 1; seed <= 5; seed++) {
+        IGLIST_CPP_ASSERT(layoutsMatch(true, 1, seed, true));
+    }
+}
+
+IGLIST_CPP_TEST(test_whenSectionHasHeader_thatItStartsNewRow) {
+    const IGListLayoutEnvironment environment = genEnvironment(true, 2);
+    IGListSectionLayoutInput input = IGListSectionLayoutInput();
+    input.itemSizes.push_back({10, 10});
+    IGListSectionLayoutResult previous = IGListSectionLayoutResult();
+    previous.lastItemCoordInFixedDirection = 20;
+
+    IGLIST_CPP_ASSERT(!IGListSectionStartsNewRow(input, environment, previous));
+    IGLIST_CPP_ASSERT(!IGListSectionLikelyStartsNewRow(input, environment));
+
+    input.headerSize = {375, 30};
+    IGLIST_CPP_ASSERT(IGListSectionStartsNewRow(input, environment, previous));
+    IGLIST_CPP_ASSERT(IGListSectionLikelyStartsNewRow(input, environment));
+}
+
+IGLIST_CPP_TEST(test_whenFirstItemFillsRow_thatSectionStartsNewRowAfterContent) {
+    const IGListLayoutEnvironment environment = genEnvironment(true, 2);
+    IGListSectionLayoutInput input = IGListSectionLayoutInput();
+    input.itemSizes.push_back({375, 10});
+    IGListSectionLayoutResult previous = IGListSectionLayoutResult();
+
+    IGLIST_CPP_ASSERT(IGListSectionLikelyStartsNewRow(input, environment));
+    IGLIST_CPP_ASSERT(!IGListSectionStartsNewRow(input, environment, previous));
+    previous.lastItemCoordInFixedDirection = 375;
+    IGLIST_CPP_ASSERT(IGListSectionStartsNewRow(input, environment, previous));
+}
+
+IGLIST_CPP_TEST(test_whenSectionIsEmpty_thatItNeverStartsNewRow) {
+    const IGListLayoutEnvironment environment = genEnvironment(true, 2);
+    IGListSectionLayoutInput input = IGListSectionLayoutInput();
+    input.headerSize = {375, 30};
+    IGLIST_CPP_ASSERT(!IGListSectionLikelyStartsNewRow(input, environment));
+    IGLIST_CPP_ASSERT(!IGListSectionStartsNewRow(input, environment, IGListSectionLayoutResult()));
+}
+
+static bool resumedLayoutMatches(uint32_t seed, std::size_t changedItem, std::size_t newItemCount) {
+    const IGListLayoutEnvironment environment = genEnvironment(true, 2);
+    std::vector<IGListSectionLayoutInput> inputs = genFeed(true, 3, seed, false);
+    IGListSectionLayoutInput &input = inputs[1];
+    input.columnCount = 0;
+    input.itemSizes.clear();
+    IGListTestRandom random{seed};
+    for (std::size_t item = 0; item < 300; item++) {
+        input.itemSizes.push_back({40.0 + random.next(120), 20.0 + random.next(60)});
+    }
+
+    IGListLayoutFrameStorage frames;
+    std::vector<IGListSectionRowCursor> rows;
+    frames.appendSection(inputs[0].itemSizes.size());
+    const IGListSectionLayoutResult first = IGListLayoutSection(inputs[0], 0, environment, IGListSectionLayoutResult(), frames);
+    frames.appendSection(input.itemSizes.size());
+    IGListLayoutSection(input, 1, environment, first, frames, &rows);
+
+    // change the items from `changedItem` on, then resume from the row of the first changed item
+    input.itemSizes.resize(newItemCount);
+    for (std::size_t item = changedItem; item < newItemCount; item++) {
+        input.itemSizes[item] = {30.0 + random.next(200), 10.0 + random.next(90)};
+    }
+    const auto row = std::upper_bound(rows.begin(), rows.end(), changedItem, [](std::size_t item, const IGListSectionRowCursor &cursor) {
+        return item < cursor.firstItem;
+    }) - 1;
+    const IGListSectionRowCursor resume = *row;
+    rows.erase(row, rows.end());
+    frames.resizeLastSection(newItemCount);
+    const IGListSectionLayoutResult resumed = IGListLayoutSection(input, 1, environment, first, frames, &rows, &resume);
+
+    IGListLayoutFrameStorage expectedFrames;
+    std::vector<IGListSectionRowCursor> expectedRows;
+    expectedFrames.appendSection(inputs[0].itemSizes.size());
+    IGListLayoutSection(inputs[0], 0, environment, IGListSectionLayoutResult(), expectedFrames);
+    expectedFrames.appendSection(newItemCount);
+    const IGListSectionLayoutResult expected = IGListLayoutSection(input, 1, environment, first, expectedFrames, &expectedRows);
+
+    if (!rectsEqual(expected.bounds, resumed.bounds)
+        || !rectsEqual(expected.headerBounds, resumed.headerBounds)
+        || !rectsEqual(expected.footerBounds, resumed.footerBounds)
+        || expected.lastNextRowCoordInScrollDirection != resumed.lastNextRowCoordInScrollDirection
+        || rows.size() != expectedRows.size()) {
+        return false;
+    }
+    for (std::size_t item = 0; item < newItemCount; item++) {
+        if (!rectsEqual(frames.frame(1, item), expectedFrames.frame(1, item))) {
+            std::fprintf(stderr, "item %zu differs\n", item);
+            return false;
+        }
+    }
+    return true;
+}
+
+IGLIST_CPP_TEST(test_whenResumingSectionFromRow_thatFramesMatchFullLayout) {
+    for (uint32_t seed = 1; seed <= 5; seed++) {
+        IGLIST_CPP_ASSERT(resumedLayoutMatches(seed, 0, 300));
+        IGLIST_CPP_ASSERT(resumedLayoutMatches(seed, 1, 300));
+        IGLIST_CPP_ASSERT(resumedLayoutMatches(seed, 150, 300));
+        IGLIST_CPP_ASSERT(resumedLayoutMatches(seed, 299, 300));
+        // inserted and deleted items
+        IGLIST_CPP_ASSERT(resumedLayoutMatches(seed, 200, 320));
+        IGLIST_CPP_ASSERT(resumedLayoutMatches(seed, 200, 250));
+    }
+}
+
+IGLIST_CPP_TEST(test_whenPackingColumns_thatEachItemGoesToShortestColumn) {
+    const IGListLayoutEnvironment environment = genEnvironment(true, 1);
+    IGListSectionLayoutInput input = IGListSectionLayoutInput();
+    input.columnCount = 3;
+    input.lineSpacing = 4;
+    input.interitemSpacing = 6;
+    input.insets = {10, 10, 10, 10};
+    const double heights[] = {100, 50, 80, 26, 36, 20};
+    for (double height : heights) {
+        // the length in the fixed direction is ignored, items are stretched to their column
+        input.itemSizes.push_back({300, height});
+    }
+
+    IGListLayoutFrameStorage frames;
+    frames.appendSection(input.itemSizes.size());
+    const IGListSectionLayoutResult result = IGListLayoutSection(input, 0, environment, IGListSectionLayoutResult(), frames);
+
+    // (355 - 2 * 6) / 3 = 114.33 wide columns at 10, 130.33 and 250.67
+    IGLIST_CPP_ASSERT(rectsEqual(frames.frame(0, 0), {10, 10, 115, 100}));
+    IGLIST_CPP_ASSERT(rectsEqual(frames.frame(0, 1), {130, 10, 115, 50}));
+    IGLIST_CPP_ASSERT(rectsEqual(frames.frame(0, 2), {250, 10, 115, 80}));
+    // the second column is the shortest
+    IGLIST_CPP_ASSERT(rectsEqual(frames.frame(0, 3), {130, 64, 115, 26}));
+    // the second and third columns both continue at 84, the leading one wins
+    IGLIST_CPP_ASSERT(rectsEqual(frames.frame(0, 4), {130, 94, 115, 36}));
+    IGLIST_CPP_ASSERT(rectsEqual(frames.frame(0, 5), {250, 94, 115, 20}));
+
+    IGLIST_CPP_ASSERT(rectsEqual(result.bounds, {10, 10, 355, 120}));
+    IGLIST_CPP_ASSERT(result.lastNextRowCoordInScrollDirection == 140);
+}
+
+IGLIST_CPP_TEST(test_whenSectionFollowsColumns_thatItStartsBelowLongestColumn) {
+    const IGListLayoutEnvironment environment = genEnvironment(true, 1);
+    IGListSectionLayoutInput columns = IGListSectionLayoutInput();
+    columns.columnCount = 2;
+    columns.itemSizes = {{100, 40}, {100, 70}, {100, 10}};
+    IGListSectionLayoutInput row = IGListSectionLayoutInput();
+    row.itemSizes = {{50, 20}};
+
+    IGLIST_CPP_ASSERT(IGListSectionLikelyStartsNewRow(columns, environment));
+    IGLIST_CPP_ASSERT(IGListSectionStartsNewRow(columns, environment, IGListSectionLayoutResult()));
+
+    IGListLayoutFrameStorage frames;
+    frames.appendSection(columns.itemSizes.size());
+    frames.appendSection(row.itemSizes.size());
+    const IGListSectionLayoutResult first = IGListLayoutSection(columns, 0, environment, IGListSectionLayoutResult(), frames);
+    IGLIST_CPP_ASSERT(rectsEqual(frames.frame(0, 2), {0, 40, 188, 10}));
+    IGListLayoutSection(row, 1, environment, first, frames);
+    IGLIST_CPP_ASSERT(rectsEqual(frames.frame(1, 0), {0, 70, 50, 20}));
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "IGListCppTestHelpers.h"
+
+#include "IGListSectionLookupTable.h"
+
+// keys are integers, hashed to few distinct values so that most probe sequences collide
+static std::size_t hashKey(std::size_t key) {
+    return key % 7;
+}
+
+IGLIST_CPP_TEST(test_whenInsertingKeys_thatEachKeyFindsItsSection) {
+    std::vector<std::size_t> keys;
+    IGListSectionLookupTable table;
+    for (std::size_t section = 0; section < 100; section++) {
+        keys.push_back(section * 3);
+        table.insert(hashKey(keys[section]), section, [&](std::size_t candidate) {
+            return keys[candidate] == keys[section];
+        });
+    }
+
+    IGLIST_CPP_ASSERT(table.count() == 100);
+    for (std::size_t section = 0; section < 100; section++) {
+        const std::size_t key = keys[section];
+        IGLIST_CPP_ASSERT(table.find(hashKey(key), [&](std::size_t candidate) { return keys[candidate] == key; }) == section);
+    }
+    IGLIST_CPP_ASSERT(table.find(hashKey(1), [&](std::size_t candidate) { return keys[candidate] == 1; }) == IGListSectionLookupTable::notFound);
+}
+
+IGLIST_CPP_TEST(test_whenInsertingEqualKey_thatSectionIsReplaced) {
+    const std::vector<std::size_t> keys = {4, 11, 4};
+    IGListSectionLookupTable table;
+    for (std::size_t section = 0; section < keys.size(); section++) {
+        table.insert(hashKey(keys[section]), section, [&](std::size_t candidate) {
+            return keys[candidate] == keys[section];
+        });
+    }
+
+    IGLIST_CPP_ASSERT(table.count() == 2);
+    IGLIST_CPP_ASSERT(table.find(hashKey(4), [&](std::size_t candidate) { return keys[candidate] == 4; }) == 2);
+    IGLIST_CPP_ASSERT(table.find(hashKey(11), [&](std::size_t candidate) { return keys[candidate] == 11; }) == 1);
+}
+
+IGLIST_CPP_TEST(test_whenErasingEntries_thatCollidingEntriesAreStillFound) {
+    std::vector<std::size_t> keys;
+    IGListSectionLookupTable table;
+    for (std::size_t section = 0; section < 50; section++) {
+        keys.push_back(section);
+        table.insert(hashKey(section), section, [&](std::size_t candidate) { return candidate == section; });
+    }
+
+    for (std::size_t section = 0; section < 50; section += 2) {
+        table.erase(hashKey(section), section);
+    }
+    // erasing a missing entry does nothing
+    table.erase(hashKey(0), 0);
+
+    IGLIST_CPP_ASSERT(table.count() == 25);
+    for (std::size_t section = 0; section < 50; section++) {
+        const std::size_t found = table.find(hashKey(section), [&](std::size_t candidate) { return candidate == section; });
+        IGLIST_CPP_ASSERT(found == (section % 2 == 0 ? IGListSectionLookupTable::notFound : section));
+    }
+}
+
+IGLIST_CPP_TEST(test_whenClearing_thatTableIsEmptyAndReusable) {
+    IGListSectionLookupTable table;
+    const auto isEqual = [](std::size_t) { return true; };
+    table.insert(1, 0, isEqual);
+    table.insert(2, 1, isEqual);
+
+    table.clear();
+    IGLIST_CPP_ASSERT(table.count() == 0);
+    IGLIST_CPP_ASSERT(table.find(1, isEqual) == IGListSectionLookupTable::notFound);
+
+    table.insert(2, 5, isEqual);
+    IGLIST_CPP_ASSERT(table.find(2, isEqual) == 5);
+}
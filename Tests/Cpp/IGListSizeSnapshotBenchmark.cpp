@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "IGListSizeSnapshot.h"
+
+// Measures writing, opening and querying a snapshot of a large feed. Run through scripts/run_cpp_tests.sh --benchmark.
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv) {
+    const uint32_t objectCount = argc > 1 ? (uint32_t)std::strtoul(argv[1], nullptr, 10) : 100000;
+    const uint32_t itemsPerObject = 3;
+    const char *directory = std::getenv("TMPDIR");
+    const std::string path = std::string(directory != nullptr ? directory : "/tmp") + "/IGListSizeSnapshotBenchmark.snapshot";
+
+    auto start = std::chrono::steady_clock::now();
+    IGListSizeSnapshotWriter writer;
+    for (uint32_t object = 0; object < objectCount; object++) {
+        const uint64_t identifierHash = IGListSizeSnapshotHash(&object, sizeof(object));
+        for (uint32_t item = 0; item < itemsPerObject; item++) {
+            writer.add({identifierHash, object, item, 375, 375, 44.0f + item});
+        }
+    }
+    if (!writer.writeToFile(path)) {
+        std::fprintf(stderr, "failed to write %s\n", path.c_str());
+        return 1;
+    }
+    const double writeTime = millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    std::unique_ptr<IGListSizeSnapshot> snapshot = IGListSizeSnapshot::openFile(path);
+    const double openTime = millisecondsSince(start);
+    if (snapshot == nullptr) {
+        std::fprintf(stderr, "failed to open %s\n", path.c_str());
+        return 1;
+    }
+
+    start = std::chrono::steady_clock::now();
+    uint32_t hits = 0;
+    for (uint32_t object = 0; object < objectCount; object++) {
+        const uint64_t identifierHash = IGListSizeSnapshotHash(&object, sizeof(object));
+        for (uint32_t item = 0; item < itemsPerObject; item++) {
+            float width = 0;
+            float height = 0;
+            hits += snapshot->find(identifierHash, item, 375, object, &width, &height) ? 1 : 0;
+        }
+    }
+    const double lookupTime = millisecondsSince(start);
+    std::remove(path.c_str());
+
+    const uint32_t entryCount = objectCount * itemsPerObject;
+    std::printf("entries: %u\n", entryCount);
+    std::printf("write:   %.2f ms\n", writeTime);
+    std::printf("open:    %.2f ms\n", openTime);
+    std::printf("lookup:  %.2f ms (%.1f ns per lookup, %u hits)\n", lookupTime, lookupTime * 1e6 / entryCount, hits);
+    return hits == entryCount ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "IGListCppTestHelpers.h"
+
+#include <cstdlib>
+
+#include "IGListSizeSnapshot.h"
+
+static IGListSizeSnapshotEntry genEntry(uint64_t identifierHash, uint32_t index, float containerWidth, uint64_t contentHash, float width, float height) {
+    IGListSizeSnapshotEntry entry;
+    entry.identifierHash = identifierHash;
+    entry.contentHash = contentHash;
+    entry.index = index;
+    entry.containerWidth = containerWidth;
+    entry.width = width;
+    entry.height = height;
+    return entry;
+}
+
+static std::string temporaryPath(const char *name) {
+    const char *directory = std::getenv("TMPDIR");
+    return std::string(directory != nullptr ? directory : "/tmp") + "/" + name;
+}
+
+IGLIST_CPP_TEST(test_whenSerializing_thatEntriesAreFound) {
+    IGListSizeSnapshotWriter writer;
+    writer.add(genEntry(3, 0, 375, 7, 375, 44));
+    writer.add(genEntry(1, 1, 375, 7, 100, 20));
+    writer.add(genEntry(1, 0, 375, 7, 100, 10));
+    writer.add(genEntry(1, 0, 414, 7, 120, 10));
+
+    std::unique_ptr<IGListSizeSnapshot> snapshot = IGListSizeSnapshot::fromData(writer.serialize());
+    IGLIST_CPP_ASSERT(snapshot != nullptr);
+    IGLIST_CPP_ASSERT(snapshot->count() == 4);
+
+    float width = 0;
+    float height = 0;
+    IGLIST_CPP_ASSERT(snapshot->find(1, 0, 375, 7, &width, &height));
+    IGLIST_CPP_ASSERT(width == 100 && height == 10);
+    IGLIST_CPP_ASSERT(snapshot->find(1, 0, 414, 7, &width, &height));
+    IGLIST_CPP_ASSERT(width == 120 && height == 10);
+    IGLIST_CPP_ASSERT(snapshot->find(3, 0, 375, 7, &width, &height));
+    IGLIST_CPP_ASSERT(width == 375 && height == 44);
+    IGLIST_CPP_ASSERT(!snapshot->find(2, 0, 375, 7, &width, &height));
+    IGLIST_CPP_ASSERT(!snapshot->find(1, 2, 375, 7, &width, &height));
+    IGLIST_CPP_ASSERT(!snapshot->find(1, 0, 320, 7, &width, &height));
+}
+
+IGLIST_CPP_TEST(test_whenContentHashDiffers_thatEntryIsMissing) {
+    IGListSizeSnapshotWriter writer;
+    writer.add(genEntry(1, 0, 375, 7, 100, 10));
+    std::unique_ptr<IGListSizeSnapshot> snapshot = IGListSizeSnapshot::fromData(writer.serialize());
+
+    float width = 0;
+    float height = 0;
+    IGLIST_CPP_ASSERT(!snapshot->find(1, 0, 375, 8, &width, &height));
+}
+
+IGLIST_CPP_TEST(test_whenAddingSameKeyTwice_thatLastEntryWins) {
+    IGListSizeSnapshotWriter writer;
+    writer.add(genEntry(1, 0, 375, 7, 100, 10));
+    writer.add(genEntry(1, 0, 375, 8, 100, 30));
+    IGLIST_CPP_ASSERT(writer.count() == 1);
+    std::unique_ptr<IGListSizeSnapshot> snapshot = IGListSizeSnapshot::fromData(writer.serialize());
+    IGLIST_CPP_ASSERT(snapshot->count() == 1);
+
+    float width = 0;
+    float height = 0;
+    IGLIST_CPP_ASSERT(snapshot->find(1, 0, 375, 8, &width, &height));
+    IGLIST_CPP_ASSERT(height == 30);
+}
+
+IGLIST_CPP_TEST(test_whenInsertingExistingKey_thatFirstEntryIsKept) {
+    IGListSizeSnapshotWriter writer;
+    writer.add(genEntry(1, 0, 375, 7, 100, 10));
+    writer.insert(genEntry(1, 0, 375, 8, 100, 30));
+    writer.insert(genEntry(1, 1, 375, 8, 100, 30));
+    IGLIST_CPP_ASSERT(writer.count() == 2);
+    std::unique_ptr<IGListSizeSnapshot> snapshot = IGListSizeSnapshot::fromData(writer.serialize());
+
+    float width = 0;
+    float height = 0;
+    IGLIST_CPP_ASSERT(snapshot->find(1, 0, 375, 7, &width, &height));
+    IGLIST_CPP_ASSERT(height == 10);
+}
+
+IGLIST_CPP_TEST(test_whenRemovingIdentifier_thatOnlyItsEntriesAreRemoved) {
+    IGListSizeSnapshotWriter writer;
+    writer.add(genEntry(1, 0, 375, 7, 100, 10));
+    writer.add(genEntry(2, 0, 375, 7, 100, 10));
+    writer.add(genEntry(2, 3, 414, 7, 100, 10));
+    writer.add(genEntry(3, 0, 375, 7, 100, 10));
+    writer.removeIdentifier(2);
+    IGLIST_CPP_ASSERT(writer.count() == 2);
+
+    std::unique_ptr<IGListSizeSnapshot> snapshot = IGListSizeSnapshot::fromData(writer.serialize());
+    IGLIST_CPP_ASSERT(snapshot->entryAtIndex(0).identifierHash == 1);
+    IGLIST_CPP_ASSERT(snapshot->entryAtIndex(1).identifierHash == 3);
+}
+
+IGLIST_CPP_TEST(test_whenPruningToIdentifiers_thatOtherEntriesAreRemoved) {
+    IGListSizeSnapshotWriter writer;
+    for (uint64_t identifierHash = 0; identifierHash < 10; identifierHash++) {
+        writer.add(genEntry(identifierHash, 0, 375, 7, 100, 10));
+        writer.add(genEntry(identifierHash, 1, 375, 7, 100, 10));
+    }
+    writer.pruneToIdentifiers({2, 5, 42});
+    IGLIST_CPP_ASSERT(writer.count() == 4);
+
+    std::unique_ptr<IGListSizeSnapshot> snapshot = IGListSizeSnapshot::fromData(writer.serialize());
+    IGLIST_CPP_ASSERT(snapshot->entryAtIndex(0).identifierHash == 2);
+    IGLIST_CPP_ASSERT(snapshot->entryAtIndex(3).identifierHash == 5);
+}
+
+IGLIST_CPP_TEST(test_whenSerializingEmptyWriter_thatSnapshotIsValid) {
+    IGListSizeSnapshotWriter writer;
+    std::unique_ptr<IGListSizeSnapshot> snapshot = IGListSizeSnapshot::fromData(writer.serialize());
+    IGLIST_CPP_ASSERT(snapshot != nullptr);
+    IGLIST_CPP_ASSERT(snapshot->count() == 0);
+
+    float width = 0;
+    float height = 0;
+    IGLIST_CPP_ASSERT(!snapshot->find(1, 0, 375, 7, &width, &height));
+}
+
+IGLIST_CPP_TEST(test_whenDataIsCorrupted_thatSnapshotIsRejected) {
+    IGListSizeSnapshotWriter writer;
+    writer.add(genEntry(1, 0, 375, 7, 100, 10));
+    const std::vector<uint8_t> data = writer.serialize();
+
+    std::vector<uint8_t> flipped(data);
+    flipped[sizeof(IGListSizeSnapshotHeader)] ^= 0xff;
+    IGLIST_CPP_ASSERT(IGListSizeSnapshot::fromData(flipped) == nullptr);
+
+    std::vector<uint8_t> truncated(data.begin(), data.end() - 1);
+    IGLIST_CPP_ASSERT(IGListSizeSnapshot::fromData(truncated) == nullptr);
+
+    std::vector<uint8_t> tooShort(data.begin(), data.begin() + 4);
+    IGLIST_CPP_ASSERT(IGListSizeSnapshot::fromData(tooShort) == nullptr);
+}
+
+IGLIST_CPP_TEST(test_whenVersionDiffers_thatSnapshotIsRejected) {
+    IGListSizeSnapshotWriter writer;
+    std::vector<uint8_t> data = writer.serialize();
+    const uint32_t version = IGListSizeSnapshotVersion + 1;
+    std::memcpy(data.data() + offsetof(IGListSizeSnapshotHeader, version), &version, sizeof(version));
+    IGLIST_CPP_ASSERT(IGListSizeSnapshot::fromData(data) == nullptr);
+}
+
+IGLIST_CPP_TEST(test_whenWritingFile_thatMappedSnapshotMatches) {
+    const std::string path = temporaryPath("IGListSizeSnapshotTests.snapshot");
+    IGListSizeSnapshotWriter writer;
+    for (uint32_t i = 0; i < 1000; i++) {
+        writer.add(genEntry(i * 31, i % 3, 375, i, 375, (float)i));
+    }
+    IGLIST_CPP_ASSERT(writer.writeToFile(path));
+
+    std::unique_ptr<IGListSizeSnapshot> snapshot = IGListSizeSnapshot::openFile(path);
+    IGLIST_CPP_ASSERT(snapshot != nullptr);
+    IGLIST_CPP_ASSERT(snapshot->count() == 1000);
+    for (uint32_t i = 0; i < 1000; i++) {
+        float width = 0;
+        float height = 0;
+        IGLIST_CPP_ASSERT(snapshot->find(i * 31, i % 3, 375, i, &width, &height));
+        IGLIST_CPP_ASSERT(height == (float)i);
+    }
+    std::remove(path.c_str());
+}
+
+IGLIST_CPP_TEST(test_whenFileIsMissing_thatSnapshotIsNull) {
+    IGLIST_CPP_ASSERT(IGListSizeSnapshot::openFile(temporaryPath("IGListSizeSnapshotTests.missing")) == nullptr);
+}
+
+IGLIST_CPP_TEST(test_whenHashing_thatValueIsStable) {
+    // FNV-1a test vectors, the persisted identifier hashes depend on these never changing
+    IGLIST_CPP_ASSERT(IGListSizeSnapshotHash("", 0) == 14695981039346656037ULL);
+    IGLIST_CPP_ASSERT(IGListSizeSnapshotHash("a", 1) == 0xaf63dc4c8601ec8cULL);
+    IGLIST_CPP_ASSERT(IGListSizeSnapshotHash("foobar", 6) == 0x85944171f73967e8ULL);
+}
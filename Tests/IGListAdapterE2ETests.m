@@ -15,6 +15,7 @@
 #import "IGListAdapterUpdateTester.h"
 #import "IGListAdapterUpdater.h"
 #import "IGListAdapterUpdaterInternal.h"
+#import "IGListPreparedUpdateInternal.h"
 #import "IGListTestCase.h"
 #import "IGListTestCollectionViewLayout.h"
 #import "IGListTestHelpers.h"
@@ -703,6 +704,37 @@
     [self waitForExpectationsWithTimeout:30 handler:nil];
 }
 
+- (void)test_whenPerformingUpdates_withoutLookupsIntoPreviousSections_thatSectionMapIsNotCopied {
+    [self setupWithObjects:@[
+        genTestObject(@1, @1),
+        genTestObject(@2, @2),
+    ]];
+
+    id mockDelegate = [OCMockObject niceMockForProtocol:@protocol(IGListAdapterUpdaterDelegate)];
+    ((IGListAdapterUpdater *)self.updater).delegate = mockDelegate;
+    __block BOOL didPerformBatchUpdates = NO;
+    [[[mockDelegate stub] andDo:^(NSInvocation *invocation) {
+        // a copy of the section map would share its storage, so the update would have copied all of it
+        XCTAssertNil(self.adapter.previousSectionMap);
+        didPerformBatchUpdates = YES;
+    }] listAdapterUpdater:[OCMArg any] didPerformBatchUpdates:[OCMArg any] collectionView:[OCMArg any]];
+
+    self.dataSource.objects = @[
+        genTestObject(@1, @1),
+        genTestObject(@2, @2),
+        genTestObject(@3, @3),
+    ];
+
+    XCTestExpectation *expectation = genExpectation;
+    [self.adapter performUpdatesAnimated:YES completion:^(BOOL finished) {
+        XCTAssertTrue(didPerformBatchUpdates);
+        XCTAssertEqual(self.collectionView.numberOfSections, 3);
+        XCTAssertEqual([self.adapter sectionForObject:self.dataSource.objects[2]], 2);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
 - (void)test_whenSectionControllerMutates_whenThereIsNoWindow_thatCollectionViewCountsAreUpdated {
     // remove the collection view from self.window so that we use reloadData
     [self.collectionView removeFromSuperview];
@@ -2839,4 +2871,72 @@
     [self waitForExpectationsWithTimeout:30 handler:nil];
 }
 
+- (void)test_whenCommittingPreparedUpdate_thatExistingSectionControllersAreKept {
+    [self setupWithObjects:@[
+        genTestObject(@1, @"Foo"),
+        genTestObject(@2, @"Bar")
+    ]];
+    IGListSectionController *controller = [self.adapter sectionControllerForObject:self.dataSource.objects[1]];
+
+    NSArray *objects = @[
+        genTestObject(@2, @"Baz"),
+        genTestObject(@3, @"Qux")
+    ];
+    __block IGListPreparedUpdate *preparedUpdate = nil;
+    XCTestExpectation *prepareExpectation = genExpectation;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        preparedUpdate = [self.adapter prepareUpdateWithObjects:objects];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [prepareExpectation fulfill];
+        });
+    });
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+
+    XCTAssertEqualObjects(preparedUpdate.objects, objects);
+    XCTAssertEqualObjects(preparedUpdate.diffResult.deletes, [NSIndexSet indexSetWithIndex:0]);
+    XCTAssertEqualObjects(preparedUpdate.diffResult.inserts, [NSIndexSet indexSetWithIndex:1]);
+    XCTAssertEqualObjects(preparedUpdate.oldIndexes, (@[@1, @(NSNotFound)]));
+
+    self.dataSource.objects = objects;
+    XCTestExpectation *expectation = genExpectation;
+    [self.adapter commitPreparedUpdate:preparedUpdate animated:YES completion:^(BOOL finished) {
+        XCTAssertEqual(self.collectionView.numberOfSections, 2);
+        XCTAssertEqual([self.adapter sectionControllerForObject:objects[0]], controller);
+        XCTAssertEqual([self.adapter sectionForSectionController:controller], 0);
+        XCTAssertNotNil([self.adapter sectionControllerForObject:objects[1]]);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
+- (void)test_whenCommittingPreparedUpdate_afterAnotherUpdate_thatObjectsAreDiffedAgain {
+    [self setupWithObjects:@[
+        genTestObject(@1, @"Foo"),
+        genTestObject(@2, @"Bar")
+    ]];
+    NSArray *objects = @[
+        genTestObject(@2, @"Bar"),
+        genTestObject(@3, @"Baz")
+    ];
+    IGListPreparedUpdate *preparedUpdate = [self.adapter prepareUpdateWithObjects:objects];
+
+    self.dataSource.objects = @[
+        genTestObject(@4, @"Qux")
+    ];
+    XCTestExpectation *updateExpectation = genExpectation;
+    [self.adapter performUpdatesAnimated:YES completion:^(BOOL finished) {
+        [updateExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+
+    self.dataSource.objects = objects;
+    XCTestExpectation *expectation = genExpectation;
+    [self.adapter commitPreparedUpdate:preparedUpdate animated:YES completion:^(BOOL finished) {
+        XCTAssertEqual(self.collectionView.numberOfSections, 2);
+        XCTAssertEqualObjects(self.adapter.objects, objects);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
 @end
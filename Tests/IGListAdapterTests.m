@@ -18,6 +18,7 @@
 #import "IGListTestAdapterDataSource.h"
 #import "IGListTestAdapterHorizontalDataSource.h"
 #import "IGListTestAdapterReorderingDataSource.h"
+#import "IGListTestBatchSizingSection.h"
 #import "IGListTestCase.h"
 #import "IGListTestOffsettingLayout.h"
 #import "IGListTestSection.h"
@@ -635,6 +636,22 @@
     XCTAssertEqualObjects(visibleIndexes, expectedIndexes);
 }
 
+- (void)test_whenAdapterUpdated_withObjectsOverflow_thatVisibleSectionRangeIsCorrect {
+    // each section controller returns n items sized 100x10
+    self.dataSource.objects = @[@1, @2, @3, @4, @5, @6];
+    [self.adapter reloadDataWithCompletion:nil];
+    self.collectionView.contentOffset = CGPointMake(0, 30);
+    [self.collectionView layoutIfNeeded];
+
+    // Objects @3, @4, @5 are visible, which are at indexes 2, 3, 4
+    XCTAssertTrue(NSEqualRanges([self.adapter visibleSectionRange], NSMakeRange(2, 3)));
+}
+
+- (void)test_whenNoCellIsVisible_thatVisibleSectionRangeIsEmpty {
+    XCTAssertEqual([self.adapter visibleSectionRange].location, NSNotFound);
+    XCTAssertEqual([self.adapter visibleSectionRange].length, 0);
+}
+
 - (void)test_whenAdapterUpdated_thatLayoutAttributesForItemAtIndexIsCorrect {
     // each section controller returns n items sized 100x10
     self.dataSource.objects = @[@2, @3];
@@ -1529,6 +1546,25 @@
     [mockSectionControllerScrollDelegate verify];
 }
 
+- (void)test_whenScrolling_thatOnlySectionControllersWithScrollDelegateAreSubscribed {
+    self.dataSource.objects = @[@1, @2, @3];
+    [self.adapter reloadDataWithCompletion:nil];
+    [self.collectionView layoutIfNeeded];
+    XCTAssertEqual(self.adapter.displayHandler.scrollSubscribers.count, 0);
+
+    id mockSectionControllerScrollDelegate = [OCMockObject mockForProtocol:@protocol(IGListScrollDelegate)];
+    IGListSectionController *controller = [self.adapter sectionControllerForObject:@2];
+    controller.scrollDelegate = mockSectionControllerScrollDelegate;
+    XCTAssertEqualObjects(self.adapter.displayHandler.scrollSubscribers, @[controller]);
+
+    [[mockSectionControllerScrollDelegate expect] listAdapter:self.adapter didScrollSectionController:controller];
+    [self.adapter scrollViewDidScroll:self.collectionView];
+    [mockSectionControllerScrollDelegate verify];
+
+    controller.scrollDelegate = nil;
+    XCTAssertEqual(self.adapter.displayHandler.scrollSubscribers.count, 0);
+}
+
 - (void)test_whenReloadingObjectsThatDontExist_thatAdapterContinues {
     self.dataSource.objects = @[@0, @1, @2];
     [self.adapter reloadDataWithCompletion:nil];
@@ -2312,6 +2348,135 @@
     [mockDelegate verify];
 }
 
+- (void)test_whenItemSizeCacheEnabled_withReloadOfSameObjects_thatSizeIsNotRequestedAgain {
+    self.adapter.itemSizeCacheEnabled = YES;
+    self.dataSource.objects = @[@1];
+    [self.adapter reloadDataWithCompletion:nil];
+
+    IGListTestSection *sectionController = [self.adapter sectionControllerForObject:@1];
+    sectionController.size = CGSizeMake(100, 10);
+    NSIndexPath *indexPath = [NSIndexPath indexPathForItem:0 inSection:0];
+    XCTAssertEqual([self.adapter sizeForItemAtIndexPath:indexPath].height, 10);
+
+    [self.adapter reloadDataWithCompletion:nil];
+    IGListTestSection *reloadedSectionController = [self.adapter sectionControllerForObject:@1];
+    XCTAssertNotEqual(sectionController, reloadedSectionController);
+    reloadedSectionController.size = CGSizeMake(100, 20);
+
+    id mockDelegate = [OCMockObject niceMockForProtocol:@protocol(IGListAdapterPerformanceDelegate)];
+    [[mockDelegate reject] listAdapterWillCallSize:self.adapter];
+    self.adapter.performanceDelegate = mockDelegate;
+    XCTAssertEqual([self.adapter sizeForItemAtIndexPath:indexPath].height, 10);
+    [mockDelegate verify];
+}
+
+- (void)test_whenItemSizeCacheEnabled_withInvalidatedLayout_thatSizeIsRequestedAgain {
+    self.adapter.itemSizeCacheEnabled = YES;
+    self.dataSource.objects = @[@1];
+    [self.adapter reloadDataWithCompletion:nil];
+
+    IGListTestSection *sectionController = [self.adapter sectionControllerForObject:@1];
+    NSIndexPath *indexPath = [NSIndexPath indexPathForItem:0 inSection:0];
+    XCTAssertEqual([self.adapter sizeForItemAtIndexPath:indexPath].height, 10);
+
+    sectionController.size = CGSizeMake(100, 20);
+    XCTAssertEqual([self.adapter sizeForItemAtIndexPath:indexPath].height, 10);
+
+    [self.adapter invalidateLayoutForSectionController:sectionController completion:nil];
+    XCTAssertEqual([self.adapter sizeForItemAtIndexPath:indexPath].height, 20);
+}
+
+- (void)test_whenItemSizeCacheEnabled_withReloadedObject_thatSizeIsRequestedAgain {
+    self.adapter.itemSizeCacheEnabled = YES;
+    self.dataSource.objects = @[@1];
+    [self.adapter reloadDataWithCompletion:nil];
+
+    NSIndexPath *indexPath = [NSIndexPath indexPathForItem:0 inSection:0];
+    XCTAssertEqual([self.adapter sizeForItemAtIndexPath:indexPath].height, 10);
+
+    // reloading an object drops its sizes even though it is equal
+    IGListTestSection *sectionController = [self.adapter sectionControllerForObject:@1];
+    sectionController.size = CGSizeMake(100, 20);
+    [self.adapter reloadObjects:@[@1]];
+    XCTAssertEqual([self.adapter sizeForItemAtIndexPath:indexPath].height, 20);
+}
+
+- (void)test_whenSectionControllerSizesInBatch_thatLayoutSizesSectionInOneCall {
+    self.collectionView.collectionViewLayout = [[IGListCollectionViewLayout alloc] initWithStickyHeaders:NO
+                                                                                        topContentInset:0
+                                                                                          stretchToEdge:NO];
+    self.dataSource.batchSizingSections = YES;
+    self.dataSource.objects = @[@5, @3];
+    [self.adapter reloadDataWithCompletion:nil];
+    [self.collectionView layoutIfNeeded];
+
+    IGListTestBatchSizingSection *sectionController = [self.adapter sectionControllerForObject:@5];
+    XCTAssertEqual(sectionController.batchSizeCallCount, 1);
+    XCTAssertEqual(sectionController.itemSizeCallCount, 0);
+    XCTAssertEqual([self.collectionView cellForItemAtIndexPath:[NSIndexPath indexPathForItem:4 inSection:0]].frame.size.height, 10);
+}
+
+- (void)test_whenSectionControllerSizesInBatch_withItemSizeCache_thatCachedSizesAreReused {
+    self.adapter.itemSizeCacheEnabled = YES;
+    self.dataSource.batchSizingSections = YES;
+    self.dataSource.objects = @[@5];
+    [self.adapter reloadDataWithCompletion:nil];
+
+    IGListTestBatchSizingSection *sectionController = [self.adapter sectionControllerForObject:@5];
+    CGSize sizes[5];
+    XCTAssertTrue([self.adapter getSizes:sizes forItemsInRange:NSMakeRange(0, 5) inSection:0]);
+    XCTAssertEqual(sectionController.batchSizeCallCount, 1);
+
+    sectionController.size = CGSizeMake(100, 20);
+    XCTAssertTrue([self.adapter getSizes:sizes forItemsInRange:NSMakeRange(0, 5) inSection:0]);
+    XCTAssertEqual(sectionController.batchSizeCallCount, 1);
+    XCTAssertEqual(sizes[4].height, 10);
+    XCTAssertEqual([self.adapter sizeForItemAtIndexPath:[NSIndexPath indexPathForItem:2 inSection:0]].height, 10);
+    XCTAssertEqual(sectionController.itemSizeCallCount, 0);
+}
+
+- (void)test_whenSectionControllerSizesInBatch_withSnapshotMissing_thatSectionIsStillSizedInOneCall {
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    XCTAssertFalse([self.adapter loadItemSizeSnapshotFromFile:path]);
+    self.dataSource.batchSizingSections = YES;
+    self.dataSource.objects = @[@5];
+    [self.adapter reloadDataWithCompletion:nil];
+
+    IGListTestBatchSizingSection *sectionController = [self.adapter sectionControllerForObject:@5];
+    CGSize sizes[5];
+    XCTAssertTrue([self.adapter getSizes:sizes forItemsInRange:NSMakeRange(0, 5) inSection:0]);
+    XCTAssertEqual(sectionController.batchSizeCallCount, 1);
+    XCTAssertEqual(sectionController.itemSizeCallCount, 0);
+    XCTAssertEqual(sizes[4].height, 10);
+}
+
+- (void)test_whenSectionControllerHasColumns_thatLayoutPacksItemsInColumns {
+    self.collectionView.collectionViewLayout = [[IGListCollectionViewLayout alloc] initWithStickyHeaders:NO
+                                                                                        topContentInset:0
+                                                                                          stretchToEdge:NO];
+    self.dataSource.objects = @[@3];
+    [self.adapter reloadDataWithCompletion:nil];
+    IGListTestSection *sectionController = [self.adapter sectionControllerForObject:@3];
+    XCTAssertEqual(sectionController.numberOfColumns, 0);
+
+    sectionController.numberOfColumns = 2;
+    [self.collectionView.collectionViewLayout invalidateLayout];
+    [self.collectionView layoutIfNeeded];
+
+    XCTAssertEqual([self.adapter collectionView:self.collectionView layout:self.collectionView.collectionViewLayout numberOfColumnsInSection:0], 2);
+    // 100x10 items are stretched to the 50 point columns
+    XCTAssertTrue(CGRectEqualToRect([self.collectionView cellForItemAtIndexPath:[NSIndexPath indexPathForItem:1 inSection:0]].frame, CGRectMake(50, 0, 50, 10)));
+    XCTAssertTrue(CGRectEqualToRect([self.collectionView cellForItemAtIndexPath:[NSIndexPath indexPathForItem:2 inSection:0]].frame, CGRectMake(0, 10, 50, 10)));
+}
+
+- (void)test_whenSectionControllerDoesNotSizeInBatch_thatAdapterDeclines {
+    self.dataSource.objects = @[@5];
+    [self.adapter reloadDataWithCompletion:nil];
+
+    CGSize sizes[5];
+    XCTAssertFalse([self.adapter getSizes:sizes forItemsInRange:NSMakeRange(0, 5) inSection:0]);
+}
+
 #pragma mark - Deleted Section Controllers
 
 - (void)test_whenSectionControllerRemoved_thatCellForIndexPathIsNil {
@@ -2436,4 +2601,21 @@
     XCTAssertNil(newAdapter.collectionViewDelegate);
 }
 
+- (void)test_whenSectionControllerRemoved_withReuseEnabled_thatDequeueReturnsIt {
+    self.adapter.maxReusableSectionControllersPerClass = 1;
+    // the last section is below the viewport, so it is not displayed when removed
+    self.dataSource.objects = @[@10, @5, @1];
+    [self.adapter reloadDataWithCompletion:nil];
+    [self.collectionView layoutIfNeeded];
+    IGListSectionController *removedController = [self.adapter sectionControllerForObject:@1];
+
+    self.dataSource.objects = @[@10, @5];
+    [self.adapter performUpdatesAnimated:NO completion:nil];
+
+    XCTAssertEqual([self.adapter dequeueReusableSectionControllerOfClass:[IGListTestSection class]], removedController);
+    IGListSectionController *newController = [self.adapter dequeueReusableSectionControllerOfClass:[IGListTestSection class]];
+    XCTAssertNotNil(newController);
+    XCTAssertNotEqual(newController, removedController);
+}
+
 @end
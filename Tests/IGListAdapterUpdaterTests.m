@@ -23,6 +23,22 @@
 #define waitExpectation [self waitForExpectationsWithTimeout:30 handler:nil]
 #define genToBlock ^NSArray *{ return to; }
 
+@interface IGListTestBatchUpdateRecordingLayout : UICollectionViewFlowLayout <IGListCollectionViewLayoutCompatible>
+
+@property (nonatomic, strong) IGListBatchUpdateData *appliedUpdateData;
+
+@end
+
+@implementation IGListTestBatchUpdateRecordingLayout
+
+- (void)didModifySection:(NSInteger)modifiedSection {}
+
+- (void)willApplyBatchUpdateData:(IGListBatchUpdateData *)updateData {
+    self.appliedUpdateData = updateData;
+}
+
+@end
+
 @interface IGListAdapterUpdaterTests : XCTestCase
 
 @property (nonatomic, strong) UIWindow *window;
@@ -1250,6 +1266,35 @@
     [self waitForExpectationsWithTimeout:30 handler:nil];
 }
 
+- (void)test_withSingleItemSectionUpdates_thatLayoutIsToldAboutUpdateData {
+    IGListTestBatchUpdateRecordingLayout *layout = [IGListTestBatchUpdateRecordingLayout new];
+    self.collectionView.collectionViewLayout = layout;
+    self.updater.singleItemSectionUpdates = YES;
+
+    IGSectionObject *first = [IGSectionObject sectionWithObjects:@[@1]];
+    IGSectionObject *second = [IGSectionObject sectionWithObjects:@[@2]];
+    IGSectionObject *third = [IGSectionObject sectionWithObjects:@[@3]];
+
+    NSArray *from = @[first, second];
+    NSArray *to = @[second, third];
+
+    self.dataSource.sections = from;
+    [self.updater reloadDataWithCollectionViewBlock:[self collectionViewBlock] reloadUpdateBlock:^{} completion:nil];
+    [self.updater update];
+
+    XCTestExpectation *expectation = genExpectation;
+    [self.updater performUpdateWithCollectionViewBlock:[self collectionViewBlock]
+                                              animated:NO
+                                      sectionDataBlock:[self dataBlockFromObjects:from toObjects:to]
+                                 applySectionDataBlock:self.applySectionDataBlock
+                                            completion:^(BOOL finished) {
+        XCTAssertEqualObjects(layout.appliedUpdateData.deleteSections, [NSIndexSet indexSetWithIndex:0]);
+        XCTAssertEqualObjects(layout.appliedUpdateData.insertSections, [NSIndexSet indexSetWithIndex:1]);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
 #pragma mark - Illegal state checking
 
 - (void)test_whenCollectionViewBlockIsNotCorrectlyApplied_thatTransactionsGetCancelled {
@@ -7,7 +7,9 @@
 
 #import <XCTest/XCTest.h>
 
+#import <IGListDiffKit/IGListBatchUpdateData.h>
 #import <IGListKit/IGListCollectionViewLayout.h>
+#import <IGListKit/IGListCollectionViewLayoutInvalidationContext.h>
 
 #import "IGLayoutTestDataSource.h"
 #import "IGLayoutTestItem.h"
@@ -16,7 +18,9 @@
 #import "IGListAdapterProxy.h"
 #import "IGListAdapterUpdater.h"
 #import "IGListCollectionViewLayoutInternal.h"
+#import "IGListMoveIndexInternal.h"
 #import "IGListTestHelpers.h"
+#import "UICollectionView+IGListBatchUpdateData.h"
 
 @interface IGListCollectionViewLayout (Tests)
 
@@ -393,6 +397,91 @@ static const CGRect kTestFrame = (CGRect){{0, 0}, {100, 100}};
     IGAssertEqualFrame([self headerForSection:1].frame, 0, 55, 100, 10);
 }
 
+- (void)test_whenUsingStickyHeaders_withScrolling_thatOnlyHeadersPinnedAlongTheWayAreInvalidated {
+    [self setUpWithStickyHeaders:YES topInset:10];
+
+    NSMutableArray *sections = [NSMutableArray new];
+    for (NSInteger section = 0; section < 10; section++) {
+        [sections addObject:[[IGLayoutTestSection alloc] initWithInsets:UIEdgeInsetsZero
+                                                            lineSpacing:0
+                                                       interitemSpacing:0
+                                                           headerHeight:10
+                                                           footerHeight:0
+                                                                  items:@[
+                                                                          [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, 20}],
+                                                                          [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, 20}],
+                                                                  ]]];
+    }
+    [self prepareWithData:sections];
+
+    // scrolling inside section 0 only moves its header
+    IGListCollectionViewLayoutInvalidationContext *context =
+    (IGListCollectionViewLayoutInvalidationContext *)[self.layout invalidationContextForBoundsChange:CGRectMake(0, 5, 100, 100)];
+    XCTAssertFalse(context.invalidateSupplementaryListAttributes);
+    XCTAssertEqualObjects(context.invalidatedSupplementaryIndexPaths[UICollectionElementKindSectionHeader], @[genIndexPath(0, 0)]);
+
+    // scrolling into section 2 moves the headers of every section passed on the way
+    context = (IGListCollectionViewLayoutInvalidationContext *)[self.layout invalidationContextForBoundsChange:CGRectMake(0, 120, 100, 100)];
+    XCTAssertFalse(context.invalidateSupplementaryListAttributes);
+    NSArray *expected = @[genIndexPath(0, 0), genIndexPath(1, 0), genIndexPath(2, 0)];
+    XCTAssertEqualObjects(context.invalidatedSupplementaryIndexPaths[UICollectionElementKindSectionHeader], expected);
+
+    self.collectionView.contentOffset = CGPointMake(0, 120);
+    [self.collectionView layoutIfNeeded];
+    IGAssertEqualFrame([self.layout layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader atIndexPath:genIndexPath(1, 0)].frame, 0, 90, 100, 10);
+    IGAssertEqualFrame([self.layout layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader atIndexPath:genIndexPath(2, 0)].frame, 0, 130, 100, 10);
+    IGAssertEqualFrame([self.layout layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader atIndexPath:genIndexPath(3, 0)].frame, 0, 150, 100, 10);
+
+    // size changes still rebuild everything
+    context = (IGListCollectionViewLayoutInvalidationContext *)[self.layout invalidationContextForBoundsChange:CGRectMake(0, 120, 100, 200)];
+    XCTAssertTrue(context.invalidateSupplementaryListAttributes);
+    XCTAssertTrue(context.invalidateAllListAttributes);
+}
+
+- (void)test_whenUsingStickyHeaders_withEmptySectionBetweenHeaders_thatHeadersPinnedAlongTheWayAreInvalidated {
+    [self setUpWithStickyHeaders:YES topInset:10];
+
+    [self prepareWithData:@[
+            [[IGLayoutTestSection alloc] initWithInsets:UIEdgeInsetsZero
+                                            lineSpacing:0
+                                       interitemSpacing:0
+                                           headerHeight:10
+                                           footerHeight:0
+                                                  items:@[
+                                                          [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, 20}],
+                                                          [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, 20}],
+                                                  ]],
+            [[IGLayoutTestSection alloc] initWithInsets:UIEdgeInsetsZero
+                                            lineSpacing:0
+                                       interitemSpacing:0
+                                           headerHeight:10
+                                           footerHeight:0
+                                                  items:@[]],
+            [[IGLayoutTestSection alloc] initWithInsets:UIEdgeInsetsZero
+                                            lineSpacing:0
+                                       interitemSpacing:0
+                                           headerHeight:10
+                                           footerHeight:0
+                                                  items:@[
+                                                          [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, 30}],
+                                                          [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, 30}],
+                                                          [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, 30}],
+                                                  ]],
+    ]];
+
+    // scrolling into section 2 passes the empty section, which starts where section 2 does
+    IGListCollectionViewLayoutInvalidationContext *context =
+    (IGListCollectionViewLayoutInvalidationContext *)[self.layout invalidationContextForBoundsChange:CGRectMake(0, 45, 100, 100)];
+    XCTAssertFalse(context.invalidateSupplementaryListAttributes);
+    NSArray *expected = @[genIndexPath(0, 0), genIndexPath(1, 0), genIndexPath(2, 0)];
+    XCTAssertEqualObjects(context.invalidatedSupplementaryIndexPaths[UICollectionElementKindSectionHeader], expected);
+
+    self.collectionView.contentOffset = CGPointMake(0, 45);
+    [self.collectionView layoutIfNeeded];
+    IGAssertEqualFrame([self.layout layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader atIndexPath:genIndexPath(0, 0)].frame, 0, 40, 100, 10);
+    IGAssertEqualFrame([self.layout layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader atIndexPath:genIndexPath(2, 0)].frame, 0, 55, 100, 10);
+}
+
 - (void)test_whenUsingStickyHeaders_withSimulatedHorizontalScrolling_thatXPositionsAdjusted {
     [self setUpWithStickyHeaders:YES scrollDirection:UICollectionViewScrollDirectionHorizontal topInset:10 stretchToEdge:NO testFrame:kTestFrame];
 
@@ -982,6 +1071,41 @@ static const CGRect kTestFrame = (CGRect){{0, 0}, {100, 100}};
 }
 
 
+- (void)test_whenQueryingScrollingRects_withSectionsSharingRows_thatAttributesMatchEveryIntersectingItem {
+    [self setUpWithStickyHeaders:NO topInset:0];
+    // sections without headers share rows, and alternating top insets start some of them above the previous items
+    NSMutableArray *data = [NSMutableArray new];
+    for (NSInteger i = 0; i < 60; i++) {
+        [data addObject:[[IGLayoutTestSection alloc] initWithInsets:UIEdgeInsetsMake(i % 2 == 0 ? 0 : 6, 0, 0, 0)
+                                                        lineSpacing:0
+                                                   interitemSpacing:0
+                                                       headerHeight:0
+                                                       footerHeight:0
+                                                              items:@[
+                                                                      [[IGLayoutTestItem alloc] initWithSize:(CGSize) {30, 10 + i % 5 * 10}],
+                                                                      [[IGLayoutTestItem alloc] initWithSize:(CGSize) {20, 15}],
+                                                              ]]];
+    }
+    [self prepareWithData:data];
+
+    const CGFloat contentHeight = self.layout.collectionViewContentSize.height;
+    for (CGFloat y = -20; y < contentHeight; y += 7) {
+        const CGRect rect = CGRectMake(0, y, 100, 60);
+        NSMutableArray *expected = [NSMutableArray new];
+        for (NSInteger section = 0; section < data.count; section++) {
+            for (NSInteger item = 0; item < 2; item++) {
+                UICollectionViewLayoutAttributes *attributes = [self.layout layoutAttributesForItemAtIndexPath:genIndexPath(section, item)];
+                if (CGRectIntersectsRect(attributes.frame, rect)) {
+                    [expected addObject:attributes.indexPath];
+                }
+            }
+        }
+        NSArray *attributes = [self.layout layoutAttributesForElementsInRect:rect];
+        NSArray *paths = [[attributes valueForKeyPath:@"indexPath"] sortedArrayUsingSelector:@selector(compare:)];
+        XCTAssertEqualObjects(paths ?: @[], expected);
+    }
+}
+
 - (void)test_whenChangingBoundsSize_withItemsThatNewlineAfterChange_thatLayoutShiftsItems {
     [self setUpWithStickyHeaders:NO topInset:0];
 
@@ -1244,6 +1368,46 @@ static const CGRect kTestFrame = (CGRect){{0, 0}, {100, 100}};
     IGAssertEqualFrame([self cellForSection:0 item:2].frame, 40, 0, 20, 20);
 }
 
+- (void)test_whenInvalidatingLayout_thatAttributesAreRecycledWithNewFrames {
+    [self setUpWithStickyHeaders:NO topInset:0];
+
+    [self prepareWithData:@[
+                            [[IGLayoutTestSection alloc] initWithInsets:UIEdgeInsetsZero
+                                                            lineSpacing:0
+                                                       interitemSpacing:0
+                                                           headerHeight:10
+                                                           footerHeight:0
+                                                                  items:@[
+                                                                          [[IGLayoutTestItem alloc] initWithSize:CGSizeMake(10, 10)],
+                                                                          ]],
+                            ]];
+
+    UICollectionViewLayoutAttributes *item = [self.layout layoutAttributesForItemAtIndexPath:genIndexPath(0, 0)];
+    UICollectionViewLayoutAttributes *header = [self.layout layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader
+                                                                                            atIndexPath:genIndexPath(0, 0)];
+    IGAssertEqualFrame(item.frame, 0, 10, 10, 10);
+
+    [self prepareWithData:@[
+                            [[IGLayoutTestSection alloc] initWithInsets:UIEdgeInsetsZero
+                                                            lineSpacing:0
+                                                       interitemSpacing:0
+                                                           headerHeight:20
+                                                           footerHeight:0
+                                                                  items:@[
+                                                                          [[IGLayoutTestItem alloc] initWithSize:CGSizeMake(20, 20)],
+                                                                          ]],
+                            ]];
+
+    UICollectionViewLayoutAttributes *recycledItem = [self.layout layoutAttributesForItemAtIndexPath:genIndexPath(0, 0)];
+    UICollectionViewLayoutAttributes *recycledHeader = [self.layout layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader
+                                                                                                   atIndexPath:genIndexPath(0, 0)];
+    XCTAssertEqual(item, recycledItem);
+    XCTAssertEqual(header, recycledHeader);
+    IGAssertEqualFrame(recycledItem.frame, 0, 20, 20, 20);
+    IGAssertEqualFrame(recycledHeader.frame, 0, 0, 100, 20);
+    XCTAssertEqual(recycledItem.zIndex, 0);
+}
+
 - (void)test_whenMarkingASectionAsUpdated_thatLayoutUpdates {
     [self setUpWithStickyHeaders:NO topInset:0];
     [self prepareWithData:@[
@@ -1268,6 +1432,258 @@ static const CGRect kTestFrame = (CGRect){{0, 0}, {100, 100}};
     IGAssertEqualFrame([self cellForSection:0 item:1].frame, 10, 0, 10, 10);
 }
 
+- (void)test_whenUsingCompactFrameStorage_thatFramesMatchDefaultStorage {
+    [self setUpWithStickyHeaders:NO topInset:0];
+
+    NSMutableArray *items = [NSMutableArray new];
+    for (NSInteger i = 0; i < 100; i++) {
+        [items addObject:[[IGLayoutTestItem alloc] initWithSize:(CGSize) {33.5, 20}]];
+    }
+
+    [self prepareWithData:@[
+            [[IGLayoutTestSection alloc] initWithInsets:UIEdgeInsetsMake(1, 2, 3, 4)
+                                            lineSpacing:5
+                                       interitemSpacing:0.5
+                                           headerHeight:10
+                                           footerHeight:0
+                                                  items:items]
+    ]];
+
+    NSMutableArray<NSValue *> *frames = [NSMutableArray new];
+    for (NSInteger i = 0; i < items.count; i++) {
+        [frames addObject:[NSValue valueWithCGRect:[self.layout layoutAttributesForItemAtIndexPath:genIndexPath(0, i)].frame]];
+    }
+    const NSUInteger attributesCount = [self.layout layoutAttributesForElementsInRect:CGRectMake(0, 0, 100, 100)].count;
+
+    self.layout.usesCompactFrameStorage = YES;
+    [self.collectionView layoutIfNeeded];
+
+    for (NSInteger i = 0; i < items.count; i++) {
+        const CGRect frame = [self.layout layoutAttributesForItemAtIndexPath:genIndexPath(0, i)].frame;
+        XCTAssertTrue(CGRectEqualToRect(frame, frames[i].CGRectValue));
+    }
+    XCTAssertEqual([self.layout layoutAttributesForElementsInRect:CGRectMake(0, 0, 100, 100)].count, attributesCount);
+}
+
+- (void)test_whenUsingConcurrentSectionLayout_thatFramesMatchSerialLayout {
+    [self setUpWithStickyHeaders:NO topInset:0];
+
+    // enough items to lay out on background threads, mixing sections with headers, full width rows and grids
+    NSMutableArray *sections = [NSMutableArray new];
+    NSInteger itemCount = 0;
+    for (NSInteger section = 0; section < 300; section++) {
+        NSMutableArray *items = [NSMutableArray new];
+        for (NSInteger i = 0; i < 10; i++) {
+            const CGFloat width = section % 3 == 0 ? 100 : (section % 3 == 1 ? 33 : 25 + i);
+            [items addObject:[[IGLayoutTestItem alloc] initWithSize:(CGSize) {width, 10 + section % 7}]];
+        }
+        itemCount += items.count;
+        [sections addObject:[[IGLayoutTestSection alloc] initWithInsets:UIEdgeInsetsMake(section % 2, 0, 2, 0)
+                                                            lineSpacing:section % 4
+                                                       interitemSpacing:1
+                                                           headerHeight:section % 5 == 0 ? 20 : 0
+                                                           footerHeight:section % 11 == 0 ? 5 : 0
+                                                                  items:items]];
+    }
+    [self prepareWithData:sections];
+
+    NSMutableArray<NSValue *> *frames = [NSMutableArray new];
+    for (NSInteger section = 0; section < sections.count; section++) {
+        for (NSInteger i = 0; i < 10; i++) {
+            [frames addObject:[NSValue valueWithCGRect:[self.layout layoutAttributesForItemAtIndexPath:genIndexPath(section, i)].frame]];
+        }
+    }
+    const CGSize contentSize = self.layout.collectionViewContentSize;
+
+    self.layout.usesConcurrentSectionLayout = YES;
+    [self.layout invalidateLayout];
+    [self.collectionView layoutIfNeeded];
+
+    for (NSInteger section = 0; section < sections.count; section++) {
+        for (NSInteger i = 0; i < 10; i++) {
+            const CGRect frame = [self.layout layoutAttributesForItemAtIndexPath:genIndexPath(section, i)].frame;
+            XCTAssertTrue(CGRectEqualToRect(frame, frames[section * 10 + i].CGRectValue));
+        }
+    }
+    XCTAssertTrue(CGSizeEqualToSize(self.layout.collectionViewContentSize, contentSize));
+    XCTAssertEqual(itemCount, 3000);
+}
+
+static NSArray<IGLayoutTestSection *> *genRemappingSections(NSArray<NSNumber *> *heights) {
+    NSMutableArray *sections = [NSMutableArray new];
+    for (NSNumber *height in heights) {
+        [sections addObject:[[IGLayoutTestSection alloc] initWithInsets:UIEdgeInsetsZero
+                                                            lineSpacing:0
+                                                       interitemSpacing:0
+                                                           headerHeight:0
+                                                           footerHeight:0
+                                                                  items:@[
+                                                                          [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, height.floatValue}],
+                                                                          [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, height.floatValue}],
+                                                                  ]]];
+    }
+    return sections;
+}
+
+- (void)applyRemappingUpdateData:(IGListBatchUpdateData *)updateData sections:(NSArray<IGLayoutTestSection *> *)sections {
+    XCTestExpectation *expectation = [self expectationWithDescription:NSStringFromSelector(_cmd)];
+    [self.collectionView performBatchUpdates:^{
+        self.dataSource.sections = sections;
+        [self.collectionView ig_applyBatchUpdateData:updateData];
+    } completion:^(BOOL finished) {
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    [self.collectionView layoutIfNeeded];
+}
+
+- (void)test_whenRemappingBatchUpdates_withMovedSection_thatNoItemIsMeasuredAgain {
+    [self setUpWithStickyHeaders:NO topInset:0];
+    self.layout.usesBatchUpdateRemapping = YES;
+    [self prepareWithData:genRemappingSections(@[@10, @20, @30, @40])];
+    self.dataSource.sizeForItemCallCount = 0;
+
+    IGListBatchUpdateData *updateData = [[IGListBatchUpdateData alloc] initWithInsertSections:[NSIndexSet new]
+                                                                               deleteSections:[NSIndexSet new]
+                                                                                 moveSections:[NSSet setWithObject:[[IGListMoveIndex alloc] initWithFrom:0 to:3]]
+                                                                             insertIndexPaths:@[]
+                                                                             deleteIndexPaths:@[]
+                                                                             updateIndexPaths:@[]
+                                                                               moveIndexPaths:@[]];
+    [self applyRemappingUpdateData:updateData sections:genRemappingSections(@[@20, @30, @40, @10])];
+
+    XCTAssertEqual(self.dataSource.sizeForItemCallCount, 0);
+    XCTAssertEqual(self.layout.collectionViewContentSize.height, 200);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(0, 0)].frame, 0, 0, 100, 20);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(1, 1)].frame, 0, 70, 100, 30);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(2, 0)].frame, 0, 100, 100, 40);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(3, 1)].frame, 0, 190, 100, 10);
+}
+
+- (void)test_whenRemappingBatchUpdates_withInsertedAndModifiedSections_thatOnlyThoseAreMeasured {
+    [self setUpWithStickyHeaders:NO topInset:0];
+    self.layout.usesBatchUpdateRemapping = YES;
+    [self prepareWithData:genRemappingSections(@[@10, @20, @30, @40])];
+    self.dataSource.sizeForItemCallCount = 0;
+
+    // insert a section at 1, delete the old section 2 and reload an item of the old section 3
+    IGListBatchUpdateData *updateData = [[IGListBatchUpdateData alloc] initWithInsertSections:[NSIndexSet indexSetWithIndex:1]
+                                                                               deleteSections:[NSIndexSet indexSetWithIndex:2]
+                                                                                 moveSections:[NSSet new]
+                                                                             insertIndexPaths:@[]
+                                                                             deleteIndexPaths:@[]
+                                                                             updateIndexPaths:@[genIndexPath(3, 0)]
+                                                                               moveIndexPaths:@[]];
+    [self applyRemappingUpdateData:updateData sections:genRemappingSections(@[@10, @5, @20, @50])];
+
+    XCTAssertEqual(self.dataSource.sizeForItemCallCount, 4);
+    XCTAssertEqual(self.layout.collectionViewContentSize.height, 170);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(1, 1)].frame, 0, 25, 100, 5);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(2, 0)].frame, 0, 30, 100, 20);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(3, 1)].frame, 0, 120, 100, 50);
+}
+
+- (void)test_whenNotRemappingBatchUpdates_withMovedSection_thatShiftedSectionsAreMeasuredAgain {
+    [self setUpWithStickyHeaders:NO topInset:0];
+    [self prepareWithData:genRemappingSections(@[@10, @20, @30, @40])];
+    self.dataSource.sizeForItemCallCount = 0;
+
+    IGListBatchUpdateData *updateData = [[IGListBatchUpdateData alloc] initWithInsertSections:[NSIndexSet new]
+                                                                               deleteSections:[NSIndexSet new]
+                                                                                 moveSections:[NSSet setWithObject:[[IGListMoveIndex alloc] initWithFrom:0 to:3]]
+                                                                             insertIndexPaths:@[]
+                                                                             deleteIndexPaths:@[]
+                                                                             updateIndexPaths:@[]
+                                                                               moveIndexPaths:@[]];
+    [self applyRemappingUpdateData:updateData sections:genRemappingSections(@[@20, @30, @40, @10])];
+
+    XCTAssertEqual(self.dataSource.sizeForItemCallCount, 8);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(3, 1)].frame, 0, 190, 100, 10);
+}
+
+static NSArray<IGLayoutTestSection *> *genGridSection(NSInteger itemCount, NSInteger tallItem) {
+    NSMutableArray *items = [NSMutableArray new];
+    for (NSInteger item = 0; item < itemCount; item++) {
+        [items addObject:[[IGLayoutTestItem alloc] initWithSize:(CGSize) {25, item == tallItem ? 30 : 10}]];
+    }
+    return @[[[IGLayoutTestSection alloc] initWithInsets:UIEdgeInsetsZero
+                                             lineSpacing:0
+                                        interitemSpacing:0
+                                            headerHeight:0
+                                            footerHeight:0
+                                                   items:items]];
+}
+
+- (void)test_whenInvalidatingItem_inLargeSection_thatOnlyItsRowAndTheRestAreMeasuredAgain {
+    [self setUpWithStickyHeaders:NO topInset:0];
+    [self prepareWithData:genGridSection(200, NSNotFound)];
+    self.dataSource.sizeForItemCallCount = 0;
+
+    // 4 items per row, item 190 is on the row starting at item 188
+    self.dataSource.sections = genGridSection(200, 190);
+    IGListCollectionViewLayoutInvalidationContext *context = [IGListCollectionViewLayoutInvalidationContext new];
+    [context invalidateItemsAtIndexPaths:@[genIndexPath(0, 190)]];
+    [self.layout invalidateLayoutWithContext:context];
+    [self.collectionView layoutIfNeeded];
+
+    XCTAssertEqual(self.dataSource.sizeForItemCallCount, 12);
+    XCTAssertEqual(self.layout.collectionViewContentSize.height, 520);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(0, 187)].frame, 75, 460, 25, 10);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(0, 190)].frame, 50, 470, 25, 30);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(0, 192)].frame, 0, 500, 25, 10);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(0, 199)].frame, 75, 510, 25, 10);
+}
+
+- (void)test_whenInvalidatingItem_inConcurrentLayout_thatWholeSectionIsMeasuredAgain {
+    [self setUpWithStickyHeaders:NO topInset:0];
+    self.layout.usesConcurrentSectionLayout = YES;
+    [self prepareWithData:genGridSection(200, NSNotFound)];
+    self.dataSource.sizeForItemCallCount = 0;
+
+    self.dataSource.sections = genGridSection(200, 190);
+    IGListCollectionViewLayoutInvalidationContext *context = [IGListCollectionViewLayoutInvalidationContext new];
+    [context invalidateItemsAtIndexPaths:@[genIndexPath(0, 190)]];
+    [self.layout invalidateLayoutWithContext:context];
+    [self.collectionView layoutIfNeeded];
+
+    XCTAssertEqual(self.dataSource.sizeForItemCallCount, 200);
+    XCTAssertEqual(self.layout.collectionViewContentSize.height, 520);
+    IGAssertEqualFrame([self.layout layoutAttributesForItemAtIndexPath:genIndexPath(0, 192)].frame, 0, 500, 25, 10);
+}
+
+- (void)test_whenSectionHasColumns_thatItemsArePackedInShortestColumn {
+    [self setUpWithStickyHeaders:NO topInset:0];
+    IGLayoutTestSection *columns = [[IGLayoutTestSection alloc] initWithInsets:UIEdgeInsetsZero
+                                                                    lineSpacing:0
+                                                               interitemSpacing:0
+                                                                   headerHeight:10
+                                                                   footerHeight:0
+                                                                          items:@[
+                                                                                  [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, 30}],
+                                                                                  [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, 10}],
+                                                                                  [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, 10}],
+                                                                                  [[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, 20}],
+                                                                          ]];
+    columns.numberOfColumns = 2;
+    [self prepareWithData:@[
+                            genLayoutTestSection(@[[[IGLayoutTestItem alloc] initWithSize:(CGSize) {100, 20}]]),
+                            columns,
+                            ]];
+
+    XCTAssertEqual(self.layout.collectionViewContentSize.height, 70);
+    IGAssertEqualFrame([self headerForSection:1].frame, 0, 20, 100, 10);
+    IGAssertEqualFrame([self cellForSection:1 item:0].frame, 0, 30, 50, 30);
+    IGAssertEqualFrame([self cellForSection:1 item:1].frame, 50, 30, 50, 10);
+    IGAssertEqualFrame([self cellForSection:1 item:2].frame, 50, 40, 50, 10);
+    IGAssertEqualFrame([self cellForSection:1 item:3].frame, 50, 50, 50, 20);
+
+    NSMutableSet<NSIndexPath *> *indexPaths = [NSMutableSet new];
+    for (UICollectionViewLayoutAttributes *attributes in [self.layout layoutAttributesForElementsInRect:CGRectMake(0, 55, 100, 10)]) {
+        [indexPaths addObject:attributes.indexPath];
+    }
+    XCTAssertEqualObjects(indexPaths, ([NSSet setWithObjects:genIndexPath(1, 0), genIndexPath(1, 3), nil]));
+}
+
 #pragma mark - Internal debugging
 
 - (void)test_withDelegateNameDebugger_thatReturnedNamesAreValid {
@@ -255,4 +255,26 @@
     [self.mockAdapterDelegate verify];
 }
 
+- (void)test_whenDisplayingAndEndingCells_thatVisibleCellsAreTrackedPerSectionController {
+    IGListTestSection *otherList = [IGListTestSection new];
+    UICollectionViewCell *first = [UICollectionViewCell new];
+    UICollectionViewCell *second = [UICollectionViewCell new];
+    UICollectionViewCell *other = [UICollectionViewCell new];
+    [self.displayHandler willDisplayCell:first forListAdapter:self.adapter sectionController:self.list object:self.object indexPath:[NSIndexPath indexPathForItem:0 inSection:0]];
+    [self.displayHandler willDisplayCell:second forListAdapter:self.adapter sectionController:self.list object:self.object indexPath:[NSIndexPath indexPathForItem:1 inSection:0]];
+    [self.displayHandler willDisplayCell:other forListAdapter:self.adapter sectionController:otherList object:@1 indexPath:[NSIndexPath indexPathForItem:0 inSection:1]];
+    // displaying a cell again does not register it twice
+    [self.displayHandler willDisplayCell:first forListAdapter:self.adapter sectionController:self.list object:self.object indexPath:[NSIndexPath indexPathForItem:0 inSection:0]];
+
+    XCTAssertEqualObjects([self.displayHandler visibleCellsForSectionController:self.list], (@[first, second]));
+    XCTAssertEqualObjects([self.displayHandler visibleCellsForSectionController:otherList], @[other]);
+
+    [self.displayHandler didEndDisplayingCell:first forListAdapter:self.adapter sectionController:self.list indexPath:[NSIndexPath indexPathForItem:0 inSection:0]];
+    [self.displayHandler didEndDisplayingCell:other forListAdapter:self.adapter sectionController:otherList indexPath:[NSIndexPath indexPathForItem:0 inSection:1]];
+
+    XCTAssertEqualObjects([self.displayHandler visibleCellsForSectionController:self.list], @[second]);
+    XCTAssertEqualObjects([self.displayHandler visibleCellsForSectionController:otherList], @[]);
+    XCTAssertEqual(self.displayHandler.visibleCellsBySectionController.count, 1);
+}
+
 @end
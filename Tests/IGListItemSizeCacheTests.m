@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <IGListKit/IGListKit.h>
+
+#import "IGListItemSizeCache.h"
+#import "IGTestObject.h"
+
+static const CGSize kContainerSize = (CGSize){100, 200};
+
+@interface IGListItemSizeCacheTests : XCTestCase
+
+@property (nonatomic, strong) IGListItemSizeCache *cache;
+
+@end
+
+@implementation IGListItemSizeCacheTests
+
+- (void)setUp {
+    [super setUp];
+    self.cache = [IGListItemSizeCache new];
+}
+
+- (void)tearDown {
+    [super tearDown];
+    self.cache = nil;
+}
+
+- (void)setSize:(CGSize)size object:(id<IGListDiffable>)object index:(NSInteger)index containerSize:(CGSize)containerSize {
+    [self.cache setSize:size
+              forObject:object
+                atIndex:index
+          containerSize:containerSize
+         containerInset:UIEdgeInsetsZero
+        traitCollection:nil];
+}
+
+- (BOOL)getSize:(CGSize *)size object:(id<IGListDiffable>)object index:(NSInteger)index containerSize:(CGSize)containerSize {
+    return [self.cache getSize:size
+                     forObject:object
+                       atIndex:index
+                 containerSize:containerSize
+                containerInset:UIEdgeInsetsZero
+               traitCollection:nil];
+}
+
+- (void)test_whenSettingSize_thatSameKeyReturnsIt {
+    IGTestObject *object = genTestObject(@1, @"a");
+    [self setSize:CGSizeMake(10, 20) object:object index:2 containerSize:kContainerSize];
+
+    CGSize size = CGSizeZero;
+    XCTAssertTrue([self getSize:&size object:object index:2 containerSize:kContainerSize]);
+    XCTAssertTrue(CGSizeEqualToSize(size, CGSizeMake(10, 20)));
+    XCTAssertFalse([self getSize:&size object:object index:1 containerSize:kContainerSize]);
+    XCTAssertFalse([self getSize:&size object:object index:2 containerSize:CGSizeMake(200, 100)]);
+}
+
+- (void)test_whenSwitchingContainerSizes_thatPreviousSizesAreKept {
+    IGTestObject *object = genTestObject(@1, @"a");
+    [self setSize:CGSizeMake(100, 20) object:object index:0 containerSize:kContainerSize];
+    [self setSize:CGSizeMake(200, 10) object:object index:0 containerSize:CGSizeMake(200, 100)];
+
+    CGSize size = CGSizeZero;
+    XCTAssertTrue([self getSize:&size object:object index:0 containerSize:kContainerSize]);
+    XCTAssertTrue(CGSizeEqualToSize(size, CGSizeMake(100, 20)));
+    XCTAssertTrue([self getSize:&size object:object index:0 containerSize:CGSizeMake(200, 100)]);
+    XCTAssertTrue(CGSizeEqualToSize(size, CGSizeMake(200, 10)));
+}
+
+- (void)test_whenUpdatingWithEqualObject_thatSizesAreKept {
+    [self setSize:CGSizeMake(10, 20) object:genTestObject(@1, @"a") index:0 containerSize:kContainerSize];
+    [self.cache updateWithObjects:@[genTestObject(@1, @"a")]];
+
+    CGSize size = CGSizeZero;
+    XCTAssertTrue([self getSize:&size object:genTestObject(@1, @"a") index:0 containerSize:kContainerSize]);
+}
+
+- (void)test_whenUpdatingWithChangedObject_thatSizesAreDropped {
+    [self setSize:CGSizeMake(10, 20) object:genTestObject(@1, @"a") index:0 containerSize:kContainerSize];
+    [self setSize:CGSizeMake(10, 20) object:genTestObject(@2, @"b") index:0 containerSize:kContainerSize];
+    [self.cache updateWithObjects:@[genTestObject(@1, @"changed"), genTestObject(@2, @"b")]];
+
+    CGSize size = CGSizeZero;
+    XCTAssertFalse([self getSize:&size object:genTestObject(@1, @"changed") index:0 containerSize:kContainerSize]);
+    XCTAssertTrue([self getSize:&size object:genTestObject(@2, @"b") index:0 containerSize:kContainerSize]);
+}
+
+- (void)test_whenUpdatingWithoutObject_thatSizesAreDropped {
+    [self setSize:CGSizeMake(10, 20) object:genTestObject(@1, @"a") index:0 containerSize:kContainerSize];
+    [self.cache updateWithObjects:@[]];
+    [self.cache updateWithObjects:@[genTestObject(@1, @"a")]];
+
+    CGSize size = CGSizeZero;
+    XCTAssertFalse([self getSize:&size object:genTestObject(@1, @"a") index:0 containerSize:kContainerSize]);
+}
+
+- (void)test_whenUpdatingWithDiff_thatOnlyDeletedAndUpdatedSizesAreDropped {
+    NSArray *fromObjects = @[genTestObject(@1, @"a"), genTestObject(@2, @"b"), genTestObject(@3, @"c")];
+    for (IGTestObject *object in fromObjects) {
+        [self setSize:CGSizeMake(10, 20) object:object index:0 containerSize:kContainerSize];
+    }
+    NSArray *toObjects = @[genTestObject(@3, @"c"), genTestObject(@1, @"changed")];
+    [self.cache updateWithFromObjects:fromObjects diffResult:IGListDiff(fromObjects, toObjects, IGListDiffEquality)];
+
+    CGSize size = CGSizeZero;
+    XCTAssertFalse([self getSize:&size object:toObjects[1] index:0 containerSize:kContainerSize]);
+    XCTAssertFalse([self getSize:&size object:fromObjects[1] index:0 containerSize:kContainerSize]);
+    XCTAssertTrue([self getSize:&size object:toObjects[0] index:0 containerSize:kContainerSize]);
+}
+
+- (void)test_whenInvalidatingObject_thatOnlyItsSizesAreDropped {
+    IGTestObject *object = genTestObject(@1, @"a");
+    IGTestObject *otherObject = genTestObject(@2, @"b");
+    [self setSize:CGSizeMake(10, 20) object:object index:0 containerSize:kContainerSize];
+    [self setSize:CGSizeMake(10, 20) object:object index:0 containerSize:CGSizeMake(200, 100)];
+    [self setSize:CGSizeMake(10, 20) object:otherObject index:0 containerSize:kContainerSize];
+    [self.cache invalidateSizesForObject:object];
+
+    CGSize size = CGSizeZero;
+    XCTAssertFalse([self getSize:&size object:object index:0 containerSize:kContainerSize]);
+    XCTAssertFalse([self getSize:&size object:object index:0 containerSize:CGSizeMake(200, 100)]);
+    XCTAssertTrue([self getSize:&size object:otherObject index:0 containerSize:kContainerSize]);
+}
+
+@end
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <OCMock/OCMock.h>
+
+#import <IGListKit/IGListPrefetchScheduler.h>
+#import <IGListKit/IGListReloadDataUpdater.h>
+
+#import "IGListAdapterInternal.h"
+#import "IGListTestAdapterDataSource.h"
+#import "IGListTestSection.h"
+
+@interface IGListPrefetchSchedulerTests : XCTestCase
+
+@property (nonatomic, strong) IGListAdapter *adapter;
+@property (nonatomic, strong) IGListTestAdapterDataSource *dataSource;
+
+@end
+
+@implementation IGListPrefetchSchedulerTests
+
+- (void)setUp {
+    [super setUp];
+
+    // five sections, with only the first one displayed
+    self.dataSource = [IGListTestAdapterDataSource new];
+    self.dataSource.objects = @[@0, @1, @2, @3, @4];
+    self.adapter = [[IGListAdapter alloc] initWithUpdater:[IGListReloadDataUpdater new] viewController:nil];
+    self.adapter.collectionView = [OCMockObject niceMockForClass:[UICollectionView class]];
+    self.adapter.dataSource = self.dataSource;
+    [self.adapter performUpdatesAnimated:NO completion:nil];
+    [self.adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0] forListAdapter:self.adapter];
+}
+
+- (void)tearDown {
+    self.adapter = nil;
+    self.dataSource = nil;
+    [super tearDown];
+}
+
+// Occupies the only worker until the returned semaphore is signaled
+- (dispatch_semaphore_t)blockWorkerWithSectionController:(IGListSectionController *)sectionController
+                                             isCancelled:(BOOL *)isCancelledAfterRelease
+                                             expectation:(XCTestExpectation *)expectation {
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [self.adapter.prefetchScheduler submitTaskForSectionController:sectionController task:^(IGListPrefetchCancellationCheck isCancelled) {
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+        if (isCancelledAfterRelease != NULL) {
+            *isCancelledAfterRelease = isCancelled();
+        }
+        [expectation fulfill];
+    }];
+    return semaphore;
+}
+
+- (void)test_whenWorkerFreesUp_thatClosestPendingTaskRunsFirst {
+    IGListPrefetchScheduler *scheduler = self.adapter.prefetchScheduler;
+    scheduler.maxConcurrentTaskCount = 1;
+
+    XCTestExpectation *blockingExpectation = [self expectationWithDescription:@"blocking task"];
+    dispatch_semaphore_t semaphore = [self blockWorkerWithSectionController:[self.adapter sectionControllerForSection:0]
+                                                                isCancelled:NULL
+                                                                expectation:blockingExpectation];
+
+    NSMutableArray<NSNumber *> *order = [NSMutableArray new];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"prefetch tasks"];
+    expectation.expectedFulfillmentCount = 3;
+    for (NSNumber *section in @[@4, @1, @3]) {
+        [scheduler submitTaskForSectionController:[self.adapter sectionControllerForSection:section.integerValue]
+                                             task:^(IGListPrefetchCancellationCheck isCancelled) {
+            @synchronized (order) {
+                [order addObject:section];
+            }
+            [expectation fulfill];
+        }];
+    }
+    XCTAssertEqual(scheduler.runningTaskCount, 1);
+    XCTAssertEqual(scheduler.pendingTaskCount, 3);
+
+    dispatch_semaphore_signal(semaphore);
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqualObjects(order, (@[@1, @3, @4]));
+}
+
+- (void)test_whenSectionControllerExitsWorkingRange_thatItsTasksAreCancelled {
+    IGListPrefetchScheduler *scheduler = self.adapter.prefetchScheduler;
+    scheduler.maxConcurrentTaskCount = 1;
+    IGListSectionController *firstSectionController = [self.adapter sectionControllerForSection:0];
+
+    BOOL isCancelledAfterRelease = NO;
+    XCTestExpectation *blockingExpectation = [self expectationWithDescription:@"blocking task"];
+    dispatch_semaphore_t semaphore = [self blockWorkerWithSectionController:firstSectionController
+                                                                isCancelled:&isCancelledAfterRelease
+                                                                expectation:blockingExpectation];
+    [scheduler submitTaskForSectionController:firstSectionController task:^(IGListPrefetchCancellationCheck isCancelled) {
+        XCTFail(@"Pending task of a section controller that exited the working range should not run");
+    }];
+    XCTAssertEqual(scheduler.pendingTaskCount, 1);
+
+    [self.adapter.workingRangeHandler didEndDisplayingItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0] forListAdapter:self.adapter];
+    XCTAssertEqual(scheduler.pendingTaskCount, 0);
+
+    dispatch_semaphore_signal(semaphore);
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertTrue(isCancelledAfterRelease);
+}
+
+@end
@@ -13,6 +13,7 @@
 #import "IGListTestAdapterDataSource.h"
 #import "IGListTestAdapterReorderingDataSource.h"
 #import "IGListTestSection.h"
+#import "IGListTransitionDataInternal.h"
 #import "IGTestReorderableSection.h"
 #import "UICollectionViewLayout+InteractiveReordering.h"
 
@@ -69,6 +70,22 @@
     XCTAssertNoThrow([updater willCrashWithCollectionView:self.collectionView sectionControllerClass:[NSObject class]]);
 }
 
+- (void)test_whenCommittingPreparedUpdate_thatPreparedDiffIsNotApplied {
+    self.dataSource.objects = @[@0, @1, @2];
+    [self.adapter reloadDataWithCompletion:nil];
+    IGListSectionController *controller = [self.adapter sectionControllerForObject:@1];
+
+    IGListPreparedUpdate *preparedUpdate = [self.adapter prepareUpdateWithObjects:@[@1, @3]];
+    self.dataSource.objects = @[@1, @3];
+    [self.adapter commitPreparedUpdate:preparedUpdate animated:NO completion:nil];
+
+    // the section map looks up the section controllers of existing objects itself, so the diff doesn't describe them
+    XCTAssertNil(self.adapter.committedData.diffResult);
+    XCTAssertEqual([self.collectionView numberOfSections], 2);
+    XCTAssertEqual([self.adapter sectionControllerForObject:@1], controller);
+    XCTAssertEqual([self.adapter sectionForSectionController:controller], 0);
+}
+
 - (void)test_whenInsertingIntoContext_thatCollectionViewUpdated {
     self.dataSource.objects = @[@2];
     [self.adapter reloadDataWithCompletion:nil];
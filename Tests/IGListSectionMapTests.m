@@ -7,7 +7,10 @@
 
 #import <XCTest/XCTest.h>
 
+#import <IGListDiffKit/IGListDiff.h>
+
 #import "IGTestDiffingObject.h"
+#import "IGListAdapterUpdater.h"
 #import "IGListSectionMap.h"
 #import "IGListTestSection.h"
 #import "IGTestObject.h"
@@ -50,6 +53,24 @@
     XCTAssertEqual([map sectionForSectionController:sectionControllers[1]], 1);
 }
 
+- (void)test_whenCreatingMapOfEarlierSections_thatSectionsOfSectionControllersAreUntouched {
+    NSArray *objects = @[@0, @1, @2];
+    NSArray *sectionControllers = @[[IGListTestSection new], [IGListTestSection new], [IGListTestSection new]];
+    IGListSectionMap *map = [[IGListSectionMap alloc] initWithMapTable:[NSMapTable strongToStrongObjectsMapTable]];
+    [map updateWithObjects:objects sectionControllers:sectionControllers];
+
+    NSArray *earlierSectionControllers = @[sectionControllers[2], sectionControllers[0]];
+    IGListSectionMap *earlierMap = [[IGListSectionMap alloc] initWithObjects:@[@2, @0]
+                                                          sectionControllers:earlierSectionControllers
+                                                                 lookupOfMap:map];
+    XCTAssertEqual([earlierMap sectionForSectionController:sectionControllers[2]], 0);
+    XCTAssertEqual([earlierMap sectionForObject:@0], 1);
+    XCTAssertEqual([earlierMap sectionForObject:@1], NSNotFound);
+    XCTAssertEqualObjects(earlierMap.sectionControllers, earlierSectionControllers);
+    XCTAssertEqual([sectionControllers[2] section], 2);
+    XCTAssertEqual([sectionControllers[0] section], 0);
+}
+
 - (void)test_whenUpdatingItems_withUnknownItem_thatSectionControllerIsNil {
     NSArray *objects = @[@0, @1, @2];
     NSArray *sectionControllers = @[[IGListTestSection new], [IGListTestSection new], [IGListTestSection new]];
@@ -178,4 +199,127 @@
     XCTAssertThrows([map updateObject:@99]);
 }
 
+- (void)test_whenReadingObjects_thatBackingArrayIsShared {
+    NSArray *objects = @[@0, @1, @2];
+    NSArray *sectionControllers = @[[IGListTestSection new], [IGListTestSection new], [IGListTestSection new]];
+    IGListSectionMap *map = [[IGListSectionMap alloc] initWithMapTable:[NSMapTable strongToStrongObjectsMapTable]];
+    [map updateWithObjects:objects sectionControllers:sectionControllers];
+
+    IGListSectionMap *copy = [map copy];
+
+    XCTAssertTrue(map.objects == objects);
+    XCTAssertTrue(map.objects == map.objects);
+    XCTAssertTrue(copy.objects == map.objects);
+}
+
+- (void)test_whenUpdatingMapAfterCopying_thatCopyKeepsPreviousState {
+    NSArray *objects = @[@0, @1, @2];
+    NSArray *sectionControllers = @[[IGListTestSection new], [IGListTestSection new], [IGListTestSection new]];
+    IGListSectionMap *map = [[IGListSectionMap alloc] initWithMapTable:[NSMapTable strongToStrongObjectsMapTable]];
+    [map updateWithObjects:objects sectionControllers:sectionControllers];
+    IGListSectionMap *copy = [map copy];
+
+    // replacing an object copies the shared array and maps before writing
+    NSArray *objectsBeforeUpdate = map.objects;
+    [map updateObject:@1];
+    XCTAssertTrue(map.objects != objectsBeforeUpdate);
+    XCTAssertTrue(copy.objects == objectsBeforeUpdate);
+
+    NSArray *newObjects = @[@3, @4];
+    NSArray *newSectionControllers = @[[IGListTestSection new], [IGListTestSection new]];
+    [map updateWithObjects:newObjects sectionControllers:newSectionControllers];
+
+    XCTAssertEqualObjects(map.objects, newObjects);
+    XCTAssertEqual([map sectionControllerForObject:@3], newSectionControllers[0]);
+    XCTAssertNil([map sectionControllerForObject:@1]);
+    XCTAssertEqualObjects(copy.objects, objects);
+    XCTAssertEqual([copy sectionControllerForObject:@1], sectionControllers[1]);
+    XCTAssertEqual([copy sectionForSectionController:sectionControllers[2]], 2);
+    XCTAssertNil([copy sectionControllerForObject:@3]);
+}
+
+- (void)test_whenLookingUpObjectsByDiffIdentifier_thatReplacedObjectKeepsItsSection {
+    NSPointerFunctions *keyFunctions = [[IGListAdapterUpdater new] objectLookupPointerFunctions];
+    NSPointerFunctions *valueFunctions = [NSPointerFunctions pointerFunctionsWithOptions:NSPointerFunctionsStrongMemory];
+    NSMapTable *table = [[NSMapTable alloc] initWithKeyPointerFunctions:keyFunctions valuePointerFunctions:valueFunctions capacity:0];
+    IGListSectionMap *map = [[IGListSectionMap alloc] initWithMapTable:table];
+    NSArray *objects = @[genTestObject(@1, @"a"), genTestObject(@2, @"b"), genTestObject(@3, @"c")];
+    NSArray *sectionControllers = @[[IGListTestSection new], [IGListTestSection new], [IGListTestSection new]];
+    [map updateWithObjects:objects sectionControllers:sectionControllers];
+
+    XCTAssertEqual([map sectionForObject:genTestObject(@2, @"x")], 1);
+    XCTAssertEqual([map sectionControllerForObject:genTestObject(@3, @"x")], sectionControllers[2]);
+    XCTAssertEqual([map sectionForObject:genTestObject(@4, @"a")], NSNotFound);
+
+    IGTestObject *updated = genTestObject(@2, @"d");
+    [map updateObject:updated];
+
+    XCTAssertEqual([map objectForSection:1], updated);
+    XCTAssertEqual([map sectionForObject:updated], 1);
+    XCTAssertEqual([map sectionForObject:objects[1]], 1);
+    XCTAssertEqual([map sectionForSectionController:sectionControllers[1]], 1);
+    XCTAssertEqual([map sectionForObject:objects[2]], 2);
+}
+
+- (void)assertMap:(IGListSectionMap *)map
+      hasObjects:(NSArray *)objects
+sectionControllers:(NSArray<IGListSectionController *> *)sectionControllers {
+    XCTAssertEqualObjects(map.objects, objects);
+    for (NSInteger section = 0; section < (NSInteger)objects.count; section++) {
+        IGListSectionController *sectionController = sectionControllers[section];
+        XCTAssertEqual([map sectionControllerForSection:section], sectionController);
+        XCTAssertEqual([map sectionForObject:objects[section]], section);
+        XCTAssertEqual([map sectionForSectionController:sectionController], section);
+        XCTAssertEqual(sectionController.section, section);
+        XCTAssertEqual(sectionController.isFirstSection, section == 0);
+        XCTAssertEqual(sectionController.isLastSection, section == (NSInteger)objects.count - 1);
+    }
+}
+
+- (void)test_whenApplyingDiff_thatMapMatchesFullUpdate {
+    IGListSectionMap *map = [[IGListSectionMap alloc] initWithMapTable:[NSMapTable strongToStrongObjectsMapTable]];
+    NSArray *objects = @[@0, @1, @2, @3, @4];
+    NSMutableDictionary<NSNumber *, IGListSectionController *> *sectionControllersByObject = [NSMutableDictionary new];
+    NSArray<IGListSectionController *> *(^sectionControllersForObjects)(NSArray *) = ^(NSArray *objectsToMap) {
+        NSMutableArray *sectionControllers = [NSMutableArray new];
+        for (NSNumber *object in objectsToMap) {
+            if (sectionControllersByObject[object] == nil) {
+                sectionControllersByObject[object] = [IGListTestSection new];
+            }
+            [sectionControllers addObject:sectionControllersByObject[object]];
+        }
+        return sectionControllers;
+    };
+    [map updateWithObjects:objects sectionControllers:sectionControllersForObjects(objects)];
+
+    // insert at the end, delete in the middle, move to the front, then delete the first section
+    NSArray *transitions = @[@[@0, @1, @2, @3, @4, @5],
+                             @[@0, @1, @3, @4, @5],
+                             @[@5, @0, @1, @3, @4],
+                             @[@0, @1, @3, @4]];
+    for (NSArray *toObjects in transitions) {
+        NSArray *fromObjects = map.objects;
+        IGListIndexSetResult *diffResult = IGListDiff(fromObjects, toObjects, IGListDiffEquality);
+        NSArray *sectionControllers = sectionControllersForObjects(toObjects);
+        [map updateWithObjects:toObjects sectionControllers:sectionControllers fromObjects:fromObjects diffResult:diffResult];
+        [self assertMap:map hasObjects:toObjects sectionControllers:sectionControllers];
+    }
+    XCTAssertEqual(sectionControllersByObject[@2].section, NSNotFound);
+    XCTAssertEqual(sectionControllersByObject[@5].section, NSNotFound);
+    XCTAssertFalse(sectionControllersByObject[@5].isFirstSection);
+}
+
+- (void)test_whenApplyingDiffFromOtherObjects_thatMapIsRebuilt {
+    IGListSectionMap *map = [[IGListSectionMap alloc] initWithMapTable:[NSMapTable strongToStrongObjectsMapTable]];
+    [map updateWithObjects:@[@0, @1] sectionControllers:@[[IGListTestSection new], [IGListTestSection new]]];
+
+    // a diff that does not start from the objects of the map
+    NSArray *toObjects = @[@1, @2, @3];
+    NSArray *sectionControllers = @[[IGListTestSection new], [IGListTestSection new], [IGListTestSection new]];
+    IGListIndexSetResult *diffResult = IGListDiff(@[@7], toObjects, IGListDiffEquality);
+    [map updateWithObjects:toObjects sectionControllers:sectionControllers fromObjects:@[@7] diffResult:diffResult];
+
+    [self assertMap:map hasObjects:toObjects sectionControllers:sectionControllers];
+}
+
 @end
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <IGListKit/IGListKit.h>
+
+#import "IGListSizeSnapshotStore.h"
+#import "IGTestObject.h"
+
+@interface IGSizeSnapshotTestObject : IGTestObject <IGListSizeSnapshotContent>
+@end
+
+@implementation IGSizeSnapshotTestObject
+
+- (uint64_t)sizeSnapshotContentHash {
+    return [self.value unsignedLongLongValue];
+}
+
+@end
+
+#define genSnapshotObject(k, v) [[IGSizeSnapshotTestObject alloc] initWithKey:k value:v]
+
+@interface IGListSizeSnapshotStoreTests : XCTestCase
+
+@property (nonatomic, copy) NSString *path;
+
+@end
+
+@implementation IGListSizeSnapshotStoreTests
+
+- (void)setUp {
+    [super setUp];
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:nil];
+    self.path = nil;
+    [super tearDown];
+}
+
+- (IGListSizeSnapshotStore *)storeWrittenWithObjects:(NSArray *)objects {
+    IGListSizeSnapshotStore *store = [[IGListSizeSnapshotStore alloc] initWithContentsOfFile:self.path];
+    XCTAssertFalse(store.loaded);
+    for (id<IGListDiffable> object in objects) {
+        [store recordSize:CGSizeMake(100, 44) forObject:object atIndex:0 containerWidth:100];
+    }
+    XCTAssertTrue([store writeToFile:self.path]);
+    return [[IGListSizeSnapshotStore alloc] initWithContentsOfFile:self.path];
+}
+
+- (void)test_whenWritingSizes_thatNextStoreReturnsThem {
+    IGListSizeSnapshotStore *store = [self storeWrittenWithObjects:@[genSnapshotObject(@"a", @1), genSnapshotObject(@2, @1)]];
+    XCTAssertTrue(store.loaded);
+
+    CGSize size = CGSizeZero;
+    XCTAssertTrue([store getSize:&size forObject:genSnapshotObject(@"a", @1) atIndex:0 containerWidth:100]);
+    XCTAssertTrue(CGSizeEqualToSize(size, CGSizeMake(100, 44)));
+    XCTAssertTrue([store getSize:&size forObject:genSnapshotObject(@2, @1) atIndex:0 containerWidth:100]);
+    XCTAssertFalse([store getSize:&size forObject:genSnapshotObject(@"a", @1) atIndex:1 containerWidth:100]);
+    XCTAssertFalse([store getSize:&size forObject:genSnapshotObject(@"a", @1) atIndex:0 containerWidth:200]);
+}
+
+- (void)test_whenContentHashChanges_thatSizeIsMissing {
+    IGListSizeSnapshotStore *store = [self storeWrittenWithObjects:@[genSnapshotObject(@"a", @1)]];
+
+    CGSize size = CGSizeZero;
+    XCTAssertFalse([store getSize:&size forObject:genSnapshotObject(@"a", @2) atIndex:0 containerWidth:100]);
+}
+
+- (void)test_whenObjectDoesNotConform_thatSizeIsNotPersisted {
+    IGListSizeSnapshotStore *store = [self storeWrittenWithObjects:@[genTestObject(@"a", @1)]];
+
+    CGSize size = CGSizeZero;
+    XCTAssertFalse([store getSize:&size forObject:genTestObject(@"a", @1) atIndex:0 containerWidth:100]);
+    XCTAssertFalse([store getSize:&size forObject:genSnapshotObject(@"a", @1) atIndex:0 containerWidth:100]);
+}
+
+- (void)test_whenIdentifiersOnlyDifferInType_thatSizesAreNotShared {
+    IGListSizeSnapshotStore *store = [self storeWrittenWithObjects:@[genSnapshotObject(@1, @1)]];
+
+    CGSize size = CGSizeZero;
+    XCTAssertTrue([store getSize:&size forObject:genSnapshotObject(@1, @1) atIndex:0 containerWidth:100]);
+    XCTAssertFalse([store getSize:&size forObject:genSnapshotObject(@"1", @1) atIndex:0 containerWidth:100]);
+}
+
+- (void)test_whenSizeIsReturned_thatItIsPendingVerificationOnce {
+    IGListSizeSnapshotStore *store = [self storeWrittenWithObjects:@[genSnapshotObject(@"a", @1)]];
+    IGSizeSnapshotTestObject *object = genSnapshotObject(@"a", @1);
+
+    CGSize size = CGSizeZero;
+    XCTAssertFalse([store consumePendingVerificationForObject:object atIndex:0 snapshotSize:&size]);
+    XCTAssertTrue([store getSize:&size forObject:object atIndex:0 containerWidth:100]);
+
+    CGSize snapshotSize = CGSizeZero;
+    XCTAssertTrue([store consumePendingVerificationForObject:object atIndex:0 snapshotSize:&snapshotSize]);
+    XCTAssertTrue(CGSizeEqualToSize(snapshotSize, CGSizeMake(100, 44)));
+    XCTAssertFalse([store consumePendingVerificationForObject:object atIndex:0 snapshotSize:&snapshotSize]);
+}
+
+- (void)test_whenInvalidatingObject_thatSizesAreNoLongerReturned {
+    IGListSizeSnapshotStore *store = [self storeWrittenWithObjects:@[genSnapshotObject(@"a", @1), genSnapshotObject(@"b", @1)]];
+    IGSizeSnapshotTestObject *object = genSnapshotObject(@"a", @1);
+
+    CGSize size = CGSizeZero;
+    XCTAssertTrue([store getSize:&size forObject:object atIndex:0 containerWidth:100]);
+    [store invalidateObject:object];
+    XCTAssertFalse([store consumePendingVerificationForObject:object atIndex:0 snapshotSize:&size]);
+    XCTAssertFalse([store getSize:&size forObject:object atIndex:0 containerWidth:100]);
+    XCTAssertTrue([store getSize:&size forObject:genSnapshotObject(@"b", @1) atIndex:0 containerWidth:100]);
+}
+
+- (void)test_whenRejectingObject_thatAllOfItsPendingVerificationsAreDropped {
+    IGListSizeSnapshotStore *writingStore = [[IGListSizeSnapshotStore alloc] initWithContentsOfFile:self.path];
+    for (NSString *key in @[@"a", @"b"]) {
+        for (NSInteger index = 0; index < 3; index++) {
+            [writingStore recordSize:CGSizeMake(100, 44) forObject:genSnapshotObject(key, @1) atIndex:index containerWidth:100];
+        }
+    }
+    XCTAssertTrue([writingStore writeToFile:self.path]);
+    IGListSizeSnapshotStore *store = [[IGListSizeSnapshotStore alloc] initWithContentsOfFile:self.path];
+    IGSizeSnapshotTestObject *rejected = genSnapshotObject(@"a", @1);
+    IGSizeSnapshotTestObject *other = genSnapshotObject(@"b", @1);
+
+    CGSize size = CGSizeZero;
+    for (NSInteger index = 0; index < 3; index++) {
+        XCTAssertTrue([store getSize:&size forObject:rejected atIndex:index containerWidth:100]);
+        XCTAssertTrue([store getSize:&size forObject:other atIndex:index containerWidth:100]);
+    }
+    [store invalidateObject:rejected];
+
+    for (NSInteger index = 0; index < 3; index++) {
+        XCTAssertFalse([store consumePendingVerificationForObject:rejected atIndex:index snapshotSize:&size]);
+        XCTAssertTrue([store consumePendingVerificationForObject:other atIndex:index snapshotSize:&size]);
+    }
+}
+
+- (void)test_whenReturnedSizeIsNotVerified_thatItIsCarriedOverToNextSnapshot {
+    IGListSizeSnapshotStore *store = [self storeWrittenWithObjects:@[genSnapshotObject(@"a", @1)]];
+
+    CGSize size = CGSizeZero;
+    XCTAssertTrue([store getSize:&size forObject:genSnapshotObject(@"a", @1) atIndex:0 containerWidth:100]);
+    XCTAssertTrue([store writeToFile:self.path]);
+
+    IGListSizeSnapshotStore *nextStore = [[IGListSizeSnapshotStore alloc] initWithContentsOfFile:self.path];
+    XCTAssertTrue([nextStore getSize:&size forObject:genSnapshotObject(@"a", @1) atIndex:0 containerWidth:100]);
+    XCTAssertTrue(CGSizeEqualToSize(size, CGSizeMake(100, 44)));
+}
+
+- (void)test_whenRemovingObject_thatItsSizesAreNotWritten {
+    IGListSizeSnapshotStore *store = [[IGListSizeSnapshotStore alloc] initWithContentsOfFile:self.path];
+    [store recordSize:CGSizeMake(100, 44) forObject:genSnapshotObject(@"a", @1) atIndex:0 containerWidth:100];
+    [store recordSize:CGSizeMake(100, 44) forObject:genSnapshotObject(@"b", @1) atIndex:0 containerWidth:100];
+    [store removeObject:genSnapshotObject(@"a", @1)];
+    XCTAssertTrue([store writeToFile:self.path]);
+
+    IGListSizeSnapshotStore *nextStore = [[IGListSizeSnapshotStore alloc] initWithContentsOfFile:self.path];
+    CGSize size = CGSizeZero;
+    XCTAssertFalse([nextStore getSize:&size forObject:genSnapshotObject(@"a", @1) atIndex:0 containerWidth:100]);
+    XCTAssertTrue([nextStore getSize:&size forObject:genSnapshotObject(@"b", @1) atIndex:0 containerWidth:100]);
+}
+
+- (void)test_whenPruningToObjects_thatOnlyTheirSizesAreWritten {
+    IGListSizeSnapshotStore *store = [self storeWrittenWithObjects:@[genSnapshotObject(@"a", @1), genSnapshotObject(@"b", @1)]];
+    CGSize size = CGSizeZero;
+    XCTAssertTrue([store getSize:&size forObject:genSnapshotObject(@"a", @1) atIndex:0 containerWidth:100]);
+    [store recordSize:CGSizeMake(100, 44) forObject:genSnapshotObject(@"b", @1) atIndex:0 containerWidth:100];
+    [store recordSize:CGSizeMake(100, 44) forObject:genSnapshotObject(@"c", @1) atIndex:0 containerWidth:100];
+    [store pruneToObjects:@[genSnapshotObject(@"b", @1), genSnapshotObject(@"c", @1)]];
+    XCTAssertTrue([store writeToFile:self.path]);
+
+    IGListSizeSnapshotStore *nextStore = [[IGListSizeSnapshotStore alloc] initWithContentsOfFile:self.path];
+    XCTAssertFalse([nextStore getSize:&size forObject:genSnapshotObject(@"a", @1) atIndex:0 containerWidth:100]);
+    XCTAssertTrue([nextStore getSize:&size forObject:genSnapshotObject(@"b", @1) atIndex:0 containerWidth:100]);
+    XCTAssertTrue([nextStore getSize:&size forObject:genSnapshotObject(@"c", @1) atIndex:0 containerWidth:100]);
+}
+
+- (void)test_whenFileIsCorrupted_thatStoreIsNotLoaded {
+    [[@"not a snapshot" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:self.path atomically:YES];
+    IGListSizeSnapshotStore *store = [[IGListSizeSnapshotStore alloc] initWithContentsOfFile:self.path];
+    XCTAssertFalse(store.loaded);
+}
+
+@end
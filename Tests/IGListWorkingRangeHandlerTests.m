@@ -77,10 +77,61 @@
 
 @interface IGListWorkingRangeHandlerTests : XCTestCase
 
+@property (nonatomic, strong) IGListAdapter *adapter;
+@property (nonatomic, strong) _IGTestWorkingRangeAdapterDataSource *dataSource;
+@property (nonatomic, strong) id collectionView;
+@property (nonatomic, copy) NSArray<IGListTestSection *> *sectionControllers;
+@property (nonatomic, copy) NSArray *mockWorkingRangeDelegates;
+
 @end
 
 @implementation IGListWorkingRangeHandlerTests
 
+- (void)tearDown {
+    [super tearDown];
+
+    self.adapter = nil;
+    self.dataSource = nil;
+    self.collectionView = nil;
+    self.sectionControllers = nil;
+    self.mockWorkingRangeDelegates = nil;
+}
+
+/**
+ Sets up an adapter with one section per object, each with its own mock working range delegate, and applies the objects.
+ */
+- (void)_setUpAdapterWithObjects:(NSArray *)objects workingRangeSize:(NSInteger)workingRangeSize niceMocks:(BOOL)niceMocks {
+    NSMutableDictionary *map = [NSMutableDictionary new];
+    NSMutableArray *sectionControllers = [NSMutableArray new];
+    NSMutableArray *mockWorkingRangeDelegates = [NSMutableArray new];
+    for (NSString *object in objects) {
+        IGListTestSection *controller = [[IGListTestSection alloc] init];
+        id mockWorkingRangeDelegate = niceMocks
+        ? [OCMockObject niceMockForProtocol:@protocol(IGListWorkingRangeDelegate)]
+        : [OCMockObject mockForProtocol:@protocol(IGListWorkingRangeDelegate)];
+        controller.workingRangeDelegate = mockWorkingRangeDelegate;
+        map[object] = controller;
+        [sectionControllers addObject:controller];
+        [mockWorkingRangeDelegates addObject:mockWorkingRangeDelegate];
+    }
+    self.sectionControllers = sectionControllers;
+    self.mockWorkingRangeDelegates = mockWorkingRangeDelegates;
+
+    self.dataSource = [[_IGTestWorkingRangeAdapterDataSource alloc] initWithObjects:objects objectToControllerMap:map];
+    IGListReloadDataUpdater *updater = [[IGListReloadDataUpdater alloc] init];
+    self.adapter = [[IGListAdapter alloc] initWithUpdater:updater viewController:nil workingRangeSize:workingRangeSize];
+    self.collectionView = [OCMockObject niceMockForClass:[UICollectionView class]];
+    self.adapter.collectionView = self.collectionView;
+    self.adapter.dataSource = self.dataSource;
+    [self.adapter performUpdatesAnimated:NO completion:nil];
+}
+
+- (void)_verifyMockWorkingRangeDelegates {
+    for (id mockWorkingRangeDelegate in self.mockWorkingRangeDelegates) {
+        [mockWorkingRangeDelegate verify];
+    }
+}
+
 - (void)test_whenDisplayingItemAtPath_withWorkingRangeSizeZero_thatItemEntersWorkingRange {
     // Arrange 1: Set up a simple collection view and adapter with a single element.
     IGListTestSection *controller = [[IGListTestSection alloc] init];
@@ -411,6 +462,271 @@
     [mockWorkingRangeDelegate2 verifyWithDelay:5];
 }
 
+- (void)test_whenScrollingThroughSections_withWorkingRangeSizeOne_thatOnlySectionsJoiningOrLeavingRangeAreNotified {
+    [self _setUpAdapterWithObjects:@[@"obj1", @"obj2", @"obj3", @"obj4"] workingRangeSize:1 niceMocks:NO];
+    IGListAdapter *adapter = self.adapter;
+    NSArray<IGListTestSection *> *controllers = self.sectionControllers;
+    NSArray *mocks = self.mockWorkingRangeDelegates;
+
+    // Act 1: Display the first section, so it and the next one enter the working range.
+    [[mocks[0] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[0]];
+    [[mocks[1] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[1]];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0] forListAdapter:adapter];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:1 inSection:0] forListAdapter:adapter];
+    [self _verifyMockWorkingRangeDelegates];
+
+    // Act 2: Display the second section, so only the third one joins the range.
+    [[mocks[2] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[2]];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:1] forListAdapter:adapter];
+    [self _verifyMockWorkingRangeDelegates];
+
+    // Act 3: Hide one of the two items of the first section, which keeps the range the same.
+    [adapter.workingRangeHandler didEndDisplayingItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0] forListAdapter:adapter];
+
+    // Act 4: Hide the first section and display the third one, so the last section joins.
+    [[mocks[3] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[3]];
+    [adapter.workingRangeHandler didEndDisplayingItemAtIndexPath:[NSIndexPath indexPathForItem:1 inSection:0] forListAdapter:adapter];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:2] forListAdapter:adapter];
+    [self _verifyMockWorkingRangeDelegates];
+
+    // Act 5: Hide the second section, so the first one leaves.
+    [[mocks[0] expect] listAdapter:adapter sectionControllerDidExitWorkingRange:controllers[0]];
+    [adapter.workingRangeHandler didEndDisplayingItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:1] forListAdapter:adapter];
+    [self _verifyMockWorkingRangeDelegates];
+}
+
+- (void)test_whenDisplayingItemAtPath_withWorkingRangeSizeZero_thenInsertingSectionBeforeIt_thatWorkingRangeIsLookedUpAgain {
+    // Arrange 1: Set up a simple collection view and adapter with a single element.
+    IGListTestSection *controller1 = [[IGListTestSection alloc] init];
+    NSString *object1 = @"obj1";
+    IGListTestSection *controller2 = [[IGListTestSection alloc] init];
+    NSString *object2 = @"obj2";
+    _IGTestWorkingRangeAdapterDataSource *ds = [[_IGTestWorkingRangeAdapterDataSource alloc] initWithObjects:@[object1]
+                                                                                       objectToControllerMap:@{object1: controller1}];
+    IGListReloadDataUpdater *updater = [[IGListReloadDataUpdater alloc] init];
+    IGListAdapter *adapter = [[IGListAdapter alloc] initWithUpdater:updater viewController:nil];
+    id collectionView = [OCMockObject niceMockForClass:[UICollectionView class]];
+    adapter.collectionView = collectionView;
+
+    id mockWorkingRangeDelegate1 = [OCMockObject mockForProtocol:@protocol(IGListWorkingRangeDelegate)];
+    id mockWorkingRangeDelegate2 = [OCMockObject mockForProtocol:@protocol(IGListWorkingRangeDelegate)];
+
+    adapter.dataSource = ds;
+    controller1.workingRangeDelegate = mockWorkingRangeDelegate1;
+    controller2.workingRangeDelegate = mockWorkingRangeDelegate2;
+
+    // Arrange 2: Force an update so we get the objects we configured through the system.
+    [adapter performUpdatesAnimated:NO completion:nil];
+
+    // Arrange 3: Tell the working range handler that the first item in the list will be displayed.
+    [[mockWorkingRangeDelegate1 expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controller1];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0] forListAdapter:adapter];
+    [mockWorkingRangeDelegate1 verify];
+
+    // Arrange 4: Insert a second object in the first index, and apply it to the adapter.
+    [ds insertObject:object2 withController:controller2 atIndex:0];
+    [adapter performUpdatesAnimated:NO completion:nil];
+
+    // Act: Display the first section again, which now belongs to the new section controller.
+    [[mockWorkingRangeDelegate2 expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controller2];
+    [[mockWorkingRangeDelegate1 expect] listAdapter:adapter sectionControllerDidExitWorkingRange:controller1];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0] forListAdapter:adapter];
+
+    [mockWorkingRangeDelegate1 verify];
+    [mockWorkingRangeDelegate2 verify];
+}
+
+- (void)test_whenScrollingFast_withWorkingRangeSizeOne_thatRangeLeansTowardScrollDirection_thenBecomesSymmetricWhenIdle {
+    [self _setUpAdapterWithObjects:@[@"obj1", @"obj2", @"obj3", @"obj4"] workingRangeSize:1 niceMocks:NO];
+    IGListAdapter *adapter = self.adapter;
+    NSArray<IGListTestSection *> *controllers = self.sectionControllers;
+    NSArray *mocks = self.mockWorkingRangeDelegates;
+    adapter.directionalWorkingRangeEnabled = YES;
+
+    // Arrange: Display the second section, so the sections around it enter the working range.
+    [[mocks[0] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[0]];
+    [[mocks[1] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[1]];
+    [[mocks[2] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[2]];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:1] forListAdapter:adapter];
+
+    // Act 1: Scroll slowly, which keeps the range symmetric.
+    [adapter.workingRangeHandler updateScrollVelocity:IGListWorkingRangeFullSkewVelocity / 4 forListAdapter:adapter];
+    [self _verifyMockWorkingRangeDelegates];
+
+    // Act 2: Fling toward later sections, so the section behind leaves and the one after the range joins.
+    [[mocks[3] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[3]];
+    [[mocks[0] expect] listAdapter:adapter sectionControllerDidExitWorkingRange:controllers[0]];
+    [adapter.workingRangeHandler updateScrollVelocity:IGListWorkingRangeFullSkewVelocity forListAdapter:adapter];
+    [self _verifyMockWorkingRangeDelegates];
+
+    // Act 3: Stop decelerating, so the range is symmetric again.
+    [[mocks[0] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[0]];
+    [[mocks[3] expect] listAdapter:adapter sectionControllerDidExitWorkingRange:controllers[3]];
+    [adapter scrollViewDidEndDecelerating:self.collectionView];
+    [self _verifyMockWorkingRangeDelegates];
+}
+
+- (void)test_whenScrollVelocityHoversAroundRoundingBoundary_withWorkingRangeSizeOne_thatRangeDoesNotFlipBackAndForth {
+    [self _setUpAdapterWithObjects:@[@"obj1", @"obj2", @"obj3", @"obj4"] workingRangeSize:1 niceMocks:NO];
+    IGListAdapter *adapter = self.adapter;
+    NSArray<IGListTestSection *> *controllers = self.sectionControllers;
+    NSArray *mocks = self.mockWorkingRangeDelegates;
+    adapter.directionalWorkingRangeEnabled = YES;
+
+    // Arrange: Display the second section and fling toward later sections, so the range is ahead of it.
+    [[mocks[0] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[0]];
+    [[mocks[1] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[1]];
+    [[mocks[2] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[2]];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:1] forListAdapter:adapter];
+    [[mocks[3] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[3]];
+    [[mocks[0] expect] listAdapter:adapter sectionControllerDidExitWorkingRange:controllers[0]];
+    [adapter.workingRangeHandler updateScrollVelocity:IGListWorkingRangeFullSkewVelocity forListAdapter:adapter];
+    [self _verifyMockWorkingRangeDelegates];
+
+    // Act 1: Slow down to just below the velocity that rounds to a symmetric range, which keeps the range ahead.
+    [adapter.workingRangeHandler updateScrollVelocity:IGListWorkingRangeFullSkewVelocity * 0.4 forListAdapter:adapter];
+    [adapter.workingRangeHandler updateScrollVelocity:IGListWorkingRangeFullSkewVelocity * 0.6 forListAdapter:adapter];
+    [adapter.workingRangeHandler updateScrollVelocity:IGListWorkingRangeFullSkewVelocity * 0.4 forListAdapter:adapter];
+    [self _verifyMockWorkingRangeDelegates];
+
+    // Act 2: Slow down well past it, so the range is symmetric again.
+    [[mocks[0] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[0]];
+    [[mocks[3] expect] listAdapter:adapter sectionControllerDidExitWorkingRange:controllers[3]];
+    [adapter.workingRangeHandler updateScrollVelocity:IGListWorkingRangeFullSkewVelocity * 0.2 forListAdapter:adapter];
+    [self _verifyMockWorkingRangeDelegates];
+}
+
+- (void)test_whenDragging_withDirectionalWorkingRange_thatRangeLeansTowardGestureVelocity {
+    [self _setUpAdapterWithObjects:@[@"obj1", @"obj2", @"obj3", @"obj4"] workingRangeSize:1 niceMocks:NO];
+    IGListAdapter *adapter = self.adapter;
+    NSArray<IGListTestSection *> *controllers = self.sectionControllers;
+    NSArray *mocks = self.mockWorkingRangeDelegates;
+    adapter.directionalWorkingRangeEnabled = YES;
+
+    // Arrange: Display the second section, so the sections around it enter the working range.
+    [[mocks[0] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[0]];
+    [[mocks[1] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[1]];
+    [[mocks[2] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[2]];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:1] forListAdapter:adapter];
+
+    // Act: Drag the finger up quickly, which scrolls the content toward later sections.
+    id panGestureRecognizer = [OCMockObject niceMockForClass:[UIPanGestureRecognizer class]];
+    [[[panGestureRecognizer stub] andReturnValue:[NSValue valueWithCGPoint:CGPointMake(0, -IGListWorkingRangeFullSkewVelocity)]] velocityInView:[OCMArg any]];
+    id scrollView = [OCMockObject niceMockForClass:[UIScrollView class]];
+    [[[scrollView stub] andReturnValue:@YES] isDragging];
+    [[[scrollView stub] andReturn:panGestureRecognizer] panGestureRecognizer];
+    [[mocks[3] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[3]];
+    [[mocks[0] expect] listAdapter:adapter sectionControllerDidExitWorkingRange:controllers[0]];
+    [adapter scrollViewDidScroll:scrollView];
+    [self _verifyMockWorkingRangeDelegates];
+}
+
+- (void)test_whenScrollingThroughSections_withWorkingRangeTiers_thatEachTierReportsSectionsWithTheirDistance {
+    [self _setUpAdapterWithObjects:@[@"obj1", @"obj2", @"obj3", @"obj4", @"obj5"] workingRangeSize:0 niceMocks:YES];
+    IGListAdapter *adapter = self.adapter;
+    NSArray<IGListTestSection *> *controllers = self.sectionControllers;
+    NSArray *mocks = self.mockWorkingRangeDelegates;
+    adapter.workingRangeTierSizes = @[@1, @2];
+
+    // Act 1: Display the first section, so the next section enters both tiers and the one after only the far tier.
+    [[mocks[0] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[0]];
+    [[mocks[0] expect] listAdapter:adapter sectionController:controllers[0] willEnterWorkingRangeTier:0 distance:0];
+    [[mocks[0] expect] listAdapter:adapter sectionController:controllers[0] willEnterWorkingRangeTier:1 distance:0];
+    [[mocks[1] expect] listAdapter:adapter sectionController:controllers[1] willEnterWorkingRangeTier:0 distance:1];
+    [[mocks[1] expect] listAdapter:adapter sectionController:controllers[1] willEnterWorkingRangeTier:1 distance:1];
+    [[mocks[2] expect] listAdapter:adapter sectionController:controllers[2] willEnterWorkingRangeTier:1 distance:2];
+    [[mocks[2] reject] listAdapter:[OCMArg any] sectionController:[OCMArg any] willEnterWorkingRangeTier:0 distance:2];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0] forListAdapter:adapter];
+    [self _verifyMockWorkingRangeDelegates];
+
+    // Act 2: Scroll to the second section, so the first section leaves the range of size 0 and the tiers move forward.
+    [[mocks[0] expect] listAdapter:adapter sectionControllerDidExitWorkingRange:controllers[0]];
+    [[mocks[0] reject] listAdapter:[OCMArg any] sectionController:[OCMArg any] didExitWorkingRangeTier:0 distance:1];
+    [[mocks[2] expect] listAdapter:adapter sectionController:controllers[2] willEnterWorkingRangeTier:0 distance:1];
+    [[mocks[3] expect] listAdapter:adapter sectionController:controllers[3] willEnterWorkingRangeTier:1 distance:2];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:1] forListAdapter:adapter];
+    [adapter.workingRangeHandler didEndDisplayingItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0] forListAdapter:adapter];
+    [self _verifyMockWorkingRangeDelegates];
+
+    // Act 3: Remove the tiers, so their section controllers exit them.
+    [[mocks[0] expect] listAdapter:adapter sectionController:controllers[0] didExitWorkingRangeTier:0 distance:1];
+    [[mocks[3] expect] listAdapter:adapter sectionController:controllers[3] didExitWorkingRangeTier:1 distance:2];
+    adapter.workingRangeTierSizes = @[];
+    [self _verifyMockWorkingRangeDelegates];
+}
+
+- (void)test_whenRemovingSectionInWorkingRange_withReuseEnabled_thatItExitsRangeBeforeBeingDequeued {
+    [self _setUpAdapterWithObjects:@[@"obj1", @"obj2", @"obj3", @"obj4"] workingRangeSize:1 niceMocks:NO];
+    IGListAdapter *adapter = self.adapter;
+    NSArray<IGListTestSection *> *controllers = self.sectionControllers;
+    NSArray *mocks = self.mockWorkingRangeDelegates;
+    adapter.maxReusableSectionControllersPerClass = 1;
+
+    // Arrange: Display the first section, so it and the next one enter the working range.
+    [[mocks[0] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[0]];
+    [[mocks[1] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[1]];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0] forListAdapter:adapter];
+    [self _verifyMockWorkingRangeDelegates];
+
+    // Act: Remove the second section, so the section after it takes its place in the range.
+    [[mocks[1] expect] listAdapter:adapter sectionControllerDidExitWorkingRange:controllers[1]];
+    [[mocks[2] expect] listAdapter:adapter sectionControllerWillEnterWorkingRange:controllers[2]];
+    [self.dataSource removeObjectAtIndex:1];
+    [adapter performUpdatesAnimated:NO completion:nil];
+    [self _verifyMockWorkingRangeDelegates];
+
+    // Assert: The removed section controller already exited the range when it is dequeued.
+    XCTAssertEqual([adapter dequeueReusableSectionControllerOfClass:[IGListTestSection class]], controllers[1]);
+}
+
+- (void)test_whenScrollingThroughItems_withItemWorkingRangeSizeTwo_thatOnlyItemsNearVisibleItemsAreInRange {
+    // Arrange 1: Set up a simple collection view and adapter with a single section of twenty items.
+    IGListTestSection *controller = [[IGListTestSection alloc] init];
+    controller.items = 20;
+    controller.itemWorkingRangeSize = 2;
+    NSString *object = @"obj";
+    _IGTestWorkingRangeAdapterDataSource *ds = [[_IGTestWorkingRangeAdapterDataSource alloc] initWithObjects:@[object]
+                                                                                       objectToControllerMap:@{object: controller}];
+    IGListReloadDataUpdater *updater = [[IGListReloadDataUpdater alloc] init];
+    IGListAdapter *adapter = [[IGListAdapter alloc] initWithUpdater:updater viewController:nil];
+    id collectionView = [OCMockObject niceMockForClass:[UICollectionView class]];
+    adapter.collectionView = collectionView;
+    id mockWorkingRangeDelegate = [OCMockObject niceMockForProtocol:@protocol(IGListWorkingRangeDelegate)];
+
+    adapter.dataSource = ds;
+    controller.workingRangeDelegate = mockWorkingRangeDelegate;
+
+    // Arrange 2: Force an update so we get the objects we configured through the system.
+    [adapter performUpdatesAnimated:NO completion:nil];
+
+    // Act 1: Display the first two items, so the items up to two past them enter the range.
+    [[mockWorkingRangeDelegate expect] listAdapter:adapter sectionController:controller itemsWillEnterWorkingRange:NSMakeRange(0, 3)];
+    [[mockWorkingRangeDelegate expect] listAdapter:adapter sectionController:controller itemsWillEnterWorkingRange:NSMakeRange(3, 1)];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0] forListAdapter:adapter];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:1 inSection:0] forListAdapter:adapter];
+    [mockWorkingRangeDelegate verify];
+
+    // Act 2: Scroll by three items, so the items joining the range enter and the first item exits.
+    for (NSUInteger item = 4; item < 7; item++) {
+        [[mockWorkingRangeDelegate expect] listAdapter:adapter sectionController:controller itemsWillEnterWorkingRange:NSMakeRange(item, 1)];
+    }
+    [[mockWorkingRangeDelegate expect] listAdapter:adapter sectionController:controller itemsDidExitWorkingRange:NSMakeRange(0, 1)];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:2 inSection:0] forListAdapter:adapter];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:3 inSection:0] forListAdapter:adapter];
+    [adapter.workingRangeHandler willDisplayItemAtIndexPath:[NSIndexPath indexPathForItem:4 inSection:0] forListAdapter:adapter];
+    [adapter.workingRangeHandler didEndDisplayingItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0] forListAdapter:adapter];
+    [adapter.workingRangeHandler didEndDisplayingItemAtIndexPath:[NSIndexPath indexPathForItem:1 inSection:0] forListAdapter:adapter];
+    [adapter.workingRangeHandler didEndDisplayingItemAtIndexPath:[NSIndexPath indexPathForItem:2 inSection:0] forListAdapter:adapter];
+    [mockWorkingRangeDelegate verify];
+
+    // Act 3: Hide the last visible items, so every item of the range exits.
+    [[mockWorkingRangeDelegate expect] listAdapter:adapter sectionController:controller itemsDidExitWorkingRange:NSMakeRange(1, 1)];
+    [[mockWorkingRangeDelegate expect] listAdapter:adapter sectionController:controller itemsDidExitWorkingRange:NSMakeRange(2, 5)];
+    [adapter.workingRangeHandler didEndDisplayingItemAtIndexPath:[NSIndexPath indexPathForItem:3 inSection:0] forListAdapter:adapter];
+    [adapter.workingRangeHandler didEndDisplayingItemAtIndexPath:[NSIndexPath indexPathForItem:4 inSection:0] forListAdapter:adapter];
+    [mockWorkingRangeDelegate verify];
+}
+
 - (void)DISABLED_test_whenDisplayingItemsAtPaths_withWorkingRangeSizeZero_thenRemovingFirstItem_thenInsertingItemAtLastPosition_thatItemEntersWorkingRange {
     // Arrange 1: Set up a simple collection view and adapter with a single element.
     IGListTestSection *controller1 = [[IGListTestSection alloc] init];
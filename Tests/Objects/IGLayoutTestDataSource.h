@@ -13,6 +13,8 @@
 
 @property (nonatomic, copy) NSArray<IGLayoutTestSection *> *sections;
 
+@property (nonatomic, assign) NSInteger sizeForItemCallCount;
+
 // call before using as the data source so cells and headers are configured
 - (void)configCollectionView:(UICollectionView *)collectionView;
 
@@ -55,6 +55,7 @@ static NSString * const kFooterIdentifier = @"footer";
 }
 
 - (CGSize)collectionView:(UICollectionView *)collectionView layout:(UICollectionViewLayout *)collectionViewLayout sizeForItemAtIndexPath:(NSIndexPath *)indexPath {
+    self.sizeForItemCallCount++;
     return self.sections[indexPath.section].items[indexPath.item].size;
 }
 
@@ -74,4 +75,10 @@ static NSString * const kFooterIdentifier = @"footer";
     return CGSizeMake(self.sections[section].footerHeight, self.sections[section].footerHeight); // Only the dimension along scrolling direction is used
 }
 
+#pragma mark - IGListCollectionViewDelegateLayout
+
+- (NSInteger)collectionView:(UICollectionView *)collectionView layout:(UICollectionViewLayout *)collectionViewLayout numberOfColumnsInSection:(NSInteger)section {
+    return self.sections[section].numberOfColumns;
+}
+
 @end
@@ -19,6 +19,7 @@
 @property (nonatomic, assign, readonly) CGFloat headerHeight;
 @property (nonatomic, assign, readonly) CGFloat footerHeight;
 @property (nonatomic, strong, readonly) NSArray<IGLayoutTestItem *> *items;
+@property (nonatomic, assign) NSInteger numberOfColumns;
 
 - (instancetype)initWithItems:(NSArray<IGLayoutTestItem *> *)items;
 
@@ -18,4 +18,7 @@
 
 @property (nonatomic, strong) UIView *backgroundView;
 
+// when YES, numbers are backed by IGListTestBatchSizingSection instead of IGListTestSection
+@property (nonatomic, assign) BOOL batchSizingSections;
+
 @end
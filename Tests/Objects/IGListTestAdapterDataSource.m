@@ -9,6 +9,7 @@
 
 #import <IGListKit/IGListAdapter.h>
 
+#import "IGListTestBatchSizingSection.h"
 #import "IGListTestContainerSizeSection.h"
 #import "IGListTestSection.h"
 
@@ -23,7 +24,7 @@
         if ([(NSNumber*)object  isEqual: @42]) {
             return [IGListTestContainerSizeSection new];
         }
-        return [IGListTestSection new];
+        return self.batchSizingSections ? [IGListTestBatchSizingSection new] : [IGListTestSection new];
     }
     return nil;
 }
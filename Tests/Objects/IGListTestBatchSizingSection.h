@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <IGListKit/IGListKit.h>
+
+#import "IGListTestSection.h"
+
+@interface IGListTestBatchSizingSection : IGListTestSection <IGListBatchSizing>
+
+@property (nonatomic, assign, readonly) NSInteger batchSizeCallCount;
+@property (nonatomic, assign, readonly) NSInteger itemSizeCallCount;
+
+@end
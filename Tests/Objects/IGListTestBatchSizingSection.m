@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "IGListTestBatchSizingSection.h"
+
+@implementation IGListTestBatchSizingSection
+
+- (CGSize)sizeForItemAtIndex:(NSInteger)index {
+    _itemSizeCallCount++;
+    return [super sizeForItemAtIndex:index];
+}
+
+#pragma mark - IGListBatchSizing
+
+- (void)getSizes:(CGSize *)sizes forItemsInRange:(NSRange)range {
+    _batchSizeCallCount++;
+    for (NSUInteger i = 0; i < range.length; i++) {
+        sizes[i] = self.size;
+    }
+}
+
+@end
@@ -0,0 +1,34 @@
+#!/bin/bash
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+# Builds and runs the tests of the plain C++ parts of IGListKit. These do not depend on UIKit or Foundation, so they
+# also run on Linux.
+#
+#   bash scripts/run_cpp_tests.sh              # run the tests
+#   bash scripts/run_cpp_tests.sh --benchmark  # run the tests, then every benchmark
+
+set -e
+
+cd "$(dirname "$(dirname "$0")")" || exit 1
+
+CXX="${CXX:-c++}"
+CXXFLAGS="-std=c++11 -O2 -pthread -Wall -Wextra -Werror -ISource/IGListKit/Internal -ITests/Cpp"
+BUILD_DIR="${BUILD_DIR:-$(mktemp -d)}"
+
+# shellcheck disable=SC2086
+"$CXX" $CXXFLAGS -o "$BUILD_DIR/IGListCppTests" Tests/Cpp/main.cpp Tests/Cpp/*Tests.cpp
+"$BUILD_DIR/IGListCppTests"
+
+if [ "$1" == "--benchmark" ]; then
+    for benchmark in Tests/Cpp/*Benchmark.cpp; do
+        name=$(basename "$benchmark" .cpp)
+        echo ""
+        echo "$name"
+        # shellcheck disable=SC2086
+        "$CXX" $CXXFLAGS -o "$BUILD_DIR/$name" "$benchmark"
+        "$BUILD_DIR/$name"
+    done
+fi
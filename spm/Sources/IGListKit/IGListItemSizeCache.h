@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListItemSizeCache.h
\ No newline at end of file
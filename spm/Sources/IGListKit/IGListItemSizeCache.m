@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListItemSizeCache.m
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListLayoutFrameStorage.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListLayoutSpanIndex.h
\ No newline at end of file
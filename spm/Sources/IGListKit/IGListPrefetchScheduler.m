@@ -0,0 +1 @@
+../../../Source/IGListKit/IGListPrefetchScheduler.m
\ No newline at end of file
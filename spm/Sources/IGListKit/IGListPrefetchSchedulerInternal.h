@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListPrefetchSchedulerInternal.h
\ No newline at end of file
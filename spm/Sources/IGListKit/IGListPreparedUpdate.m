@@ -0,0 +1 @@
+../../../Source/IGListKit/IGListPreparedUpdate.m
\ No newline at end of file
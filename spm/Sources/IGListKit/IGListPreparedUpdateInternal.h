@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListPreparedUpdateInternal.h
\ No newline at end of file
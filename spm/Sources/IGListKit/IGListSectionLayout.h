@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListSectionLayout.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListSectionLookupTable.h
\ No newline at end of file
@@ -1 +0,0 @@
-../../../Source/IGListKit/Internal/IGListSectionMap.m
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListSectionMap.mm
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListSizeSnapshot.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListSizeSnapshotStore.h
\ No newline at end of file
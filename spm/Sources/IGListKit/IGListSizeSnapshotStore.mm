@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListSizeSnapshotStore.mm
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Source/IGListKit/Internal/IGListTransitionDataInternal.h
\ No newline at end of file
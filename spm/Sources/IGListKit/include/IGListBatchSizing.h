@@ -0,0 +1 @@
+../../../../Source/IGListKit/IGListBatchSizing.h
\ No newline at end of file
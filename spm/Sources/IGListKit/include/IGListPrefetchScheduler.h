@@ -0,0 +1 @@
+../../../../Source/IGListKit/IGListPrefetchScheduler.h
\ No newline at end of file
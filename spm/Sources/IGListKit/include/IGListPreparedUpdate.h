@@ -0,0 +1 @@
+../../../../Source/IGListKit/IGListPreparedUpdate.h
\ No newline at end of file
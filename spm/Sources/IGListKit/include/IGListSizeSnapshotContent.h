@@ -0,0 +1 @@
+../../../../Source/IGListKit/IGListSizeSnapshotContent.h
\ No newline at end of file